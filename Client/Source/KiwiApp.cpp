@@ -98,7 +98,7 @@ namespace kiwi
    
         model::DataModel::init();
         
-        declareEngineObjects();
+        engine::declareObjects();
         
         declareObjectViews();
         
@@ -143,67 +143,6 @@ namespace kiwi
         }
     }
     
-    void KiwiApp::declareEngineObjects()
-    {
-        engine::NewBox::declare();
-        engine::ErrorBox::declare();
-        engine::Slider::declare();
-        engine::Print::declare();
-        engine::Receive::declare();
-        engine::Plus::declare();
-        engine::Times::declare();
-        engine::Delay::declare();
-        engine::Metro::declare();
-        engine::Pipe::declare();
-        engine::Bang::declare();
-        engine::Toggle::declare();
-        engine::AdcTilde::declare();
-        engine::DacTilde::declare();
-        engine::OscTilde::declare();
-        engine::Loadmess::declare();
-        engine::SigTilde::declare();
-        engine::TimesTilde::declare();
-        engine::PlusTilde::declare();
-        engine::MeterTilde::declare();
-        engine::DelaySimpleTilde::declare();
-        engine::Message::declare();
-        engine::NoiseTilde::declare();
-        engine::PhasorTilde::declare();
-        engine::SahTilde::declare();
-        engine::SnapshotTilde::declare();
-        engine::Trigger::declare();
-        engine::LineTilde::declare();
-        engine::Minus::declare();
-        engine::Divide::declare();
-        engine::Equal::declare();
-        engine::Less::declare();
-        engine::Greater::declare();
-        engine::Different::declare();
-        engine::Pow::declare();
-        engine::Modulo::declare();
-        engine::MinusTilde::declare();
-        engine::DivideTilde::declare();
-        engine::LessTilde::declare();
-        engine::GreaterTilde::declare();
-        engine::EqualTilde::declare();
-        engine::DifferentTilde::declare();
-        engine::LessEqual::declare();
-        engine::LessEqualTilde::declare();
-        engine::GreaterEqual::declare();
-        engine::GreaterEqualTilde::declare();
-        engine::Comment::declare();
-        engine::Pack::declare();
-        engine::Unpack::declare();
-        engine::Random::declare();
-        engine::Scale::declare();
-        engine::Select::declare();
-        engine::Number::declare();
-        engine::NumberTilde::declare();
-        engine::Hub::declare();
-        engine::Mtof::declare();
-        engine::Send::declare();
-    }
-    
     void KiwiApp::declareObjectViews()
     {
         SliderView::declare();
@@ -583,6 +522,7 @@ namespace kiwi
     {
         menu.addCommandItem(m_command_manager.get(), CommandIDs::startDsp);
         menu.addCommandItem(m_command_manager.get(), CommandIDs::stopDsp);
+        menu.addCommandItem(m_command_manager.get(), CommandIDs::switchDspProfiling);
         
         menu.addSeparator();
         menu.addCommandItem(m_command_manager.get(), CommandIDs::showAudioStatusWindow);
@@ -234,9 +234,6 @@ namespace kiwi
         //! @internal Utility to quit the app asynchronously.
         class AsyncQuitRetrier;
         
-        //! @internal Initializes engine's factory declaring engine objects
-        void declareEngineObjects();
-        
         //! @internal Initializes gui specific objects.
         void declareObjectViews();
         
@@ -25,6 +25,7 @@
 
 #include "KiwiApp_Instance.h"
 #include "KiwiApp_AboutWindow.h"
+#include "../KiwiApp_Audio/KiwiApp_AudioSettingsPanel.h"
 
 #include "../KiwiApp.h"
 #include "../KiwiApp_Components/KiwiApp_Window.h"
@@ -462,15 +463,10 @@ namespace kiwi
         showWindowWithId(WindowId::AudioSettings, [&instance = m_instance](){
             
             auto& manager = dynamic_cast<DspDeviceManager&>(instance.getAudioControler());
-            auto device_selector =
-            std::make_unique<juce::AudioDeviceSelectorComponent>(manager,
-                                                                 1, 20, 1, 20,
-                                                                 false, false, false, false);
-            
-            device_selector->setSize(300, 300);
+            auto settings_panel = std::make_unique<AudioSettingsPanel>(manager);
             
             return std::make_unique<Window>("Audio Settings",
-                                            std::move(device_selector),
+                                            std::move(settings_panel),
                                             true, false, "audio_settings_window");
         });
     }
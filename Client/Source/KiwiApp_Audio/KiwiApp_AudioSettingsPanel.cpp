@@ -0,0 +1,123 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <KiwiApp_Audio/KiwiApp_AudioSettingsPanel.h>
+#include <KiwiApp_Audio/KiwiApp_DspDeviceManager.h>
+
+#include <KiwiDsp/KiwiDsp_Def.h>
+
+#include <cmath>
+
+namespace kiwi
+{
+    // ================================================================================ //
+    //                               AUDIO SETTINGS PANEL                               //
+    // ================================================================================ //
+    
+    AudioSettingsPanel::AudioSettingsPanel(DspDeviceManager& manager):
+    m_manager(manager),
+    m_device_selector(manager, 1, 20, 1, 20, false, false, false, false),
+    m_pannel("Dsp settings"),
+    m_block_size(static_cast<int>(manager.getBlockSize())),
+    m_flush_denormals(manager.isFlushingDenormals()),
+    m_oscillator_quality()
+    {
+        juce::StringArray block_sizes {"Buffer size"};
+        juce::Array<juce::var> block_size_values {0};
+        
+        for(int block_size = 16; block_size <= 2048; block_size *= 2)
+        {
+            block_sizes.add(juce::String(block_size));
+            block_size_values.add(block_size);
+        }
+        
+        // the quality of a table is the error of the linear interpolation of the cosine in decibels.
+        // a table is chosen as the smallest one that reaches the quality, every item selects one table.
+        juce::StringArray qualities;
+        juce::Array<juce::var> quality_values;
+        
+        for(int resolution = 6; resolution <= 16; ++resolution)
+        {
+            const double step = 2. * static_cast<double>(dsp::pi) / static_cast<double>(1 << resolution);
+            const double quality = std::floor(-20. * std::log10(step * step / 8.));
+            
+            qualities.add(juce::String(1 << resolution) + " points (" + juce::String(quality) + " dB)");
+            quality_values.add(quality);
+            
+            if(m_oscillator_quality.getValue().isVoid() && quality >= manager.getOscillatorQuality())
+            {
+                m_oscillator_quality = quality;
+            }
+        }
+        
+        juce::Array<juce::PropertyComponent*> props {
+            
+            new juce::ChoicePropertyComponent(m_block_size, "Block size", block_sizes, block_size_values),
+            new juce::BooleanPropertyComponent(m_flush_denormals, "Denormals", "Flush to zero"),
+            new juce::ChoicePropertyComponent(m_oscillator_quality, "Oscillator table", qualities, quality_values)
+        };
+        
+        m_pannel.addSection("Dsp", props, true, 0);
+        
+        m_block_size.addListener(this);
+        m_flush_denormals.addListener(this);
+        m_oscillator_quality.addListener(this);
+        
+        m_device_selector.setSize(300, 300);
+        
+        setSize(300, m_device_selector.getHeight() + m_pannel.getTotalContentHeight());
+        
+        addAndMakeVisible(m_device_selector);
+        addAndMakeVisible(m_pannel);
+    }
+    
+    AudioSettingsPanel::~AudioSettingsPanel()
+    {
+        m_block_size.removeListener(this);
+        m_flush_denormals.removeListener(this);
+        m_oscillator_quality.removeListener(this);
+        m_pannel.clear();
+    }
+    
+    void AudioSettingsPanel::resized()
+    {
+        juce::Rectangle<int> bounds = getLocalBounds();
+        
+        m_pannel.setBounds(bounds.removeFromBottom(m_pannel.getTotalContentHeight()));
+        m_device_selector.setBounds(bounds);
+    }
+    
+    void AudioSettingsPanel::valueChanged(juce::Value& value)
+    {
+        if(value.refersToSameSourceAs(m_block_size))
+        {
+            m_manager.setBlockSize(static_cast<size_t>(static_cast<int>(m_block_size.getValue())));
+        }
+        else if(value.refersToSameSourceAs(m_flush_denormals))
+        {
+            m_manager.setFlushDenormals(m_flush_denormals.getValue());
+        }
+        else if(value.refersToSameSourceAs(m_oscillator_quality))
+        {
+            m_manager.setOscillatorQuality(m_oscillator_quality.getValue());
+        }
+    }
+}
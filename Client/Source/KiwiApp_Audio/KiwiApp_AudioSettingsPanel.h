@@ -0,0 +1,63 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <juce_audio_utils/juce_audio_utils.h>
+
+namespace kiwi
+{
+    class DspDeviceManager;
+    
+    // ================================================================================ //
+    //                               AUDIO SETTINGS PANEL                               //
+    // ================================================================================ //
+    
+    //! @brief A Panel Component that shows the audio device and the dsp settings.
+    class AudioSettingsPanel : public juce::Component,
+                               public juce::Value::Listener
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        AudioSettingsPanel(DspDeviceManager& manager);
+        
+        //! @brief Destructor.
+        ~AudioSettingsPanel();
+        
+    private: // methods
+        
+        //! @brief Resized methods called when resized.
+        void resized() override final;
+        
+        //! @brief Called when a dsp setting is changed.
+        void valueChanged(juce::Value& value) override final;
+        
+    private: // members
+        
+        DspDeviceManager&                   m_manager;
+        juce::AudioDeviceSelectorComponent  m_device_selector;
+        juce::PropertyPanel                 m_pannel;
+        juce::Value                         m_block_size;
+        juce::Value                         m_flush_denormals;
+        juce::Value                         m_oscillator_quality;
+    };
+}
@@ -36,10 +36,23 @@ namespace kiwi
     DspDeviceManager::DspDeviceManager() :
     m_input_matrix(nullptr),
     m_output_matrix(nullptr),
+    m_input_fifo(nullptr),
+    m_output_fifo(nullptr),
+    m_input_fifo_size(0ul),
+    m_output_fifo_size(0ul),
+    m_block_size(std::max(getGlobalProperties().getIntValue("DSP Block Size", 64), 0)),
+    m_output_accumulators(),
     m_chains(),
+    m_next_chain(0ul),
+    m_accumulated(false),
+    m_thread_pool(std::make_shared<dsp::ThreadPool>(std::max(std::thread::hardware_concurrency(), 1u))),
     m_is_playing(false),
     m_mutex()
     {
+        dsp::Denormals::setFlushing(getGlobalProperties().getBoolValue("DSP Flush Denormals", true));
+        dsp::Wavetable::setQuality(getGlobalProperties().getDoubleValue("DSP Oscillator Quality",
+                                                                         dsp::Wavetable::getQuality()));
+        
         juce::ScopedPointer<juce::XmlElement> previous_settings(getGlobalProperties().getXmlValue("Audio Settings"));
         
         if (previous_settings)
@@ -64,10 +77,13 @@ namespace kiwi
     {
         if(std::find(m_chains.begin(), m_chains.end(), &chain) == m_chains.cend())
         {
+            // the chains tick their independent nodes on the pool that ticks the chains.
+            chain.setThreadPool(m_thread_pool);
+            
             if (m_is_playing)
             {
                 juce::AudioIODevice * const device = getCurrentAudioDevice();
-                chain.prepare(device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+                chain.prepare(device->getCurrentSampleRate(), getBlockSize(*device));
             }
             
             {
@@ -111,11 +127,88 @@ namespace kiwi
         return m_is_playing;
     };
     
+    void DspDeviceManager::setBlockSize(size_t block_size)
+    {
+        if(block_size != m_block_size)
+        {
+            const bool is_playing = m_is_playing;
+            
+            if(is_playing)
+            {
+                stopAudio();
+            }
+            
+            m_block_size = block_size;
+            getGlobalProperties().setValue("DSP Block Size", static_cast<int>(block_size));
+            
+            if(is_playing)
+            {
+                startAudio();
+            }
+        }
+    }
+    
+    size_t DspDeviceManager::getBlockSize() const
+    {
+        return m_block_size;
+    }
+    
+    void DspDeviceManager::setFlushDenormals(bool flush)
+    {
+        dsp::Denormals::setFlushing(flush);
+        getGlobalProperties().setValue("DSP Flush Denormals", flush);
+    }
+    
+    bool DspDeviceManager::isFlushingDenormals() const
+    {
+        return dsp::Denormals::isFlushing();
+    }
+    
+    void DspDeviceManager::setOscillatorQuality(double quality)
+    {
+        if(quality != dsp::Wavetable::getQuality())
+        {
+            const bool is_playing = m_is_playing;
+            
+            if(is_playing)
+            {
+                stopAudio();
+            }
+            
+            dsp::Wavetable::setQuality(quality);
+            getGlobalProperties().setValue("DSP Oscillator Quality", quality);
+            
+            if(is_playing)
+            {
+                startAudio();
+            }
+        }
+    }
+    
+    double DspDeviceManager::getOscillatorQuality() const
+    {
+        return dsp::Wavetable::getQuality();
+    }
+    
+    size_t DspDeviceManager::getBlockSize(juce::AudioIODevice const& device) const
+    {
+        return m_block_size != 0 ? m_block_size : device.getCurrentBufferSizeSamples();
+    }
+    
     void DspDeviceManager::addToChannel(size_t const channel, dsp::Signal const& output_signal)
     {
-        if (channel < m_output_matrix->getNumberOfChannels() && output_signal.size() == m_output_matrix->getVectorSize())
+        const size_t thread = dsp::ThreadPool::getCurrentThread();
+        
+        if(thread != 0)
+        {
+            m_accumulated.store(true, std::memory_order_relaxed);
+        }
+        
+        dsp::Buffer& output_matrix = thread == 0 ? *m_output_matrix : *m_output_accumulators[thread - 1];
+        
+        if (channel < output_matrix.getNumberOfChannels() && output_signal.size() == output_matrix.getVectorSize())
         {
-            (*m_output_matrix)[channel].add(output_signal);
+            output_matrix[channel].add(output_signal);
         }
     }
     
@@ -127,12 +220,54 @@ namespace kiwi
         }
     }
     
+    size_t DspDeviceManager::getNumberOfOutputChannels() const
+    {
+        return m_output_matrix ? m_output_matrix->getNumberOfChannels() : 0ul;
+    }
+    
     
-    void DspDeviceManager::tick() const noexcept
+    void DspDeviceManager::tick() noexcept
     {
-        for(dsp::Chain* chain : m_chains)
+        m_next_chain.store(0ul, std::memory_order_relaxed);
+        
+        if(m_chains.size() < 2)
         {
-            chain->tick();
+            // a single chain ticks its nodes on the pool by itself.
+            perform(0);
+        }
+        else
+        {
+            m_thread_pool->perform(*this);
+        }
+        
+        // the pool returns once the workers are done so their accumulators can be read.
+        
+        if(!m_accumulated.exchange(false, std::memory_order_relaxed))
+        {
+            return;
+        }
+        
+        const size_t nchannels = m_output_matrix->getNumberOfChannels();
+        
+        for(auto& accumulator : m_output_accumulators)
+        {
+            for(size_t i = 0; i < nchannels; ++i)
+            {
+                dsp::Signal& channel = (*accumulator)[i];
+                (*m_output_matrix)[i].add(channel);
+                channel.fill(0);
+            }
+        }
+    }
+    
+    void DspDeviceManager::perform(size_t thread) noexcept
+    {
+        const size_t nchains = m_chains.size();
+        
+        for(size_t index = m_next_chain.fetch_add(1ul, std::memory_order_relaxed); index < nchains;
+            index = m_next_chain.fetch_add(1ul, std::memory_order_relaxed))
+        {
+            m_chains[index]->tick();
         }
     }
     
@@ -141,12 +276,13 @@ namespace kiwi
         
         size_t sample_rate = device->getCurrentSampleRate();
         size_t buffer_size = device->getCurrentBufferSizeSamples();
+        size_t block_size = getBlockSize(*device);
         
         for(dsp::Chain * chain : m_chains)
         {
             try
             {
-                chain->prepare(sample_rate, buffer_size);
+                chain->prepare(sample_rate, block_size);
             }
             catch(dsp::LoopError & e)
             {
@@ -154,13 +290,32 @@ namespace kiwi
             }
         }
         
+        const size_t ninputs = device->getActiveInputChannels().getHighestBit() + 1;
+        const size_t noutputs = device->getActiveOutputChannels().getHighestBit() + 1;
+        
         // allocate input matrix
-        m_input_matrix.reset(new dsp::Buffer(device->getActiveInputChannels().getHighestBit() + 1,
-                                             device->getCurrentBufferSizeSamples()));
+        m_input_matrix.reset(new dsp::Buffer(ninputs, block_size));
         
         // allocate output matrix
-        m_output_matrix.reset(new dsp::Buffer(device->getActiveOutputChannels().getHighestBit() + 1,
-                                              device->getCurrentBufferSizeSamples()));
+        m_output_matrix.reset(new dsp::Buffer(noutputs, block_size));
+        
+        // allocate the fifos, if the buffer size isn't a multiple of the block size
+        // the output is delayed by a block so that a buffer can always be filled.
+        const size_t latency = (buffer_size % block_size) != 0 ? block_size : 0ul;
+        
+        m_input_fifo.reset(new dsp::Buffer(ninputs, buffer_size + block_size));
+        m_output_fifo.reset(new dsp::Buffer(noutputs, buffer_size + block_size + latency));
+        m_input_fifo_size = 0ul;
+        m_output_fifo_size = latency;
+        
+        // allocate the workers' output accumulators
+        m_output_accumulators.clear();
+        
+        for(size_t i = 1; i < m_thread_pool->getNumberOfThreads(); ++i)
+        {
+            m_output_accumulators.emplace_back(new dsp::Buffer(m_output_matrix->getNumberOfChannels(),
+                                                               m_output_matrix->getVectorSize()));
+        }
     }
     
     void DspDeviceManager::audioDeviceStopped()
@@ -175,41 +330,93 @@ namespace kiwi
         
         // clear output matrix
         m_output_matrix.reset();
+        
+        // clear the fifos
+        m_input_fifo.reset();
+        m_output_fifo.reset();
+        m_input_fifo_size = 0ul;
+        m_output_fifo_size = 0ul;
+        
+        // clear the workers' output accumulators
+        m_output_accumulators.clear();
     }
     
     void DspDeviceManager::audioDeviceIOCallback(float const** inputs, int numins,
                                                  float** outputs, int numouts,
                                                  int vector_size)
     {
-        //@todo may be pointing to same samples instead of copying them
+        dsp::RealTime::Scope scope;
+        dsp::Denormals::Scope denormals;
+        
+        const size_t ninputs = std::min(static_cast<size_t>(numins), m_input_fifo->getNumberOfChannels());
+        const size_t noutputs = m_output_fifo->getNumberOfChannels();
+        const size_t block_size = m_input_matrix->getVectorSize();
+        const size_t nsamples = std::min(static_cast<size_t>(vector_size),
+                                         m_input_fifo->getVectorSize() - m_input_fifo_size);
+        
+        // push the inputs in the input fifo
         
-        for(int i = 0; i < numins; ++i)
+        for(size_t i = 0; i < ninputs; ++i)
         {
-            dsp::Signal& channel = (*m_input_matrix)[i];
-            float const* const input_channel = inputs[i];
+            std::copy(inputs[i], inputs[i] + nsamples, (*m_input_fifo)[i].data() + m_input_fifo_size);
+        }
+        
+        m_input_fifo_size += nsamples;
+        
+        // tick the chains for every complete block
+        
+        size_t read = 0ul;
+        
+        const size_t output_fifo_capacity = m_output_fifo->getVectorSize();
+        
+        for(; m_input_fifo_size - read >= block_size
+            && m_output_fifo_size + block_size <= output_fifo_capacity; read += block_size)
+        {
+            for(size_t i = 0; i < ninputs; ++i)
+            {
+                dsp::sample_t const* input_fifo = (*m_input_fifo)[i].data() + read;
+                std::copy(input_fifo, input_fifo + block_size, (*m_input_matrix)[i].data());
+            }
             
-            for(int j = 0; j < vector_size; ++j)
+            tick();
+            
+            for(size_t i = 0; i < noutputs; ++i)
             {
-                channel[j] = input_channel[j];
+                dsp::Signal& channel = (*m_output_matrix)[i];
+                std::copy(channel.data(), channel.data() + block_size, (*m_output_fifo)[i].data() + m_output_fifo_size);
+                channel.fill(0);
             }
+            
+            m_output_fifo_size += block_size;
+        }
+        
+        for(size_t i = 0; i < ninputs; ++i)
+        {
+            dsp::sample_t* input_fifo = (*m_input_fifo)[i].data();
+            std::copy(input_fifo + read, input_fifo + m_input_fifo_size, input_fifo);
         }
         
-        tick();
+        m_input_fifo_size -= read;
+        
+        // pull the outputs from the output fifo
+        
+        const size_t written = std::min(static_cast<size_t>(vector_size), m_output_fifo_size);
         
         for(int i = 0; i < numouts; ++i)
         {
-            dsp::Signal const& channel = (*m_output_matrix)[i];
-            float* const output_channel = outputs[i];
-            
-            for(int j = 0; j < vector_size; ++j)
+            if(static_cast<size_t>(i) < noutputs)
+            {
+                dsp::sample_t* output_fifo = (*m_output_fifo)[i].data();
+                std::copy(output_fifo, output_fifo + written, outputs[i]);
+                std::fill(outputs[i] + written, outputs[i] + vector_size, 0.f);
+                std::copy(output_fifo + written, output_fifo + m_output_fifo_size, output_fifo);
+            }
+            else
             {
-                output_channel[j] = channel[j];
+                std::fill(outputs[i], outputs[i] + vector_size, 0.f);
             }
         }
         
-        for (int i = 0; i < numouts; ++i)
-        {
-            (*m_output_matrix)[i].fill(0);
-        }
+        m_output_fifo_size -= written;
     }
 }
@@ -23,6 +23,9 @@
 
 #include <KiwiDsp/KiwiDsp_Signal.h>
 #include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_ThreadPool.h>
+#include <KiwiDsp/KiwiDsp_Denormals.h>
+#include <KiwiDsp/KiwiDsp_Wavetable.h>
 #include <KiwiEngine/KiwiEngine_AudioControler.h>
 
 #include <juce_audio_devices/juce_audio_devices.h>
@@ -35,9 +38,15 @@ namespace kiwi
     //                               DSP DEVICE MANAGER                                 //
     // ================================================================================ //
  
+    //! @brief The audio device manager that ticks the chains of the patchers.
+    //! @details The chains are independent and are ticked concurrently by the audio thread
+    //! and a pool of workers. Each thread sums the outputs of the chains it ticks into its own
+    //! accumulator so that adding to a channel never locks. The chains are ticked with a fixed
+    //! block size, independent of the device buffer size, through an input and an output FIFO.
     class DspDeviceManager : public juce::AudioIODeviceCallback,
                              public juce::AudioDeviceManager,
-                             public engine::AudioControler
+                             public engine::AudioControler,
+                             private dsp::ThreadPool::Task
     {
     public: // methods
         
@@ -71,11 +80,43 @@ namespace kiwi
         bool isAudioOn() const override;
         
         //! @brief Adds a buffer to the output matrix of signal.
+        //! @details Called during the tick, the signal is added to the accumulator of the calling thread.
         void addToChannel(size_t const channel, dsp::Signal const& output_buffer) override;
         
         //! @brief Gets a buffer from the input matrix signal.
         void getFromChannel(size_t const channel, dsp::Signal & input_signal) override;
         
+        //! @brief Returns the number of output channels of the current device.
+        size_t getNumberOfOutputChannels() const override;
+        
+        //! @brief Sets the block size used to tick the chains.
+        //! @details The device callback ticks the chains several times per buffer. If the device buffer
+        //! size isn't a multiple of the block size, the signals are delayed by one block. A null block size
+        //! ticks the chains with the device buffer size. The block size is saved in the settings and
+        //! restarts the audio if it's on.
+        void setBlockSize(size_t block_size);
+        
+        //! @brief Gets the block size used to tick the chains.
+        size_t getBlockSize() const;
+        
+        //! @brief Enables or disables the flush of the subnormal samples to zero.
+        //! @details The audio thread and the workers that tick the chains then flush the subnormal samples
+        //! produced by the feedback paths and the decaying ramps. The mode is saved in the settings and
+        //! is enabled by default. It's effective from the next tick.
+        void setFlushDenormals(bool flush);
+        
+        //! @brief Returns true if the subnormal samples are flushed to zero.
+        bool isFlushingDenormals() const;
+        
+        //! @brief Sets the quality of the cosine tables of the oscillators in decibels.
+        //! @details A higher quality reads larger tables. The quality is saved in the settings and
+        //! restarts the audio if it's on so that the oscillators get their new table.
+        //! @see dsp::Wavetable
+        void setOscillatorQuality(double quality);
+        
+        //! @brief Gets the quality of the cosine tables of the oscillators in decibels.
+        double getOscillatorQuality() const;
+        
     private: // methods
         
         // ================================================================================ //
@@ -100,14 +141,30 @@ namespace kiwi
         // ================================================================================ //
         
         //! @brief Ticks all the chains.
-        //! @details Called at each dsp cycle.
-        void tick() const noexcept;
+        //! @details Called at each dsp cycle. Returns once all the chains are ticked and
+        //! the workers' accumulators are summed into the output matrix.
+        void tick() noexcept;
+        
+        //! @brief Ticks the chains that are not ticked yet by the other threads.
+        void perform(size_t thread) noexcept override final;
+        
+        //! @brief Gets the block size the chains are prepared with for a device.
+        size_t getBlockSize(juce::AudioIODevice const& device) const;
         
     private: // members
         
         std::unique_ptr<dsp::Buffer>                m_input_matrix;
         std::unique_ptr<dsp::Buffer>                m_output_matrix;
+        std::unique_ptr<dsp::Buffer>                m_input_fifo;
+        std::unique_ptr<dsp::Buffer>                m_output_fifo;
+        size_t                                      m_input_fifo_size;
+        size_t                                      m_output_fifo_size;
+        size_t                                      m_block_size;
+        std::vector<std::unique_ptr<dsp::Buffer>>   m_output_accumulators;
         std::vector<dsp::Chain*>                    m_chains;
+        std::atomic<size_t>                         m_next_chain;
+        std::atomic<bool>                           m_accumulated;
+        std::shared_ptr<dsp::ThreadPool>            m_thread_pool;
         bool                                        m_is_playing;
         mutable std::mutex                          m_mutex;
     };
@@ -83,6 +83,7 @@ namespace kiwi
         switchDsp                   = 0xf20420,        ///< Toggle DSP state
         startDsp                    = 0xf20421,        ///< Starts the dsp
         stopDsp                     = 0xf20422,        ///< Stops the dsp
+        switchDspProfiling          = 0xf20423,        ///< Toggle the DSP profiling of the patcher
         
         scrollToTop                 = 0xf30001,        ///< Scroll to the top
         scrollToBottom              = 0xf30002,        ///< Scroll to the bottom
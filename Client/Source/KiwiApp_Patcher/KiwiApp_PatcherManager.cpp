@@ -318,6 +318,30 @@ namespace kiwi
         }
     }
     
+    void PatcherManager::switchDspProfiling()
+    {
+        std::unique_lock<std::mutex> lock(m_instance.useEngineInstance().getScheduler().lock());
+        
+        engine::Patcher& patcher = getPatcher().entity().use<engine::Patcher>();
+        
+        if(patcher.isDspProfiling())
+        {
+            patcher.postDspProfiles();
+            patcher.setDspProfiling(false);
+        }
+        else
+        {
+            // collecting starts a new window, the report only covers the ticks from now on.
+            patcher.collectDspProfiles();
+            patcher.setDspProfiling(true);
+        }
+    }
+    
+    bool PatcherManager::isDspProfiling()
+    {
+        return getPatcher().entity().use<engine::Patcher>().isDspProfiling();
+    }
+    
     size_t PatcherManager::getNumberOfUsers()
     {
         return m_connected_users.size();
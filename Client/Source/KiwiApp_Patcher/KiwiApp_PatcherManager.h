@@ -115,6 +115,12 @@ namespace kiwi
         //! @brief create a new patcher view window.
         void newView();
         
+        //! @brief Starts profiling the audio objects, or stops and posts the report in the Console.
+        void switchDspProfiling();
+        
+        //! @brief Returns true if the audio objects of the patcher are profiled.
+        bool isDspProfiling();
+        
         //! @brief Brings the first patcher view to front.
         void bringsFirstViewToFront();
         
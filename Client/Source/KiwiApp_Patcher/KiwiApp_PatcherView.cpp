@@ -1837,6 +1837,8 @@ namespace kiwi
         
         commands.add(CommandIDs::showPatcherInspector);
         commands.add(CommandIDs::showObjectInspector);
+        
+        commands.add(CommandIDs::switchDspProfiling);
     }
     
     void PatcherView::getCommandInfo(const juce::CommandID commandID, juce::ApplicationCommandInfo& result)
@@ -2019,6 +2021,15 @@ namespace kiwi
                 result.setTicked(!m_view_model.getLock());
                 break;
             }
+            case CommandIDs::switchDspProfiling:
+            {
+                result.setInfo(TRANS("Profile DSP"),
+                               TRANS("Profile the audio objects, post the report in the console when stopped"),
+                               CommandCategories::general, 0);
+                
+                result.setTicked(m_manager.isDspProfiling());
+                break;
+            }
             default:
             {
                 result.setInfo (TRANS("[unknown command]"), TRANS("[unknown command]"), CommandCategories::view, 0);
@@ -2070,6 +2081,8 @@ namespace kiwi
             case CommandIDs::zoomNormal:                        { zoomNormal(); break; }
             case CommandIDs::editModeSwitch:                    { setLock(!isLocked()); break; }
                 
+            case CommandIDs::switchDspProfiling:                { m_manager.switchDspProfiling(); break; }
+                
             default: return false;
         }
         
@@ -19,6 +19,12 @@
  ==============================================================================
  */
 
+
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <typeinfo>
+
 #include "KiwiDsp_Chain.h"
 #include "KiwiDsp_Misc.h"
 
@@ -34,10 +40,22 @@ namespace kiwi
         m_processor(processor),
         m_inlets(),
         m_outlets(),
+        m_index(0),
+        m_prepared(false),
+        m_preparations(0ul),
+        m_perform(false),
+        m_dirty(false),
+        m_stale(false),
         m_inputs(),
-        m_outputs(),
-        m_buffer_copy(),
-        m_index(0)
+        m_scalars(),
+        m_channels(),
+        m_nplans(0),
+        m_step(nullptr),
+        m_fold(),
+        m_folded(false),
+        m_fused(false),
+        m_meter(),
+        m_denormals(new std::atomic<size_t>[processor->getNumberOfOutputs()]())
         {
             const size_t inlets = processor->getNumberOfInputs();
             const size_t outlets = processor->getNumberOfOutputs();
@@ -59,20 +77,10 @@ namespace kiwi
                     m_outlets.emplace_back(*this, i);
                 }
             }
-            
-            m_buffer_copy.resize(processor->getNumberOfInputs());
         }
         
         Chain::Node::~Node()
         {
-            try
-            {
-                m_processor->release();
-            }
-            catch(Error & e)
-            {
-                
-            }
         }
         
         bool Chain::Node::connectInput(const size_t input_index, Node& other_node, const size_t output_index)
@@ -89,570 +97,2377 @@ namespace kiwi
             return m_inlets[input_index].disconnect(other_node.m_outlets[output_index]);
         }
         
-        bool Chain::Node::prepare(Chain& chain)
+        std::vector<bool> Chain::Node::getInputStatus() const
         {
-            // ======================================================================== //
-            //                    INITIALIZE SAMPLE RATE, VECTOR SIZE                   //
-            // ======================================================================== //
-            
-            size_t samplerate = chain.getSampleRate();
-            size_t vectorsize = chain.getVectorSize();
-            
-            // ======================================================================== //
-            //                    PREPARES INLETS, INPUT BUFFER                         //
-            // ======================================================================== //
+            std::vector<bool> input_status(m_inlets.size(), false);
             
-            std::vector<Signal::sPtr> inputs;
-            
-            for(Pin& inlet : m_inlets)
+            for (size_t i = 0; i < m_inlets.size(); ++i)
             {
-                if (inlet.m_ties.size() == 0)
-                {
-                    inlet.m_signal = chain.getSignalIn();
-                }
-                else if(inlet.m_ties.size() == 1)
+                for(Tie const& tie : m_inlets[i].m_ties)
                 {
-                    inlet.m_signal = inlet.m_ties.begin()->m_pin.m_signal;
-                }
-                else
-                {
-                    inlet.m_signal = chain.getSignalInlet(inlet.m_index);
-                    
-                    std::vector<std::shared_ptr<Signal>> tie_signals;
-                    
-                    for(Tie tie : inlet.m_ties)
+                    if(tie.m_pin.m_owner.m_perform)
                     {
-                        tie_signals.push_back(tie.m_pin.m_signal);
+                        input_status[i] = true;
+                        break;
                     }
-                    
-                    m_buffer_copy[inlet.m_index].setChannels(tie_signals);
                 }
-                
-                inputs.push_back(inlet.m_signal);
             }
             
-            m_inputs.setChannels(inputs);
-            
-            // ======================================================================== //
-            //                    PREPARE OUTLETS, OUTPUT BUFFER                        //
-            // ======================================================================== //
-            
-            std::vector<Signal::sPtr> outputs;
+            return input_status;
+        }
+        
+        std::vector<bool> Chain::Node::getScalarStatus() const
+        {
+            std::vector<bool> scalar_status(m_inlets.size(), false);
             
-            for(Pin& outlet : m_outlets)
+            for (size_t i = 0; i < m_inlets.size(); ++i)
             {
-                if (outlet.m_ties.size() == 0)
-                {
-                    outlet.m_signal = chain.getSignalOutlet(outlet.m_index);
-                }
-                else
+                for(Tie const& tie : m_inlets[i].m_ties)
                 {
-                    outlet.m_signal = std::make_shared<Signal>(vectorsize);
+                    if(tie.m_pin.m_owner.m_perform)
+                    {
+                        scalar_status[i] = tie.m_pin.m_owner.m_processor->isScalarOutput(tie.m_pin.m_index);
+                        
+                        if(!scalar_status[i])
+                        {
+                            break;
+                        }
+                    }
                 }
-                
-                outputs.push_back(outlet.m_signal);
-            }
-            
-            m_outputs.setChannels(outputs);
-            
-            // ======================================================================== //
-            //                  INITIALIZE INFO FOR PREPARING PROCESSOR                 //
-            // ======================================================================== //
-            
-            std::vector<bool> input_status(m_inlets.size());
-            
-            for (size_t i = 0; i < m_inlets.size(); ++i)
-            {
-                input_status[i] = !m_inlets[i].m_ties.empty();
             }
             
-            Processor::PrepareInfo prepare_info {samplerate, vectorsize, input_status};
-            
-            // ======================================================================== //
-            //                           PREPARE PROCESSORS                             //
-            // ======================================================================== //
-            
-            m_processor->prepare(prepare_info);
-            
-            return m_processor->shouldPerform();
+            return scalar_status;
         }
         
-        void Chain::Node::perform() noexcept
+        std::vector<size_t> Chain::Node::getChannelStatus() const
         {
-            const size_t nchannels = m_buffer_copy.size();
+            std::vector<size_t> channel_status(m_inlets.size(), 1ul);
             
-            for(size_t i = 0; i < nchannels; ++i)
+            for (size_t i = 0; i < m_inlets.size(); ++i)
             {
-                Buffer const& buffer_copy = m_buffer_copy[i];
-                
-                if(!buffer_copy.empty())
+                for(Tie const& tie : m_inlets[i].m_ties)
                 {
-                    Signal& inputs = m_inputs[i];
-                    
-                    inputs.copy(buffer_copy[0]);
-                    
-                    const size_t ncopies = buffer_copy.getNumberOfChannels();
-                    
-                    for(size_t j = 1; j < ncopies; ++j)
+                    if(tie.m_pin.m_owner.m_perform)
                     {
-                        inputs.add(buffer_copy[j]);
+                        const size_t nchannels = tie.m_pin.m_owner.m_processor->getNumberOfOutputChannels(tie.m_pin.m_index);
+                        channel_status[i] = std::max(channel_status[i], nchannels);
                     }
                 }
             }
             
-            m_processor->perform(m_inputs, m_outputs);
+            return channel_status;
         }
         
-        void Chain::Node::release()
+        bool Chain::Node::prepare(Chain const& chain, std::vector<bool> const& inputs,
+                                  std::vector<bool> const& scalars, std::vector<size_t> const& channels)
         {
-            m_index = 0;
-            
-            // ======================================================================== //
-            //                    RELEASE INLET AND INPUT BUFFER                        //
-            // ======================================================================== //
-            
-            for (Pin& inlet : m_inlets)
+            if(m_prepared && inputs == m_inputs && scalars == m_scalars && channels == m_channels)
             {
-                inlet.m_signal.reset();
+                return false;
             }
             
-            m_inputs.clear();
-            
             // ======================================================================== //
-            //                    RELEASE INLET AND INPUT BUFFER                        //
+            //                  INITIALIZE INFO FOR PREPARING PROCESSOR                 //
             // ======================================================================== //
             
-            for (Pin& outlet : m_outlets)
-            {
-                outlet.m_signal.reset();
-            }
-            
-            m_outputs.clear();
+            Processor::PrepareInfo prepare_info {chain.getSampleRate(), chain.getVectorSize(), inputs, scalars, channels};
             
             // ======================================================================== //
-            //                         CLEAR BUFFER COPY                                //
+            //                           PREPARE PROCESSORS                             //
             // ======================================================================== //
             
-            std::for_each(m_buffer_copy.begin(), m_buffer_copy.end(), [](Buffer &buf){ buf.clear();});
+            release();
             
-            // ======================================================================== //
-            //                             RELEASE PROCESSOR                            //
-            // ======================================================================== /
+            m_processor->prepare(prepare_info);
             
-            m_processor->release();
-        }
-        
-        // ==================================================================================== //
-        //                                          NODE::PIN                                   //
-        // ==================================================================================== //
-        
-        Chain::Node::Pin::Pin(Node& owner, const size_t index) :
-        m_owner(owner),
-        m_index(index),
-        m_signal(),
-        m_ties()
-        {
-            ;
-        }
-        
-        Chain::Node::Pin::Pin(Pin && other):
-        m_owner(other.m_owner),
-        m_index(other.m_index),
-        m_signal(std::move(other.m_signal)),
-        m_ties(std::move(other.m_ties))
-        {
-        }
-        
-        Chain::Node::Pin::~Pin()
-        {
-            disconnect();
+            m_prepared = true;
+            ++m_preparations;
+            m_perform = m_processor->shouldPerform();
+            m_inputs = inputs;
+            m_scalars = scalars;
+            m_channels = channels;
+            
+            return true;
         }
         
-        bool Chain::Node::Pin::connect(Pin& other_pin)
+        bool Chain::Node::isMultichannel() const noexcept
         {
-            return m_ties.insert(Tie(other_pin)).second && other_pin.m_ties.insert(Tie(*this)).second;
+            auto wide = [](size_t nchannels)
+            {
+                return nchannels > 1;
+            };
+            
+            return (std::any_of(m_channels.begin(), m_channels.end(), wide)
+                    || std::any_of(m_processor->m_output_channels.begin(), m_processor->m_output_channels.end(), wide));
         }
         
-        bool Chain::Node::Pin::disconnect(Pin& other_pin)
+        bool Chain::Node::isBusy() const noexcept
         {
-            return m_ties.erase(Tie(other_pin)) && other_pin.m_ties.erase(Tie(*this));
+            return m_nplans != 0;
         }
         
-        void Chain::Node::Pin::disconnect()
+        void Chain::Node::release()
         {
-            for (std::set<Tie>::iterator tie = m_ties.begin(); tie != m_ties.end();)
+            if(m_prepared)
             {
-                tie->m_pin.m_ties.erase(Tie(*this));
-                tie = m_ties.erase(tie);
+                m_prepared = false;
+                m_processor->release();
             }
+            
+            m_perform = false;
+            m_inputs.clear();
+            m_scalars.clear();
+            m_channels.clear();
+            m_folded = false;
+            
+            // the plans keep their own callbacks and folds, the fold is replaced once the node is compiled.
+            m_processor->m_call_back.reset();
+            m_processor->m_scalar_outputs.clear();
+            m_processor->m_output_channels.clear();
+            m_processor->m_in_place.clear();
+            m_processor->m_pure = false;
+            m_processor->m_tail.store(Processor::infinite_tail, std::memory_order_relaxed);
+            m_processor->m_tail_any.store(false, std::memory_order_relaxed);
+            m_processor->m_skippable.store(false, std::memory_order_relaxed);
+            m_processor->m_elementwise = false;
+            m_processor->m_operand = nullptr;
         }
         
         // ==================================================================================== //
-        //                                          NODE::TIE                                   //
+        //                                          STEP                                        //
         // ==================================================================================== //
         
-        Chain::Node::Tie::Tie(Pin& pin):
-        m_pin(pin)
-        {
-        }
-        
-        bool Chain::Node::Tie::operator<(Tie const& other) const noexcept
+        Chain::Step::Step(Node& node) :
+        m_node(node),
+        m_fused_nodes(),
+        m_input_pins(),
+        m_processor(node.m_processor),
+        m_call_back(node.m_processor->m_call_back),
+        m_fold(),
+        m_inputs(),
+        m_outputs(),
+        m_index(0),
+        m_successors(),
+        m_npredecessors(0),
+        m_pending(0)
         {
-            return (&m_pin.m_owner < &other.m_pin.m_owner
-                    || (&m_pin.m_owner == &other.m_pin.m_owner && m_pin.m_index < other.m_pin.m_index));
         }
         
         // ==================================================================================== //
-        //                                          CHAIN                                       //
+        //                                          PLAN                                        //
         // ==================================================================================== //
         
-        Chain::Chain() :
-        m_nodes(),
-        m_sample_rate(),
-        m_vector_size(),
-        m_state(State::NotPrepared),
-        m_tick_mutex()
-        {
-            ;
-        }
-        
-        Chain::~Chain()
+        void Chain::Plan::tick() noexcept
         {
-            m_nodes.clear();
+            const bool measure = m_profiling->load(std::memory_order_relaxed)
+                                 || m_counting_denormals->load(std::memory_order_relaxed);
+            
+            if(!m_refolds.empty())
+            {
+                refold();
+            }
+            
+            if(m_parallel_tick)
+            {
+                m_parallel_tick->tick(*m_thread_pool, measure);
+            }
+            else if(measure)
+            {
+                for(Record const& record : m_records)
+                {
+                    this->measure(record);
+                }
+            }
+            else
+            {
+                for(Record const& record : m_records)
+                {
+                    perform(record);
+                }
+            }
         }
         
-        // ============================================================================ //
-        //                              THE UPDATE AND PREPARE                          //
-        // ============================================================================ //
-        
-        void Chain::update()
+        void Chain::Plan::refold() noexcept
         {
-            if (!m_commands.empty())
+            for(Refold& refold : m_refolds)
             {
-                State prev_state = m_state;
+                bool changed = (refold.m_stale->load(std::memory_order_relaxed)
+                                || refold.m_invalid->load(std::memory_order_relaxed));
                 
-                const size_t prev_samplerate = getSampleRate();
-                const size_t prev_vectorsize = getVectorSize();
+                for(size_t i = refold.m_first_source; !changed && i < refold.m_last_source; ++i)
+                {
+                    changed = m_refolds[m_fold_sources[i]].m_changed;
+                }
                 
-                release();
+                refold.m_changed = changed;
                 
-                while(!m_commands.empty())
+                if(!changed)
                 {
-                    m_commands.front().operator()();
-                    m_commands.pop_front();
+                    continue;
+                }
+                
+                RealTime::Scope scope(refold.m_name);
+                
+                // the values changed by the other threads before the flags are cleared are read.
+                refold.m_stale->store(false, std::memory_order_relaxed);
+                refold.m_invalid->exchange(false, std::memory_order_acquire);
+                
+                for(size_t i = refold.m_first_sum; i < refold.m_last_sum; ++i)
+                {
+                    FoldSum const& sum = m_fold_sums[i];
+                    
+                    if(sum.m_first)
+                    {
+                        m_copy(sum.m_source, sum.m_output, sum.m_size);
+                    }
+                    else
+                    {
+                        m_add(sum.m_output, sum.m_source, sum.m_output, sum.m_size);
+                    }
                 }
                 
-                if (prev_state == State::Prepared || prev_state == State::Preparing)
+                refold.m_perform(*refold.m_context, *refold.m_inputs, *refold.m_outputs);
+                
+                Buffer const& outputs = *refold.m_outputs;
+                
+                for(size_t i = 0; i < outputs.getNumberOfChannels(); ++i)
                 {
-                    prepare(prev_samplerate, prev_vectorsize);
+                    refold.m_silent[i] = m_abs_max(outputs[i].data(), outputs[i].size()) == 0.;
                 }
             }
         }
         
-        void Chain::prepare(const size_t samplerate, const size_t vector_size)
+        bool Chain::Plan::skip(Record const& record) const noexcept
         {
-            release();
+            Silence& silence = *record.m_silence;
+            const size_t tail = silence.m_tail->load(std::memory_order_relaxed);
+            const bool any = silence.m_any->load(std::memory_order_relaxed);
             
-            update();
-            
-            m_state = State::Preparing;
-            
-            m_sample_rate = samplerate;
-            m_vector_size = vector_size;
-            
-            indexNodes();
+            // the silence is counted again when the processor changes its tail.
+            if(tail != silence.m_last_tail)
+            {
+                silence.m_last_tail = tail;
+                silence.m_samples = 0ul;
+            }
             
-            sortNodes();
+            bool silent = !any;
             
-            for(auto node = m_nodes.begin(); node != m_nodes.end();)
+            for(size_t i = silence.m_first_input; i < silence.m_last_input; ++i)
             {
-                if ((*node)->prepare(*this))
-                {
-                    ++node;
-                }
-                else
+                if(*m_silent_inputs[i] == any)
                 {
-                    restackNode(**node);
-                    node = m_nodes.erase(node);
+                    silent = any;
+                    break;
                 }
             }
             
-            m_state = State::Prepared;
-        }
-        
-        void Chain::restackNode(Node & node)
-        {
-            // ======================================================================== //
-            //                    RESTACK INLET CONNECTIONS                             //
-            // ======================================================================== //
+            if(!silent)
+            {
+                silence.m_samples = 0ul;
+                return false;
+            }
             
-            for(Node::Pin& inlet : node.m_inlets)
+            if(tail == Processor::infinite_tail || silence.m_samples < tail)
             {
-                for(Node::Tie tie : inlet.m_ties)
-                {
-                    Node::Pin& prev_pin = tie.m_pin;
-                    Node& prev_node  = tie.m_pin.m_owner;
-                    
-                    connect(*prev_node.m_processor, prev_pin.m_index, *node.m_processor, inlet.m_index);
-                    
-                    std::function<void(void)> call_back = std::bind(&Chain::execConnect,
-                                                                    this,
-                                                                    prev_node.m_processor.get(), prev_pin.m_index,
-                                                                    node.m_processor.get(), inlet.m_index);
-                    m_commands.push_front(call_back);
-                }
+                silence.m_samples += m_vector_size;
+                return false;
             }
             
-            // ======================================================================== //
-            //                    RESTACK OUTLET CONNECTIONS                            //
-            // ======================================================================== //
+            Buffer& outputs = *record.m_outputs;
             
-            for(Node::Pin& outlet : node.m_outlets)
+            for(size_t i = 0; i < outputs.getNumberOfChannels(); ++i)
             {
-                for(Node::Tie tie : outlet.m_ties)
-                {
-                    Node::Pin& next_pin = tie.m_pin;
-                    Node& next_node  = tie.m_pin.m_owner;
-                    
-                    connect(*node.m_processor, outlet.m_index, *next_node.m_processor, next_pin.m_index);
-                    
-                    std::function<void(void)> call_back = std::bind(&Chain::execConnect,
-                                                                    this,
-                                                                    node.m_processor.get(), outlet.m_index,
-                                                                    next_node.m_processor.get(), next_pin.m_index);
-                    m_commands.push_front(call_back);
-                }
+                m_fill(0., outputs[i].data(), outputs[i].size());
             }
             
-            // ======================================================================== //
-            //                           RESTACK PROCESSOR                              //
-            // ======================================================================== //
+            for(size_t i = record.m_first_detector; i < record.m_last_detector; ++i)
+            {
+                *m_detectors[i].m_silent = true;
+            }
+            
+            m_nskipped->fetch_add(1, std::memory_order_relaxed);
             
-            m_commands.push_front(std::bind(&Chain::execAddProcessor, this, node.m_processor));
+            return true;
         }
         
-        // ============================================================================ //
-        //                              THE RELEASE METHOD                              //
-        // ============================================================================ //
-        
-        void Chain::release()
+        void Chain::Plan::countDenormals(Record const& record) const noexcept
         {
-            std::lock_guard<std::mutex> lock(m_tick_mutex);
-            
-            m_state = State::NotPrepared;
-            
-            m_sample_rate = 0.;
-            m_vector_size = 0.;
+            Buffer const& outputs = *record.m_outputs;
             
-            for(auto node = m_nodes.begin(); node != m_nodes.end(); ++node)
+            for(size_t i = 0; i < outputs.getNumberOfChannels(); ++i)
             {
-                (*node)->release();
+                const size_t count = Denormals::count(outputs[i].data(), outputs[i].size());
+                
+                if(count != 0ul)
+                {
+                    record.m_denormals[i].fetch_add(count, std::memory_order_relaxed);
+                }
             }
         }
         
-        size_t Chain::getSampleRate() const noexcept
+        void Chain::Plan::sumChannels(FanIn const& fan_in) const noexcept
         {
-            return m_sample_rate;
+            // the channels of the narrowest operand are summed, the others are copied from the widest.
+            
+            const size_t rhs_size = fan_in.m_rhs != nullptr ? fan_in.m_rhs_size : 0ul;
+            const size_t common = std::min(fan_in.m_lhs_size, rhs_size);
+            sample_t const* wider = fan_in.m_lhs_size >= rhs_size ? fan_in.m_lhs : fan_in.m_rhs;
+            const size_t wider_size = std::max(fan_in.m_lhs_size, rhs_size);
+            
+            if(common != 0ul)
+            {
+                m_add(fan_in.m_lhs, fan_in.m_rhs, fan_in.m_output, common);
+            }
+            
+            if(wider != fan_in.m_output)
+            {
+                m_copy(wider + common, fan_in.m_output + common, wider_size - common);
+            }
+            
+            if(wider_size < fan_in.m_size)
+            {
+                m_fill(0., fan_in.m_output + wider_size, fan_in.m_size - wider_size);
+            }
+            
+            *fan_in.m_output_silent = *fan_in.m_lhs_silent && (fan_in.m_rhs == nullptr || *fan_in.m_rhs_silent);
         }
         
-        size_t Chain::getVectorSize() const noexcept
-        {
-            return m_vector_size;
-        }
+        // ==================================================================================== //
+        //                                          FUSION                                      //
+        // ==================================================================================== //
         
-        void Chain::tick() noexcept
+        Chain::Fusion::Fusion(std::vector<Node*> const& nodes) :
+        IPerformCallBack(&Fusion::trampoline),
+        m_processors(),
+        m_stages(),
+        m_operands(),
+        m_fused(Kernels::get().fused)
         {
-            std::unique_lock<std::mutex> lock(m_tick_mutex, std::defer_lock);
+            size_t input = 1ul;
             
-            if (m_state == State::Prepared && lock.try_lock())
+            for(Node* node : nodes)
             {
-                size_t const node_number = m_nodes.size();
+                Processor const& processor = *node->m_processor;
+                
+                m_processors.push_back(node->m_processor);
+                m_stages.push_back({processor.m_operation, nullptr, 0.});
                 
-                for(size_t i = 0; i < node_number; ++i)
+                if(processor.m_operand != nullptr)
                 {
-                    m_nodes[i]->perform();
+                    m_operands.push_back({processor.m_operand, 0ul, false});
+                }
+                else
+                {
+                    m_operands.push_back({nullptr, input++, node->m_scalars.size() > 1 && node->m_scalars[1]});
+                }
+            }
+        }
+        
+        void Chain::Fusion::trampoline(IPerformCallBack& call_back, Buffer const& input, Buffer& output)
+        {
+            Fusion& self = static_cast<Fusion&>(call_back);
+            
+            for(size_t i = 0; i < self.m_stages.size(); ++i)
+            {
+                Operand const& operand = self.m_operands[i];
+                Kernels::Stage& stage = self.m_stages[i];
+                
+                if(operand.m_value != nullptr)
+                {
+                    stage.value = operand.m_value->load(std::memory_order_relaxed);
+                }
+                else if(operand.m_scalar)
+                {
+                    stage.value = input[operand.m_input][0];
+                }
+                else
+                {
+                    stage.signal = input[operand.m_input].data();
+                }
+            }
+            
+            Signal& out = output[0];
+            
+            self.m_fused(self.m_stages.data(), self.m_stages.size(), input[0].data(), out.data(), out.size());
+        }
+        
+        // ==================================================================================== //
+        //                                      PARALLEL TICK                                   //
+        // ==================================================================================== //
+        
+        Chain::ParallelTick::ParallelTick(Plan const& plan, size_t nthreads) :
+        m_plan(plan),
+        m_steps(),
+        m_roots(),
+        m_nthreads(nthreads),
+        m_queues(new StealingQueue<Step>[nthreads]),
+        m_remaining(0),
+        m_measure(false)
+        {
+            m_steps.reserve(plan.m_steps.size());
+            
+            for(std::unique_ptr<Step> const& step : plan.m_steps)
+            {
+                m_steps.push_back(step.get());
+                
+                if(step->m_npredecessors == 0)
+                {
+                    m_roots.push_back(step.get());
+                }
+            }
+            
+            for(size_t i = 0; i < m_nthreads; ++i)
+            {
+                m_queues[i].reset(m_steps.size());
+            }
+        }
+        
+        void Chain::ParallelTick::tick(ThreadPool& pool, const bool measure) noexcept
+        {
+            for(Step* step : m_steps)
+            {
+                step->m_pending.store(step->m_npredecessors, std::memory_order_relaxed);
+            }
+            
+            for(size_t i = 0; i < m_nthreads; ++i)
+            {
+                m_queues[i].reset(m_steps.size());
+            }
+            
+            for(Step* root : m_roots)
+            {
+                m_queues[0].push(root);
+            }
+            
+            m_remaining.store(m_steps.size(), std::memory_order_relaxed);
+            m_measure = measure;
+            
+            pool.perform(*this);
+        }
+        
+        void Chain::ParallelTick::perform(size_t thread) noexcept
+        {
+            Denormals::Scope scope;
+            
+            if(m_measure)
+            {
+                run<true>(thread);
+            }
+            else
+            {
+                run<false>(thread);
+            }
+        }
+        
+        template<bool TMeasure>
+        void Chain::ParallelTick::run(size_t thread) noexcept
+        {
+            StealingQueue<Step>& queue = m_queues[thread];
+            size_t misses = 0ul;
+            
+            while(m_remaining.load(std::memory_order_acquire) != 0)
+            {
+                Step* step = queue.pop();
+                
+                for(size_t i = 1; step == nullptr && i < m_nthreads; ++i)
+                {
+                    step = m_queues[(thread + i) % m_nthreads].steal();
+                }
+                
+                if(step == nullptr)
+                {
+                    // yields after a while in case the thread performing a step has been preempted.
+                    if(++misses < 64ul)
+                    {
+                        ThreadPool::pause();
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                    
+                    continue;
+                }
+                
+                misses = 0ul;
+                
+                // the last successor that becomes ready is performed right away by the same thread.
+                
+                while(step != nullptr)
+                {
+                    if(TMeasure)
+                    {
+                        m_plan.measure(m_plan.m_records[step->m_index]);
+                    }
+                    else
+                    {
+                        m_plan.perform(m_plan.m_records[step->m_index]);
+                    }
+                    
+                    Step* next = nullptr;
+                    
+                    for(Step* successor : step->m_successors)
+                    {
+                        if(successor->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            if(next != nullptr)
+                            {
+                                queue.push(next);
+                            }
+                            
+                            next = successor;
+                        }
+                    }
+                    
+                    m_remaining.fetch_sub(1, std::memory_order_release);
+                    
+                    step = next;
+                }
+            }
+        }
+        
+        // ==================================================================================== //
+        //                                          METER                                       //
+        // ==================================================================================== //
+        
+        Chain::Meter::Meter() noexcept :
+        m_performs(0ul),
+        m_sum(0ul),
+        m_min(std::numeric_limits<uint64_t>::max()),
+        m_max(0ul),
+        m_buckets()
+        {
+            for(auto& bucket : m_buckets)
+            {
+                bucket.store(0u, std::memory_order_relaxed);
+            }
+        }
+        
+        size_t Chain::Meter::getBucket(uint64_t time) noexcept
+        {
+            if(time < 4ul)
+            {
+                return time;
+            }
+            
+            // the octave's first bucket and the two bits that follow the leading one.
+            size_t octave = 2ul;
+            while(octave < 32ul && (time >> (octave + 1ul)) != 0ul)
+            {
+                ++octave;
+            }
+            
+            if(octave == 32ul)
+            {
+                return nbuckets - 1ul;
+            }
+            
+            return (octave - 1ul) * 4ul + ((time >> (octave - 2ul)) & 3ul);
+        }
+        
+        uint64_t Chain::Meter::getBucketMax(size_t bucket) noexcept
+        {
+            if(bucket < 4ul)
+            {
+                return bucket;
+            }
+            
+            const size_t octave = bucket / 4ul + 1ul;
+            const uint64_t step = uint64_t(1) << (octave - 2ul);
+            
+            return (4ul + bucket % 4ul) * step + step - 1ul;
+        }
+        
+        void Chain::Meter::add(std::chrono::nanoseconds time) noexcept
+        {
+            const uint64_t nanoseconds = static_cast<uint64_t>(std::max(time.count(), decltype(time.count())(0)));
+            
+            m_performs.fetch_add(1ul, std::memory_order_relaxed);
+            m_sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+            m_buckets[getBucket(nanoseconds)].fetch_add(1u, std::memory_order_relaxed);
+            
+            uint64_t min = m_min.load(std::memory_order_relaxed);
+            while(nanoseconds < min && !m_min.compare_exchange_weak(min, nanoseconds, std::memory_order_relaxed))
+            {
+                ;
+            }
+            
+            uint64_t max = m_max.load(std::memory_order_relaxed);
+            while(nanoseconds > max && !m_max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed))
+            {
+                ;
+            }
+        }
+        
+        Chain::Profile Chain::Meter::collect() noexcept
+        {
+            // a time added meanwhile may be counted in the next window by some of the accumulators.
+            
+            const uint64_t performs = m_performs.exchange(0ul, std::memory_order_relaxed);
+            const uint64_t sum = m_sum.exchange(0ul, std::memory_order_relaxed);
+            const uint64_t min = m_min.exchange(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            const uint64_t max = m_max.exchange(0ul, std::memory_order_relaxed);
+            
+            std::array<uint32_t, nbuckets> buckets;
+            uint64_t total = 0ul;
+            
+            for(size_t i = 0; i < nbuckets; ++i)
+            {
+                buckets[i] = m_buckets[i].exchange(0u, std::memory_order_relaxed);
+                total += buckets[i];
+            }
+            
+            Profile profile {static_cast<size_t>(performs), std::chrono::nanoseconds(0),
+                             std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+            
+            if(performs == 0ul || total == 0ul || min > max)
+            {
+                return profile;
+            }
+            
+            // the smallest bucket below which at least 99% of the times are.
+            const uint64_t rank = (total * 99ul + 99ul) / 100ul;
+            uint64_t count = 0ul;
+            size_t bucket = 0ul;
+            
+            for(; bucket < nbuckets - 1ul; ++bucket)
+            {
+                count += buckets[bucket];
+                
+                if(count >= rank)
+                {
+                    break;
+                }
+            }
+            
+            const uint64_t p99 = std::min(std::max(getBucketMax(bucket), min), max);
+            
+            using ns = std::chrono::nanoseconds;
+            
+            profile.min = ns(static_cast<ns::rep>(min));
+            profile.average = ns(static_cast<ns::rep>(sum / performs));
+            profile.max = ns(static_cast<ns::rep>(max));
+            profile.p99 = ns(static_cast<ns::rep>(p99));
+            
+            return profile;
+        }
+        
+        // ==================================================================================== //
+        //                                          NODE::PIN                                   //
+        // ==================================================================================== //
+        
+        Chain::Node::Pin::Pin(Node& owner, const size_t index) :
+        m_owner(owner),
+        m_index(index),
+        m_slot(0),
+        m_ties()
+        {
+            ;
+        }
+        
+        Chain::Node::Pin::Pin(Pin && other):
+        m_owner(other.m_owner),
+        m_index(other.m_index),
+        m_slot(other.m_slot),
+        m_ties(std::move(other.m_ties))
+        {
+        }
+        
+        Chain::Node::Pin::~Pin()
+        {
+            disconnect();
+        }
+        
+        bool Chain::Node::Pin::connect(Pin& other_pin)
+        {
+            return m_ties.insert(Tie(other_pin)).second && other_pin.m_ties.insert(Tie(*this)).second;
+        }
+        
+        bool Chain::Node::Pin::disconnect(Pin& other_pin)
+        {
+            return m_ties.erase(Tie(other_pin)) && other_pin.m_ties.erase(Tie(*this));
+        }
+        
+        void Chain::Node::Pin::disconnect()
+        {
+            for (std::set<Tie>::iterator tie = m_ties.begin(); tie != m_ties.end();)
+            {
+                tie->m_pin.m_ties.erase(Tie(*this));
+                tie = m_ties.erase(tie);
+            }
+        }
+        
+        // ==================================================================================== //
+        //                                          NODE::TIE                                   //
+        // ==================================================================================== //
+        
+        Chain::Node::Tie::Tie(Pin& pin):
+        m_pin(pin)
+        {
+        }
+        
+        bool Chain::Node::Tie::operator<(Tie const& other) const noexcept
+        {
+            return (&m_pin.m_owner < &other.m_pin.m_owner
+                    || (&m_pin.m_owner == &other.m_pin.m_owner && m_pin.m_index < other.m_pin.m_index));
+        }
+        
+        // ==================================================================================== //
+        //                                          CHAIN                                       //
+        // ==================================================================================== //
+        
+        Chain::Chain() :
+        m_nodes(),
+        m_processor_nodes(),
+        m_sample_rate(),
+        m_vector_size(),
+        m_state(State::NotPrepared),
+        m_commands(),
+        m_thread_pool(),
+        m_plan(),
+        m_retired_plans(),
+        m_removed_nodes(),
+        m_dirty_nodes(),
+        m_sorted(true),
+        m_reordered_nodes(0ul),
+        m_nprepared(0ul),
+        m_prepare_time(0),
+        m_nskipped(0ul),
+        m_profiling(false),
+        m_counting_denormals(false),
+        m_published_plan(nullptr),
+        m_ticked_plan(nullptr)
+        {
+            ;
+        }
+        
+        Chain::~Chain()
+        {
+            publishPlan(nullptr);
+            reclaimPlans(true);
+            
+            for(auto& node : m_nodes)
+            {
+                try
+                {
+                    node->release();
+                }
+                catch(Error & e)
+                {
+                    
+                }
+            }
+            
+            m_processor_nodes.clear();
+            m_nodes.clear();
+        }
+        
+        // ============================================================================ //
+        //                              THE UPDATE AND PREPARE                          //
+        // ============================================================================ //
+        
+        void Chain::update()
+        {
+            if (!m_commands.empty())
+            {
+                m_reordered_nodes = 0ul;
+                
+                while(!m_commands.empty())
+                {
+                    m_commands.front().operator()();
+                    m_commands.pop_front();
+                }
+                
+                if (m_state == State::Prepared || m_state == State::Preparing)
+                {
+                    compile();
+                    
+                    m_state = State::Prepared;
+                }
+                else
+                {
+                    reclaimPlans(false);
+                }
+            }
+        }
+        
+        void Chain::prepare(const size_t samplerate, const size_t vector_size)
+        {
+            release();
+            
+            update();
+            
+            m_nskipped.store(0ul, std::memory_order_relaxed);
+            
+            for(auto& node : m_nodes)
+            {
+                setDirty(*node);
+            }
+            
+            m_state = State::Preparing;
+            
+            m_sample_rate = samplerate;
+            m_vector_size = vector_size;
+            
+            compile();
+            
+            m_state = State::Prepared;
+        }
+        
+        void Chain::compile()
+        {
+            if(!m_sorted)
+            {
+                sortNodes();
+                
+                m_sorted = true;
+            }
+            
+            reclaimPlans(false);
+            
+            struct compare_index
+            {
+                bool operator()(Node const* l_node, Node const* r_node) const
+                {
+                    return l_node->m_index > r_node->m_index;
+                };
+            };
+            
+            m_nprepared = 0ul;
+            m_prepare_time = std::chrono::nanoseconds::zero();
+            
+            std::vector<Node*> busy_nodes;
+            std::vector<Node*> compiled_nodes;
+            
+            do
+            {
+                // the dirty nodes are prepared in order so that their inputs are up to date.
+                std::make_heap(m_dirty_nodes.begin(), m_dirty_nodes.end(), compare_index());
+                
+                while(!m_dirty_nodes.empty())
+                {
+                    std::pop_heap(m_dirty_nodes.begin(), m_dirty_nodes.end(), compare_index());
+                    
+                    Node& node = *m_dirty_nodes.back();
+                    
+                    compiled_nodes.push_back(&node);
+                    
+                    std::vector<bool> inputs = node.getInputStatus();
+                    std::vector<bool> scalars = node.getScalarStatus();
+                    std::vector<size_t> channels = node.getChannelStatus();
+                    
+                    if(node.m_prepared && inputs == node.m_inputs && scalars == node.m_scalars
+                       && channels == node.m_channels)
+                    {
+                        node.m_dirty = false;
+                        m_dirty_nodes.pop_back();
+                        continue;
+                    }
+                    
+                    const bool node_busy = node.isBusy() || std::any_of(m_removed_nodes.begin(),
+                                                                        m_removed_nodes.end(),
+                                                                        [&node](Node::uPtr const& removed)
+                    {
+                        return removed->m_processor == node.m_processor && removed->isBusy();
+                    });
+                    
+                    if(node_busy)
+                    {
+                        // the plans in use perform the node, it keeps its previous preparation until they're
+                        // left if its inputs still have the channels it was prepared with.
+                        node.m_stale = node.m_prepared && channels == node.m_channels;
+                        busy_nodes.push_back(&node);
+                        m_dirty_nodes.pop_back();
+                        continue;
+                    }
+                    
+                    const bool perform = node.m_perform;
+                    const std::vector<bool> scalar_outputs = node.m_processor->m_scalar_outputs;
+                    const std::vector<size_t> output_channels = node.m_processor->m_output_channels;
+                    const auto start = std::chrono::steady_clock::now();
+                    
+                    // if the processor throws, the node stays dirty.
+                    node.m_stale = false;
+                    node.prepare(*this, inputs, scalars, channels);
+                    
+                    m_prepare_time += std::chrono::steady_clock::now() - start;
+                    ++m_nprepared;
+                    
+                    node.m_dirty = false;
+                    m_dirty_nodes.pop_back();
+                    
+                    if(node.m_perform != perform || node.m_processor->m_scalar_outputs != scalar_outputs
+                       || node.m_processor->m_output_channels != output_channels)
+                    {
+                        for(Node::Pin const& outlet : node.m_outlets)
+                        {
+                            for(Node::Tie const& tie : outlet.m_ties)
+                            {
+                                if(!tie.m_pin.m_owner.m_dirty)
+                                {
+                                    setDirty(tie.m_pin.m_owner);
+                                    std::push_heap(m_dirty_nodes.begin(), m_dirty_nodes.end(), compare_index());
+                                }
+                            }
+                        }
+                    }
+                }
+                
+                m_dirty_nodes.swap(busy_nodes);
+                
+                foldNodes(std::move(compiled_nodes));
+                compiled_nodes.clear();
+                
+                publishPlan(createPlan());
+                
+                // the busy nodes are prepared once the audio thread has left the plans that perform them.
+                // The stale nodes are only removed from the plan once the older plans are left, so that
+                // they are prepared right after a tick and their new steps are likely published before
+                // the next one.
+                if(!m_dirty_nodes.empty())
+                {
+                    reclaimPlans(true);
+                    
+                    if(std::any_of(m_dirty_nodes.begin(), m_dirty_nodes.end(), [](Node const* node) {return node->m_stale;}))
+                    {
+                        for(Node* node : m_dirty_nodes)
+                        {
+                            node->m_stale = false;
+                        }
+                        
+                        publishPlan(createPlan());
+                        reclaimPlans(true);
+                    }
+                }
+            }
+            while(!m_dirty_nodes.empty());
+        }
+        
+        // ============================================================================ //
+        //                              THE RELEASE METHOD                              //
+        // ============================================================================ //
+        
+        void Chain::release()
+        {
+            publishPlan(nullptr);
+            reclaimPlans(true);
+            
+            m_state = State::NotPrepared;
+            
+            m_sample_rate = 0.;
+            m_vector_size = 0.;
+            
+            for(auto node = m_nodes.begin(); node != m_nodes.end(); ++node)
+            {
+                (*node)->release();
+                (*node)->m_fold.reset();
+            }
+        }
+        
+        size_t Chain::getSampleRate() const noexcept
+        {
+            return m_sample_rate;
+        }
+        
+        size_t Chain::getVectorSize() const noexcept
+        {
+            return m_vector_size;
+        }
+        
+        size_t Chain::getNumberOfSignals() const noexcept
+        {
+            return m_plan ? m_plan->m_signals.size() : 0ul;
+        }
+        
+        size_t Chain::getSignalMemorySize() const noexcept
+        {
+            return m_plan ? m_plan->m_signal_memory_size : 0ul;
+        }
+        
+        size_t Chain::getNumberOfPreparedProcessors() const noexcept
+        {
+            return m_nprepared;
+        }
+        
+        std::chrono::nanoseconds Chain::getPrepareTime() const noexcept
+        {
+            return m_prepare_time;
+        }
+        
+        size_t Chain::getNumberOfFoldedProcessors() const noexcept
+        {
+            return m_plan ? m_plan->m_nfolded : 0ul;
+        }
+        
+        size_t Chain::getNumberOfSkippedPerforms() const noexcept
+        {
+            return m_nskipped.load(std::memory_order_relaxed);
+        }
+        
+        void Chain::setProfiling(bool enabled) noexcept
+        {
+            if(enabled && !m_profiling.load(std::memory_order_relaxed))
+            {
+                for(auto const& node : m_nodes)
+                {
+                    node->m_meter.collect();
+                }
+            }
+            
+            m_profiling.store(enabled, std::memory_order_relaxed);
+        }
+        
+        bool Chain::isProfiling() const noexcept
+        {
+            return m_profiling.load(std::memory_order_relaxed);
+        }
+        
+        Chain::Profile Chain::collectProfile(Processor const& processor)
+        {
+            auto it = m_processor_nodes.find(&processor);
+            
+            if(it == m_processor_nodes.end())
+            {
+                return Profile {0ul, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0),
+                                std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+            }
+            
+            return it->second->m_meter.collect();
+        }
+        
+        void Chain::setCountingDenormals(bool enabled) noexcept
+        {
+            if(enabled && !m_counting_denormals.load(std::memory_order_relaxed))
+            {
+                for(auto const& node : m_nodes)
+                {
+                    for(size_t i = 0; i < node->m_outlets.size(); ++i)
+                    {
+                        node->m_denormals[i].store(0ul, std::memory_order_relaxed);
+                    }
+                }
+            }
+            
+            m_counting_denormals.store(enabled, std::memory_order_relaxed);
+        }
+        
+        bool Chain::isCountingDenormals() const noexcept
+        {
+            return m_counting_denormals.load(std::memory_order_relaxed);
+        }
+        
+        std::vector<size_t> Chain::collectDenormals(Processor const& processor)
+        {
+            auto it = m_processor_nodes.find(&processor);
+            
+            if(it == m_processor_nodes.end())
+            {
+                return std::vector<size_t>();
+            }
+            
+            Node const& node = *it->second;
+            std::vector<size_t> counts(node.m_outlets.size());
+            
+            for(size_t i = 0; i < counts.size(); ++i)
+            {
+                counts[i] = node.m_denormals[i].exchange(0ul, std::memory_order_relaxed);
+            }
+            
+            return counts;
+        }
+        
+        bool Chain::isParallel() const noexcept
+        {
+            return m_plan && m_plan->m_parallel_tick != nullptr;
+        }
+        
+        void Chain::tick() noexcept
+        {
+            // The ticked plan tells the updating thread which plan can't be deleted yet,
+            // it's checked against the published plan in case it has just been retired.
+            
+            RealTime::Scope scope;
+            Denormals::Scope denormals;
+            
+            Plan* plan = m_published_plan.load();
+            
+            for(;;)
+            {
+                m_ticked_plan.store(plan);
+                
+                Plan* const published = m_published_plan.load();
+                
+                if(published == plan)
+                {
+                    break;
+                }
+                
+                plan = published;
+            }
+            
+            if(plan != nullptr)
+            {
+                plan->tick();
+            }
+            
+            m_ticked_plan.store(nullptr, std::memory_order_release);
+        }
+        
+        // ============================================================================ //
+        //                                    PLANS                                     //
+        // ============================================================================ //
+        
+        void Chain::foldNodes(std::vector<Node*> nodes)
+        {
+            // The nodes are visited in order so the folds of the sources are up to date. A node keeps its
+            // fold while it's not prepared again and reads the same signals, the plans in use may read it.
+            // The successors of a node whose fold changed are visited too.
+            
+            auto compare_index = [](Node const* l_node, Node const* r_node)
+            {
+                return l_node->m_index > r_node->m_index;
+            };
+            
+            std::set<Node*> queued(nodes.begin(), nodes.end());
+            nodes.assign(queued.begin(), queued.end());
+            std::make_heap(nodes.begin(), nodes.end(), compare_index);
+            
+            // the folding of a constant node depends on the inlets it's connected to.
+            std::set<Node*> checked;
+            Signal::sPtr zero;
+            
+            while(!nodes.empty())
+            {
+                std::pop_heap(nodes.begin(), nodes.end(), compare_index);
+                Node& node = *nodes.back();
+                nodes.pop_back();
+                queued.erase(&node);
+                checked.insert(&node);
+                
+                bool constant = (m_vector_size != 0ul && node.m_prepared && node.m_perform && !node.m_dirty
+                                 && node.m_processor->isPure() && !node.isMultichannel());
+                
+                std::vector<std::vector<Signal::sPtr>> sources(node.m_inlets.size());
+                
+                for(size_t i = 0; i < node.m_inlets.size(); ++i)
+                {
+                    for(Node::Tie const& tie : node.m_inlets[i].m_ties)
+                    {
+                        Node& source = tie.m_pin.m_owner;
+                        
+                        if(!source.m_perform)
+                        {
+                            continue;
+                        }
+                        
+                        checked.insert(&source);
+                        
+                        if(!source.m_fold)
+                        {
+                            constant = false;
+                        }
+                        else if(constant)
+                        {
+                            sources[i].push_back(source.m_fold->m_outputs[tie.m_pin.m_index]);
+                        }
+                    }
+                }
+                
+                std::shared_ptr<Fold> fold;
+                
+                if(constant && node.m_fold && node.m_fold->m_preparation == node.m_preparations
+                   && node.m_fold->m_sources == sources)
+                {
+                    fold = node.m_fold;
+                }
+                else if(constant)
+                {
+                    // the inlets with several sources sum them in their own signal.
+                    fold = std::make_shared<Fold>();
+                    fold->m_preparation = node.m_preparations;
+                    
+                    for(std::vector<Signal::sPtr> const& inlet_sources : sources)
+                    {
+                        if(inlet_sources.empty())
+                        {
+                            if(!zero)
+                            {
+                                zero = Signal::createZero(m_vector_size);
+                            }
+                            
+                            fold->m_inputs.push_back(zero);
+                        }
+                        else if(inlet_sources.size() == 1)
+                        {
+                            fold->m_inputs.push_back(inlet_sources.front());
+                        }
+                        else
+                        {
+                            fold->m_inputs.push_back(std::make_shared<Signal>(m_vector_size));
+                        }
+                    }
+                    
+                    for(size_t i = 0; i < node.m_outlets.size(); ++i)
+                    {
+                        fold->m_outputs.push_back(std::make_shared<Signal>(m_vector_size));
+                    }
+                    
+                    fold->m_silent.reset(new bool[node.m_outlets.size()]());
+                    fold->m_sources = std::move(sources);
+                }
+                
+                if(fold != node.m_fold)
+                {
+                    node.m_fold = std::move(fold);
+                    
+                    for(Node::Pin const& outlet : node.m_outlets)
+                    {
+                        for(Node::Tie const& tie : outlet.m_ties)
+                        {
+                            Node* successor = &tie.m_pin.m_owner;
+                            
+                            if(queued.insert(successor).second)
+                            {
+                                nodes.push_back(successor);
+                                std::push_heap(nodes.begin(), nodes.end(), compare_index);
+                            }
+                        }
+                    }
+                }
+            }
+            
+            // A constant node whose outputs are summed with other sources keeps being performed.
+            
+            for(Node* node : checked)
+            {
+                node->m_folded = node->m_fold && std::all_of(node->m_outlets.begin(), node->m_outlets.end(),
+                                                             [](Node::Pin const& outlet)
+                {
+                    return std::all_of(outlet.m_ties.begin(), outlet.m_ties.end(), [](Node::Tie const& tie)
+                    {
+                        Node::Pin const& inlet = tie.m_pin;
+                        
+                        return std::count_if(inlet.m_ties.begin(), inlet.m_ties.end(), [](Node::Tie const& source)
+                        {
+                            return source.m_pin.m_owner.m_perform;
+                        }) == 1;
+                    });
+                });
+            }
+        }
+        
+        void Chain::fuseNodes() const
+        {
+            auto fusable = [](Node const& node)
+            {
+                return (node.m_prepared && node.m_perform && !node.m_dirty && !node.m_folded
+                        && !node.isMultichannel() && node.m_processor->m_elementwise && node.m_outlets.size() == 1
+                        && (node.m_processor->m_operand != nullptr || node.m_inlets.size() > 1));
+            };
+            
+            for(auto const& node : m_nodes)
+            {
+                node->m_fused = false;
+                
+                if(fusable(*node) && node->m_outlets[0].m_ties.size() == 1)
+                {
+                    Node::Pin const& reader = node->m_outlets[0].m_ties.begin()->m_pin;
+                    
+                    node->m_fused = (reader.m_index == 0 && reader.m_ties.size() == 1 && fusable(reader.m_owner));
+                }
+            }
+        }
+        
+        std::unique_ptr<Chain::Plan> Chain::createPlan() const
+        {
+            std::unique_ptr<Plan> plan(new Plan());
+            
+            fuseNodes();
+            
+            for(auto const& node : m_nodes)
+            {
+                node->m_step = nullptr;
+                
+                if(node->m_folded)
+                {
+                    ++plan->m_nfolded;
+                }
+                
+                if(node->m_prepared && node->m_perform && (!node->m_dirty || node->m_stale) && !node->m_folded
+                   && !node->m_fused)
+                {
+                    plan->m_steps.emplace_back(new Step(*node));
+                    
+                    Step& step = *plan->m_steps.back();
+                    step.m_index = plan->m_steps.size() - 1;
+                    node->m_step = &step;
+                    
+                    // the nodes of a run precede its last node, they are performed by its step.
+                    for(Node* head = node.get(); head->m_inlets.size() != 0 && head->m_inlets[0].m_ties.size() == 1;)
+                    {
+                        head = &head->m_inlets[0].m_ties.begin()->m_pin.m_owner;
+                        
+                        if(!head->m_fused)
+                        {
+                            break;
+                        }
+                        
+                        head->m_step = &step;
+                        step.m_fused_nodes.insert(step.m_fused_nodes.begin(), head);
+                    }
+                    
+                    if(step.m_fused_nodes.empty())
+                    {
+                        for(Node::Pin& inlet : node->m_inlets)
+                        {
+                            step.m_input_pins.push_back(&inlet);
+                        }
+                    }
+                    else
+                    {
+                        std::vector<Node*> run(step.m_fused_nodes);
+                        run.push_back(node.get());
+                        
+                        step.m_input_pins.push_back(&run.front()->m_inlets[0]);
+                        
+                        for(Node* member : run)
+                        {
+                            if(member->m_processor->m_operand == nullptr)
+                            {
+                                step.m_input_pins.push_back(&member->m_inlets[1]);
+                            }
+                        }
+                        
+                        step.m_call_back = std::make_shared<Fusion>(run);
+                    }
+                }
+            }
+            
+            plan->m_thread_pool = m_thread_pool;
+            plan->m_nskipped = &m_nskipped;
+            plan->m_profiling = &m_profiling;
+            plan->m_counting_denormals = &m_counting_denormals;
+            
+            planExecution(*plan);
+            
+            allocateSignals(*plan);
+            
+            planFolds(*plan);
+            
+            return plan;
+        }
+        
+        void Chain::planFolds(Plan& plan) const
+        {
+            // The nodes are sorted so the folds of the sources come first. The folds that no
+            // node reads are not computed.
+            
+            std::unordered_map<Node const*, size_t> refolds;
+            
+            for(auto const& node : m_nodes)
+            {
+                auto read = [](Node::Pin const& outlet)
+                {
+                    return !outlet.m_ties.empty();
+                };
+                
+                if(!node->m_fold || std::none_of(node->m_outlets.begin(), node->m_outlets.end(), read))
+                {
+                    continue;
+                }
+                
+                Fold& fold = *node->m_fold;
+                
+                plan.m_fold_steps.emplace_back(new Step(*node));
+                Step& step = *plan.m_fold_steps.back();
+                step.m_fold = node->m_fold;
+                step.m_inputs.setChannels(fold.m_inputs);
+                step.m_outputs.setChannels(fold.m_outputs);
+                
+                const size_t first_sum = plan.m_fold_sums.size();
+                const size_t first_source = plan.m_fold_sources.size();
+                
+                for(size_t i = 0; i < node->m_inlets.size(); ++i)
+                {
+                    bool first = true;
+                    
+                    for(Node::Tie const& tie : node->m_inlets[i].m_ties)
+                    {
+                        Node const& source = tie.m_pin.m_owner;
+                        
+                        if(!source.m_perform)
+                        {
+                            continue;
+                        }
+                        
+                        plan.m_fold_sources.push_back(refolds.at(&source));
+                        
+                        if(fold.m_sources[i].size() > 1)
+                        {
+                            Signal const& output = *source.m_fold->m_outputs[tie.m_pin.m_index];
+                            plan.m_fold_sums.push_back({output.data(), fold.m_inputs[i]->data(), m_vector_size, first});
+                            first = false;
+                        }
+                    }
+                }
+                
+                refolds[node.get()] = plan.m_refolds.size();
+                
+                plan.m_refolds.push_back({step.m_call_back->getTrampoline(), step.m_call_back.get(),
+                                          &step.m_inputs, &step.m_outputs,
+                                          &fold.m_stale, &node->m_processor->m_invalid, fold.m_silent.get(),
+                                          first_sum, plan.m_fold_sums.size(),
+                                          first_source, plan.m_fold_sources.size(),
+                                          false, typeid(*step.m_processor).name()});
+            }
+        }
+        
+        void Chain::publishPlan(std::unique_ptr<Plan> plan)
+        {
+            if(plan)
+            {
+                for(auto const& step : plan->m_steps)
+                {
+                    ++step->m_node.m_nplans;
+                    
+                    for(Node* node : step->m_fused_nodes)
+                    {
+                        ++node->m_nplans;
+                    }
+                }
+                
+                for(auto const& step : plan->m_fold_steps)
+                {
+                    ++step->m_node.m_nplans;
+                }
+            }
+            
+            m_published_plan.store(plan.get());
+            
+            if(m_plan)
+            {
+                m_retired_plans.push_back(std::move(m_plan));
+            }
+            
+            m_plan = std::move(plan);
+        }
+        
+        void Chain::reclaimPlans(bool wait)
+        {
+            for(auto plan = m_retired_plans.begin(); plan != m_retired_plans.end();)
+            {
+                // a retired plan can't be ticked again, the audio thread may only finish its current tick.
+                while(wait && m_ticked_plan.load() == plan->get())
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                
+                if(m_ticked_plan.load() != plan->get())
+                {
+                    for(auto const& step : (*plan)->m_steps)
+                    {
+                        --step->m_node.m_nplans;
+                        
+                        for(Node* node : step->m_fused_nodes)
+                        {
+                            --node->m_nplans;
+                        }
+                    }
+                    
+                    for(auto const& step : (*plan)->m_fold_steps)
+                    {
+                        --step->m_node.m_nplans;
+                    }
+                    
+                    plan = m_retired_plans.erase(plan);
+                }
+                else
+                {
+                    ++plan;
+                }
+            }
+            
+            for(auto node = m_removed_nodes.begin(); node != m_removed_nodes.end();)
+            {
+                if(!(*node)->isBusy())
+                {
+                    // the processor may have been added again.
+                    if(findNode(*(*node)->m_processor) == m_nodes.end())
+                    {
+                        (*node)->release();
+                    }
+                    
+                    node = m_removed_nodes.erase(node);
+                }
+                else
+                {
+                    ++node;
+                }
+            }
+        }
+        
+        // ============================================================================ //
+        //                                NODE MANGEMENT                                //
+        // ============================================================================ //
+        
+        std::vector<Chain::Node::uPtr>::iterator Chain::findNode(Processor& proc)
+        {
+            auto node = m_processor_nodes.find(&proc);
+            
+            return node != m_processor_nodes.end() ? m_nodes.begin() + node->second->m_index : m_nodes.end();
+        }
+        
+        std::vector<std::unique_ptr<Chain::Node>>::const_iterator Chain::findNode(Processor& proc) const
+        {
+            auto node = m_processor_nodes.find(&proc);
+            
+            return node != m_processor_nodes.end() ? m_nodes.begin() + node->second->m_index : m_nodes.end();
+        }
+        
+        void Chain::sortNodes()
+        {
+            const size_t nnodes = m_nodes.size();
+            
+            // ======================================================================== //
+            //                       BUILD THE FLAT ADJACENCY LIST                      //
+            // ======================================================================== //
+            
+            // The successors of the node i are the indices from offsets[i] to offsets[i + 1].
+            
+            std::vector<size_t> offsets(nnodes + 1, 0ul);
+            std::vector<size_t> successors;
+            std::vector<size_t> npredecessors(nnodes, 0ul);
+            
+            for(size_t i = 0; i < nnodes; ++i)
+            {
+                for(Node::Pin const& outlet : m_nodes[i]->m_outlets)
+                {
+                    for(Node::Tie const& tie : outlet.m_ties)
+                    {
+                        const size_t successor = tie.m_pin.m_owner.m_index;
+                        
+                        successors.push_back(successor);
+                        ++npredecessors[successor];
+                    }
+                }
+                
+                offsets[i + 1] = successors.size();
+            }
+            
+            // ======================================================================== //
+            //                              SORT THE NODES                              //
+            // ======================================================================== //
+            
+            std::vector<size_t> sorted;
+            sorted.reserve(nnodes);
+            
+            for(size_t i = 0; i < nnodes; ++i)
+            {
+                if(npredecessors[i] == 0)
+                {
+                    sorted.push_back(i);
+                }
+            }
+            
+            for(size_t i = 0; i < sorted.size(); ++i)
+            {
+                const size_t node = sorted[i];
+                
+                for(size_t j = offsets[node]; j < offsets[node + 1]; ++j)
+                {
+                    if(--npredecessors[successors[j]] == 0)
+                    {
+                        sorted.push_back(successors[j]);
+                    }
+                }
+            }
+            
+            // the nodes of a loop never lose all their predecessors.
+            if(sorted.size() != nnodes)
+            {
+                throw LoopError("A loop is detected");
+            }
+            
+            std::vector<Node::uPtr> nodes;
+            nodes.reserve(nnodes);
+            
+            for(size_t i = 0; i < nnodes; ++i)
+            {
+                nodes.push_back(std::move(m_nodes[sorted[i]]));
+                nodes.back()->m_index = i;
+            }
+            
+            m_nodes.swap(nodes);
+        }
+        
+        void Chain::reorderNodes(Node& source, Node& dest)
+        {
+            // Only the nodes placed between dest and source can be misplaced,
+            // the nodes reachable from dest are moved after the nodes that reach source.
+            // When an update has visited more nodes than the chain has, sorting them all is cheaper.
+            
+            const size_t lower = dest.m_index;
+            const size_t upper = source.m_index;
+            
+            std::vector<Node*> forward {&dest};
+            std::vector<Node*> backward {&source};
+            std::set<Node*> visited {&dest, &source};
+            
+            for(size_t i = 0; i < forward.size(); ++i)
+            {
+                for(Node::Pin const& outlet : forward[i]->m_outlets)
+                {
+                    for(Node::Tie const& tie : outlet.m_ties)
+                    {
+                        Node& successor = tie.m_pin.m_owner;
+                        
+                        if(&successor == &source)
+                        {
+                            m_sorted = false;
+                            return;
+                        }
+                        
+                        if(successor.m_index < upper && visited.insert(&successor).second)
+                        {
+                            if(++m_reordered_nodes > m_nodes.size())
+                            {
+                                m_sorted = false;
+                                return;
+                            }
+                            
+                            forward.push_back(&successor);
+                        }
+                    }
+                }
+            }
+            
+            for(size_t i = 0; i < backward.size(); ++i)
+            {
+                for(Node::Pin const& inlet : backward[i]->m_inlets)
+                {
+                    for(Node::Tie const& tie : inlet.m_ties)
+                    {
+                        Node& predecessor = tie.m_pin.m_owner;
+                        
+                        if(predecessor.m_index > lower && visited.insert(&predecessor).second)
+                        {
+                            if(++m_reordered_nodes > m_nodes.size())
+                            {
+                                m_sorted = false;
+                                return;
+                            }
+                            
+                            backward.push_back(&predecessor);
+                        }
+                    }
+                }
+            }
+            
+            auto compare_index = [](Node const* l_node, Node const* r_node)
+            {
+                return l_node->m_index < r_node->m_index;
+            };
+            
+            std::sort(forward.begin(), forward.end(), compare_index);
+            std::sort(backward.begin(), backward.end(), compare_index);
+            
+            std::vector<Node*> nodes(backward.begin(), backward.end());
+            nodes.insert(nodes.end(), forward.begin(), forward.end());
+            
+            std::vector<size_t> positions;
+            std::vector<Node::uPtr> moved_nodes;
+            
+            for(Node* node : nodes)
+            {
+                positions.push_back(node->m_index);
+                moved_nodes.push_back(std::move(m_nodes[node->m_index]));
+            }
+            
+            std::sort(positions.begin(), positions.end());
+            
+            for(size_t i = 0; i < positions.size(); ++i)
+            {
+                moved_nodes[i]->m_index = positions[i];
+                m_nodes[positions[i]] = std::move(moved_nodes[i]);
+            }
+        }
+        
+        void Chain::setDirty(Node& node)
+        {
+            if(!node.m_dirty)
+            {
+                node.m_dirty = true;
+                m_dirty_nodes.push_back(&node);
+            }
+        }
+        
+        
+        void Chain::planExecution(Plan& plan) const
+        {
+            // Below this number of steps, the synchronization costs more than the parallelism brings.
+            const size_t min_parallel_steps = 16ul;
+            
+            const size_t nsteps = plan.m_steps.size();
+            
+            if(!m_thread_pool || m_thread_pool->getNumberOfThreads() < 2 || nsteps < min_parallel_steps)
+            {
+                return;
+            }
+            
+            // ======================================================================== //
+            //                      BUILD THE DEPENDENCIES AND LEVELS                   //
+            // ======================================================================== //
+            
+            // The level of a step is the length of the longest path from a root step,
+            // steps of the same level don't depend on each other.
+            
+            std::vector<size_t> levels(nsteps, 0ul);
+            std::vector<size_t> widths(nsteps, 0ul);
+            std::vector<Step*> predecessors;
+            size_t widest = 0ul;
+            
+            for(size_t i = 0; i < nsteps; ++i)
+            {
+                Step& step = *plan.m_steps[i];
+                
+                predecessors.clear();
+                
+                for(Node::Pin const* inlet : step.m_input_pins)
+                {
+                    for(Node::Tie const& tie : inlet->m_ties)
+                    {
+                        if(tie.m_pin.m_owner.m_step != nullptr)
+                        {
+                            predecessors.push_back(tie.m_pin.m_owner.m_step);
+                        }
+                    }
+                }
+                
+                std::sort(predecessors.begin(), predecessors.end());
+                predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+                
+                for(Step* predecessor : predecessors)
+                {
+                    predecessor->m_successors.push_back(&step);
+                    levels[i] = std::max(levels[i], levels[predecessor->m_index] + 1);
+                }
+                
+                step.m_npredecessors = predecessors.size();
+                widest = std::max(widest, ++widths[levels[i]]);
+            }
+            
+            if(widest > 1)
+            {
+                plan.m_parallel_tick.reset(new ParallelTick(plan, m_thread_pool->getNumberOfThreads()));
+            }
+        }
+        
+        // ============================================================================ //
+        //                                NODE MODIFICATIONS                            //
+        // ============================================================================ //
+        
+        void Chain::addProcessor(std::shared_ptr<Processor> processor)
+        {
+            std::function<void(void)> func = std::bind(&Chain::execAddProcessor, this, processor);
+            m_commands.push_back(func);
+        }
+        
+        void Chain::removeProcessor(Processor& proc)
+        {
+            std::function<void(void)> func = std::bind(&Chain::execRemoveProcessor, this, &proc);
+            m_commands.push_back(func);
+        }
+        
+        void Chain::connect(Processor& source, size_t outlet_index,
+                            Processor& dest, size_t inlet_index)
+        {
+            std::function<void(void)> call_back = std::bind(&Chain::execConnect,
+                                                            this,
+                                                            &source, outlet_index,
+                                                            &dest, inlet_index);
+            m_commands.push_back(call_back);
+        }
+        
+        void Chain::disconnect(Processor& source, size_t outlet_index,
+                               Processor& dest, size_t inlet_index)
+        {
+            std::function<void(void)> call_back = std::bind(&Chain::execDisconnect,
+                                                            this,
+                                                            &source, outlet_index,
+                                                            &dest, inlet_index);
+            m_commands.push_back(call_back);
+        }
+        
+        void Chain::setThreadPool(std::shared_ptr<ThreadPool> pool)
+        {
+            std::function<void(void)> func = std::bind(&Chain::execSetThreadPool, this, pool);
+            m_commands.push_back(func);
+        }
+        
+        // ==================================================================================== //
+        //                                      SIGNAL MANAGEMENT                               //
+        // ==================================================================================== //
+        
+        void Chain::allocateSignals(Plan& plan) const
+        {
+            const size_t nsteps = plan.m_steps.size();
+            
+            // Only the ties between the steps of the plan carry signals.
+            
+            auto count_ties = [](Node::Pin const& pin)
+            {
+                return std::count_if(pin.m_ties.begin(), pin.m_ties.end(), [](Node::Tie const& tie)
+                {
+                    return tie.m_pin.m_owner.m_step != nullptr;
+                });
+            };
+            
+            // A slot is an index in the memory block. The unconnected inlets read the zero signal
+            // of the plan and the unconnected outlets of the same index and channels share a slot.
+            
+            const size_t no_slot = static_cast<size_t>(-1);
+            std::map<std::pair<size_t, size_t>, size_t> dump_slots;
+            
+            // A slot holds the channels of its pin one after the other.
+            
+            auto outlet_channels = [](Node::Pin const& outlet)
+            {
+                return outlet.m_owner.m_processor->getNumberOfOutputChannels(outlet.m_index);
+            };
+            
+            auto inlet_channels = [](Node::Pin const& inlet)
+            {
+                std::vector<size_t> const& channels = inlet.m_owner.m_channels;
+                return inlet.m_index < channels.size() ? channels[inlet.m_index] : 1ul;
+            };
+            
+            // An inlet connected to a folded node reads the signal of its fold, there is no other source.
+            
+            auto folded_source = [](Node::Pin const& inlet) -> Node::Pin const*
+            {
+                for(Node::Tie const& tie : inlet.m_ties)
+                {
+                    if(tie.m_pin.m_owner.m_folded)
+                    {
+                        return &tie.m_pin;
+                    }
+                }
+                
+                return nullptr;
+            };
+            
+            size_t nslots = 0ul;
+            std::vector<size_t> slot_channels;
+            std::map<size_t, std::vector<size_t>> free_slots;
+            std::vector<std::vector<size_t>> expired_slots(nsteps);
+            bool zero = false;
+            
+            // Concurrent steps can't share signals, they would write them at the same time.
+            const bool share = plan.m_parallel_tick == nullptr;
+            
+            auto new_slot = [&nslots, &slot_channels](size_t nchannels)
+            {
+                slot_channels.push_back(nchannels);
+                return nslots++;
+            };
+            
+            auto acquire_slot = [&new_slot, &free_slots, share](size_t nchannels)
+            {
+                std::vector<size_t>& slots = free_slots[nchannels];
+                
+                if(!share || slots.empty())
+                {
+                    return new_slot(nchannels);
                 }
                 
-                lock.unlock();
+                const size_t slot = slots.back();
+                slots.pop_back();
+                return slot;
+            };
+            
+            // ======================================================================== //
+            //                        FIND THE FIRST SOURCES OF SUMS                    //
+            // ======================================================================== //
+            
+            // In a serial plan, the sources of a fanning inlet accumulate their signals into the
+            // inlet's signal right after being performed. The first source writes directly in the
+            // inlet's signal if nothing else reads it, otherwise it's copied.
+            
+            std::map<Node::Pin const*, Node::Pin const*> first_sources;
+            std::map<Node::Pin const*, Node::Pin*> aliases;
+            std::vector<std::vector<Node::Pin*>> starting_sums(nsteps);
+            
+            for(size_t i = 0; share && i < nsteps; ++i)
+            {
+                for(Node::Pin* input_pin : plan.m_steps[i]->m_input_pins)
+                {
+                    Node::Pin& inlet = *input_pin;
+                    
+                    if(count_ties(inlet) > 1)
+                    {
+                        Node::Pin const* first_source = nullptr;
+                        
+                        for(Node::Tie const& tie : inlet.m_ties)
+                        {
+                            Node::Pin const& source = tie.m_pin;
+                            
+                            if(source.m_owner.m_step != nullptr
+                               && (first_source == nullptr
+                                   || source.m_owner.m_step->m_index < first_source->m_owner.m_step->m_index
+                                   || (&source.m_owner == &first_source->m_owner
+                                       && source.m_index < first_source->m_index)))
+                            {
+                                first_source = &source;
+                            }
+                        }
+                        
+                        first_sources[&inlet] = first_source;
+                        
+                        if(count_ties(*first_source) == 1 && outlet_channels(*first_source) == inlet_channels(inlet))
+                        {
+                            aliases[first_source] = &inlet;
+                        }
+                        else
+                        {
+                            starting_sums[first_source->m_owner.m_step->m_index].push_back(&inlet);
+                        }
+                    }
+                }
+            }
+            
+            // ======================================================================== //
+            //                        FIND THE SILENCE DETECTORS                        //
+            // ======================================================================== //
+            
+            // The outputs read by the steps that can be skipped are checked for silence after being
+            // performed. Each slot has a silence flag that the fan-ins propagate to the sums.
+            
+            // The silence of the inputs of a fused run doesn't tell whether its output is silent.
+            
+            auto skippable = [](Step const& step)
+            {
+                return step.m_fused_nodes.empty() && step.m_processor->m_skippable.load(std::memory_order_relaxed);
+            };
+            
+            std::set<Node::Pin const*> watched_outlets;
+            
+            for(size_t i = 0; i < nsteps; ++i)
+            {
+                if(skippable(*plan.m_steps[i]))
+                {
+                    for(Node::Pin const* inlet : plan.m_steps[i]->m_input_pins)
+                    {
+                        for(Node::Tie const& tie : inlet->m_ties)
+                        {
+                            if(tie.m_pin.m_owner.m_step != nullptr)
+                            {
+                                watched_outlets.insert(&tie.m_pin);
+                            }
+                        }
+                    }
+                }
             }
-        }
-        
-        // ============================================================================ //
-        //                                NODE MANGEMENT                                //
-        // ============================================================================ //
-        
-        struct Chain::compare_proc
-        {
-            compare_proc(Processor const& proc):m_proc(proc){};
             
-            bool operator()(Node::uPtr const& node)
+            // ======================================================================== //
+            //                      FIND THE SIGNALS WRITTEN IN PLACE                   //
+            // ======================================================================== //
+            
+            // An outlet declared in place takes the signal of its inlet if only the inlet reads it, it
+            // then expires after the outlet's last reader. The fused runs read several inlets.
+            
+            auto in_place_slot = [&count_ties, &outlet_channels, &slot_channels, &expired_slots, no_slot]
+            (Step const& step, Node::Pin const& outlet, std::vector<bool>& bound)
+            {
+                const size_t input = step.m_processor->getInPlaceInput(outlet.m_index);
+                
+                if(!step.m_fused_nodes.empty() || input >= step.m_node.m_inlets.size() || bound[input])
+                {
+                    return no_slot;
+                }
+                
+                Node::Pin const& inlet = step.m_node.m_inlets[input];
+                const size_t nties = count_ties(inlet);
+                size_t slot = no_slot;
+                
+                if(nties == 1)
+                {
+                    auto tie = std::find_if(inlet.m_ties.begin(), inlet.m_ties.end(), [](Node::Tie const& tie)
+                    {
+                        return tie.m_pin.m_owner.m_step != nullptr;
+                    });
+                    
+                    if(count_ties(tie->m_pin) == 1)
+                    {
+                        slot = tie->m_pin.m_slot;
+                    }
+                }
+                else if(nties > 1)
+                {
+                    slot = inlet.m_slot;
+                }
+                
+                std::vector<size_t>& expired = expired_slots[step.m_index];
+                auto expiry = std::find(expired.begin(), expired.end(), slot);
+                
+                if(slot == no_slot || expiry == expired.end() || slot_channels[slot] != outlet_channels(outlet))
+                {
+                    return no_slot;
+                }
+                
+                expired.erase(expiry);
+                bound[input] = true;
+                return slot;
+            };
+            
+            // ======================================================================== //
+            //                    COMPUTE THE LIFETIME OF THE SIGNALS                   //
+            // ======================================================================== //
+            
+            struct Sum
             {
-                return &m_proc == &(*node->m_processor);
+                size_t m_lhs;
+                size_t m_rhs;
+                size_t m_output;
             };
             
-            Processor const& m_proc;
-        };
-        
-        std::vector<Chain::Node::uPtr>::iterator Chain::findNode(Processor& proc)
-        {
-            return std::find_if(m_nodes.begin(), m_nodes.end(), compare_proc(proc));
-        }
-        
-        std::vector<std::unique_ptr<Chain::Node>>::const_iterator Chain::findNode(Processor& proc) const
-        {
-            return std::find_if(m_nodes.begin(), m_nodes.end(), compare_proc(proc));
-        }
-        
-        struct Chain::index_node
-        {
-            index_node(): m_next_index(1ul){};
+            std::vector<std::vector<Sum>> fan_ins(nsteps);
+            std::vector<std::vector<Sum>> accumulations(nsteps);
             
-            void computeIndex(Node& node)
+            for(size_t i = 0; i < nsteps; ++i)
             {
-                if (node.m_index == 0)
+                Node& node = plan.m_steps[i]->m_node;
+                
+                for(Node::Pin* input_pin : plan.m_steps[i]->m_input_pins)
                 {
-                    m_loop_nodes.insert(&node);
+                    Node::Pin& inlet = *input_pin;
+                    const size_t nties = count_ties(inlet);
                     
-                    for(Node::Pin& inlet : node.m_inlets)
+                    if(nties == 0 && folded_source(inlet) == nullptr)
                     {
-                        for(Node::Tie tie : inlet.m_ties)
+                        zero = true;
+                    }
+                    else if(nties > 1 && !share)
+                    {
+                        // the fanning inlet's signal is only used during the step's perform.
+                        inlet.m_slot = acquire_slot(inlet_channels(inlet));
+                        expired_slots[i].push_back(inlet.m_slot);
+                        
+                        size_t lhs = no_slot;
+                        
+                        for(Node::Tie const& tie : inlet.m_ties)
                         {
-                            Node& parent_node = tie.m_pin.m_owner;
-                            
-                            if (!parent_node.m_index)
+                            if(tie.m_pin.m_owner.m_step != nullptr)
                             {
-                                if (m_loop_nodes.find(&parent_node) != m_loop_nodes.end())
+                                if(lhs != no_slot)
                                 {
-                                    throw LoopError("A loop is detected");
+                                    fan_ins[i].push_back({lhs, tie.m_pin.m_slot, inlet.m_slot});
+                                    lhs = inlet.m_slot;
                                 }
                                 else
                                 {
-                                    this->computeIndex(parent_node);
+                                    lhs = tie.m_pin.m_slot;
                                 }
                             }
                         }
                     }
+                }
+                
+                for(Node::Pin* inlet : starting_sums[i])
+                {
+                    // the sum lives from its first source to its reader.
+                    inlet->m_slot = acquire_slot(inlet_channels(*inlet));
+                    expired_slots[inlet->m_owner.m_step->m_index].push_back(inlet->m_slot);
+                }
+                
+                std::vector<bool> bound(node.m_inlets.size(), false);
+                
+                for(Node::Pin& outlet : node.m_outlets)
+                {
+                    const size_t nties = count_ties(outlet);
+                    const size_t nchannels = outlet_channels(outlet);
+                    auto alias = aliases.find(&outlet);
                     
-                    m_loop_nodes.erase(&node);
-                    node.m_index = m_next_index++;
+                    if(nties == 0 && !share)
+                    {
+                        outlet.m_slot = new_slot(nchannels);
+                    }
+                    else if(nties == 0)
+                    {
+                        auto dump_slot = dump_slots.find({outlet.m_index, nchannels});
+                        
+                        if(dump_slot == dump_slots.end())
+                        {
+                            dump_slot = dump_slots.emplace(std::make_pair(outlet.m_index, nchannels),
+                                                           new_slot(nchannels)).first;
+                        }
+                        
+                        outlet.m_slot = dump_slot->second;
+                    }
+                    else if(alias != aliases.end())
+                    {
+                        outlet.m_slot = acquire_slot(nchannels);
+                        alias->second->m_slot = outlet.m_slot;
+                        expired_slots[alias->second->m_owner.m_step->m_index].push_back(outlet.m_slot);
+                    }
+                    else
+                    {
+                        size_t last_reader = i;
+                        
+                        for(Node::Tie const& tie : outlet.m_ties)
+                        {
+                            // the sums are accumulated right after the source.
+                            if(tie.m_pin.m_owner.m_step != nullptr && first_sources.count(&tie.m_pin) == 0)
+                            {
+                                last_reader = std::max(last_reader, tie.m_pin.m_owner.m_step->m_index);
+                            }
+                        }
+                        
+                        outlet.m_slot = in_place_slot(*plan.m_steps[i], outlet, bound);
+                        
+                        if(outlet.m_slot == no_slot)
+                        {
+                            outlet.m_slot = acquire_slot(nchannels);
+                        }
+                        
+                        expired_slots[last_reader].push_back(outlet.m_slot);
+                    }
+                }
+                
+                for(Node::Pin& outlet : node.m_outlets)
+                {
+                    for(Node::Tie const& tie : outlet.m_ties)
+                    {
+                        auto first_source = first_sources.find(&tie.m_pin);
+                        
+                        if(first_source == first_sources.end())
+                        {
+                            continue;
+                        }
+                        
+                        if(first_source->second != &outlet)
+                        {
+                            accumulations[i].push_back({tie.m_pin.m_slot, outlet.m_slot, tie.m_pin.m_slot});
+                        }
+                        else if(aliases.count(&outlet) == 0)
+                        {
+                            accumulations[i].push_back({outlet.m_slot, no_slot, tie.m_pin.m_slot});
+                        }
+                    }
+                }
+                
+                // the signals read for the last time by the step can be reused by the next steps.
+                for(size_t slot : expired_slots[i])
+                {
+                    free_slots[slot_channels[slot]].push_back(slot);
                 }
             }
             
-            void operator()(Node::uPtr const& node)
-            {
-                computeIndex(*node.get());
-            };
+            // ======================================================================== //
+            //                          ALLOCATE THE MEMORY BLOCK                       //
+            // ======================================================================== //
             
-            size_t          m_next_index;
-            std::set<Node*> m_loop_nodes;
-        };
-        
-        void Chain::indexNodes()
-        {
-            for_each(m_nodes.begin(), m_nodes.end(), index_node());
-        }
-        
-        void Chain::sortNodes()
-        {
-            struct compare_index
-            {
-                bool operator()(std::unique_ptr<Node> const& l_node, std::unique_ptr<Node> const& r_node)
-                {
-                    return l_node->m_index < r_node->m_index;
-                };
-            };
+            const size_t stride = ((m_vector_size * sizeof(sample_t) + alignment - 1) / alignment) * alignment;
             
-            std::sort(m_nodes.begin(), m_nodes.end(), compare_index());
-        }
-        
-        // ============================================================================ //
-        //                                NODE MODIFICATIONS                            //
-        // ============================================================================ //
-        
-        void Chain::addProcessor(std::shared_ptr<Processor> processor)
-        {
-            std::function<void(void)> func = std::bind(&Chain::execAddProcessor, this, processor);
-            m_commands.push_back(func);
-        }
-        
-        void Chain::removeProcessor(Processor& proc)
-        {
-            std::function<void(void)> func = std::bind(&Chain::execRemoveProcessor, this, &proc);
-            m_commands.push_back(func);
-        }
-        
-        void Chain::connect(Processor& source, size_t outlet_index,
-                            Processor& dest, size_t inlet_index)
-        {
-            std::function<void(void)> call_back = std::bind(&Chain::execConnect,
-                                                            this,
-                                                            &source, outlet_index,
-                                                            &dest, inlet_index);
-            m_commands.push_back(call_back);
-        }
-        
-        void Chain::disconnect(Processor& source, size_t outlet_index,
-                               Processor& dest, size_t inlet_index)
-        {
-            std::function<void(void)> call_back = std::bind(&Chain::execDisconnect,
-                                                            this,
-                                                            &source, outlet_index,
-                                                            &dest, inlet_index);
-            m_commands.push_back(call_back);
-        }
-        
-        // ==================================================================================== //
-        //                                      SIGNAL MANAGEMENT                               //
-        // ==================================================================================== //
-        
-        std::shared_ptr<Signal> Chain::getSignalIn()
-        {
-            std::shared_ptr<Signal> signal_in = m_signal_in.lock();
+            // the channels of a slot are contiguous, each slot starts on a cache line.
             
-            if (!signal_in)
+            std::vector<size_t> offsets(nslots, 0ul);
+            plan.m_signal_memory_size = 0ul;
+            
+            for(size_t i = 0; i < nslots; ++i)
             {
-                signal_in = std::make_shared<Signal>(m_vector_size);
-                m_signal_in = signal_in;
+                offsets[i] = plan.m_signal_memory_size;
+                plan.m_signal_memory_size += slot_channels[i] == 1 ? stride :
+                ((slot_channels[i] * m_vector_size * sizeof(sample_t) + alignment - 1) / alignment) * alignment;
             }
+            
+            if(nslots && m_vector_size)
+            {
+                plan.m_signal_memory.reset(new char[plan.m_signal_memory_size + alignment]());
                 
-            return signal_in;
-        }
-        
-        std::shared_ptr<Signal> Chain::getSignalInlet(size_t inlet_index)
-        {
-            std::shared_ptr<Signal> signal_inlet = m_signal_inlet[inlet_index].lock();
+                char* memory = plan.m_signal_memory.get();
+                memory += (alignment - reinterpret_cast<uintptr_t>(memory) % alignment) % alignment;
+                
+                plan.m_signals.reserve(nslots);
+                
+                for(size_t i = 0; i < nslots; ++i)
+                {
+                    sample_t* samples = reinterpret_cast<sample_t*>(memory + offsets[i]);
+                    plan.m_signals.emplace_back(std::make_shared<Signal>(samples, slot_channels[i] * m_vector_size));
+                }
+            }
             
-            if (!signal_inlet)
+            if(zero && m_vector_size)
             {
-                signal_inlet = std::make_shared<Signal>(m_vector_size);
-                m_signal_inlet[inlet_index] = signal_inlet;
+                plan.m_zero = Signal::createZero(m_vector_size);
             }
             
-            return signal_inlet;
-        }
-        
-        std::shared_ptr<Signal> Chain::getSignalOutlet(size_t outlet_index)
-        {
-            std::shared_ptr<Signal> signal_outlet = m_signal_outlet[outlet_index].lock();
+            plan.m_silent_flags.reset(new bool[nslots]());
+            
+            // ======================================================================== //
+            //                              BIND THE SIGNALS                            //
+            // ======================================================================== //
+            
+            plan.m_add = Kernels::get().add;
+            plan.m_copy = Kernels::get().copy;
+            plan.m_abs_max = Kernels::get().absMax;
+            plan.m_fill = Kernels::get().fill;
+            plan.m_vector_size = m_vector_size;
+            plan.m_records.reserve(nsteps);
+            plan.m_silences.reserve(nsteps);
             
-            if (!signal_outlet)
+            bool* const flags = plan.m_silent_flags.get();
+            
+            auto add_sums = [&plan, flags, no_slot](std::vector<Sum> const& sums)
             {
-                signal_outlet = std::make_shared<Signal>(m_vector_size);
-                m_signal_outlet[outlet_index] = signal_outlet;
-            }
+                for(Sum const& sum : sums)
+                {
+                    const bool copy = sum.m_rhs == no_slot;
+                    
+                    plan.m_fan_ins.push_back({plan.m_signals[sum.m_lhs]->data(),
+                                              !copy ? plan.m_signals[sum.m_rhs]->data() : nullptr,
+                                              plan.m_signals[sum.m_output]->data(),
+                                              flags + sum.m_lhs,
+                                              !copy ? flags + sum.m_rhs : nullptr,
+                                              flags + sum.m_output,
+                                              plan.m_signals[sum.m_lhs]->size(),
+                                              !copy ? plan.m_signals[sum.m_rhs]->size() : 0ul,
+                                              plan.m_signals[sum.m_output]->size()});
+                }
+            };
             
-            return signal_outlet;
+            for(size_t i = 0; i < nsteps; ++i)
+            {
+                Step& step = *plan.m_steps[i];
+                const size_t first_fan_in = plan.m_fan_ins.size();
+                size_t first_accumulation = first_fan_in;
+                const size_t first_detector = plan.m_detectors.size();
+                Plan::Silence* silence = nullptr;
+                
+                if(m_vector_size)
+                {
+                    std::vector<Signal::sPtr> inputs;
+                    
+                    for(Node::Pin const* input_pin : step.m_input_pins)
+                    {
+                        Node::Pin const& inlet = *input_pin;
+                        const size_t nties = count_ties(inlet);
+                        
+                        if(nties == 0)
+                        {
+                            Node::Pin const* source = folded_source(inlet);
+                            inputs.push_back(source != nullptr ? source->m_owner.m_fold->m_outputs[source->m_index]
+                                                               : plan.m_zero);
+                        }
+                        else if(nties == 1)
+                        {
+                            auto tie = std::find_if(inlet.m_ties.begin(), inlet.m_ties.end(), [](Node::Tie const& tie)
+                            {
+                                return tie.m_pin.m_owner.m_step != nullptr;
+                            });
+                            
+                            inputs.push_back(plan.m_signals[tie->m_pin.m_slot]);
+                        }
+                        else
+                        {
+                            inputs.push_back(plan.m_signals[inlet.m_slot]);
+                        }
+                    }
+                    
+                    step.m_inputs.setChannels(inputs, m_vector_size);
+                    
+                    std::vector<Signal::sPtr> outputs;
+                    
+                    for(Node::Pin const& outlet : step.m_node.m_outlets)
+                    {
+                        outputs.push_back(plan.m_signals[outlet.m_slot]);
+                    }
+                    
+                    step.m_outputs.setChannels(outputs, m_vector_size);
+                    
+                    for(Node::Pin const& outlet : step.m_node.m_outlets)
+                    {
+                        if(watched_outlets.count(&outlet) != 0)
+                        {
+                            Signal const& signal = *plan.m_signals[outlet.m_slot];
+                            plan.m_detectors.push_back({signal.data(), flags + outlet.m_slot, signal.size()});
+                        }
+                    }
+                    
+                    Processor const& processor = *step.m_processor;
+                    
+                    if(skippable(step))
+                    {
+                        // the disconnected inputs are ignored.
+                        const size_t first_input = plan.m_silent_inputs.size();
+                        
+                        for(Node::Pin const* input_pin : step.m_input_pins)
+                        {
+                            Node::Pin const& inlet = *input_pin;
+                            const size_t nties = count_ties(inlet);
+                            
+                            if(nties == 0)
+                            {
+                                Node::Pin const* source = folded_source(inlet);
+                                
+                                // the audio thread updates the silence of a fold when it computes it.
+                                if(source != nullptr)
+                                {
+                                    plan.m_silent_inputs.push_back(source->m_owner.m_fold->m_silent.get() + source->m_index);
+                                }
+                            }
+                            else if(nties == 1)
+                            {
+                                auto tie = std::find_if(inlet.m_ties.begin(), inlet.m_ties.end(), [](Node::Tie const& tie)
+                                {
+                                    return tie.m_pin.m_owner.m_step != nullptr;
+                                });
+                                
+                                plan.m_silent_inputs.push_back(flags + tie->m_pin.m_slot);
+                            }
+                            else
+                            {
+                                plan.m_silent_inputs.push_back(flags + inlet.m_slot);
+                            }
+                        }
+                        
+                        plan.m_silences.push_back({&processor.m_tail, &processor.m_tail_any,
+                                                   first_input, plan.m_silent_inputs.size(),
+                                                   processor.getTail(), 0ul});
+                        silence = &plan.m_silences.back();
+                    }
+                    
+                    add_sums(fan_ins[i]);
+                    first_accumulation = plan.m_fan_ins.size();
+                    add_sums(accumulations[i]);
+                }
+                
+                plan.m_records.push_back({step.m_call_back->getTrampoline(), step.m_call_back.get(),
+                                          &step.m_inputs, &step.m_outputs,
+                                          first_fan_in, first_accumulation, plan.m_fan_ins.size(),
+                                          first_detector, plan.m_detectors.size(), silence,
+                                          &step.m_node.m_meter, step.m_node.m_denormals.get(),
+                                          typeid(*step.m_processor).name()});
+            }
         }
         
         // ==================================================================================== //
         //                                      CHAIN COMMANDS                                  //
         // ==================================================================================== //
         
+        void Chain::execSetThreadPool(std::shared_ptr<ThreadPool> pool)
+        {
+            m_thread_pool = pool;
+        }
+        
         void Chain::execAddProcessor(std::shared_ptr<Processor> proc)
         {
             if (findNode(*proc) == m_nodes.end())
             {
+                // a node without connections can be placed anywhere.
                 m_nodes.emplace_back(Node::uPtr(new Node(proc)));
+                m_nodes.back()->m_index = m_nodes.size() - 1;
+                m_processor_nodes[proc.get()] = m_nodes.back().get();
+                setDirty(*m_nodes.back());
             }
             else
             {
@@ -666,14 +2481,46 @@ namespace kiwi
             
             if (node != m_nodes.end())
             {
-                m_nodes.erase(findNode(*proc));
+                // the node is kept until the audio thread doesn't perform it anymore.
+                for(Node::Pin& inlet : (*node)->m_inlets)
+                {
+                    for(Node::Tie const& tie : inlet.m_ties)
+                    {
+                        setDirty(tie.m_pin.m_owner);
+                    }
+                    
+                    inlet.disconnect();
+                }
+                
+                for(Node::Pin& outlet : (*node)->m_outlets)
+                {
+                    for(Node::Tie const& tie : outlet.m_ties)
+                    {
+                        setDirty(tie.m_pin.m_owner);
+                    }
+                    
+                    outlet.disconnect();
+                }
+                
+                if((*node)->m_dirty)
+                {
+                    (*node)->m_dirty = false;
+                    m_dirty_nodes.erase(std::find(m_dirty_nodes.begin(), m_dirty_nodes.end(), node->get()));
+                }
+                
+                m_processor_nodes.erase(proc);
+                m_removed_nodes.push_back(std::move(*node));
+                
+                for(auto next = m_nodes.erase(node); next != m_nodes.end(); ++next)
+                {
+                    --(*next)->m_index;
+                }
             }
             else
             {
                 throw Error("Removing non existing processor");
             }
         }
-        
         void Chain::execConnect(Processor* source, size_t outlet_index,
                                 Processor* dest, size_t inlet_index)
         {
@@ -682,7 +2529,15 @@ namespace kiwi
             
             if (source_node != m_nodes.end() && dest_node != m_nodes.end())
             {
-                (*dest_node)->connectInput(inlet_index, **source_node, outlet_index);
+                if((*dest_node)->connectInput(inlet_index, **source_node, outlet_index))
+                {
+                    setDirty(**dest_node);
+                    
+                    if(m_sorted && (*source_node)->m_index >= (*dest_node)->m_index)
+                    {
+                        reorderNodes(**source_node, **dest_node);
+                    }
+                }
             }
             else
             {
@@ -698,7 +2553,12 @@ namespace kiwi
             
             if (source_node != m_nodes.end() && dest_node != m_nodes.end())
             {
-                (*dest_node)->disconnectInput(inlet_index, **source_node, outlet_index);
+                if((*dest_node)->disconnectInput(inlet_index, **source_node, outlet_index))
+                {
+                    // the source may be folded once it has one reader less.
+                    setDirty(**dest_node);
+                    setDirty(**source_node);
+                }
             }
             else
             {
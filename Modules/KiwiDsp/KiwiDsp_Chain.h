@@ -22,9 +22,17 @@
 #pragma once
 
 #include <map>
+#include <array>
+#include <unordered_map>
 #include <queue>
+#include <functional>
+#include <chrono>
 
 #include "KiwiDsp_Processor.h"
+#include "KiwiDsp_Kernels.h"
+#include "KiwiDsp_ThreadPool.h"
+#include "KiwiDsp_RealTime.h"
+#include "KiwiDsp_Denormals.h"
 #include "KiwiDsp_Misc.h"
 
 namespace kiwi
@@ -41,9 +49,26 @@ namespace kiwi
         //! function ready to be called in a separate thread.
         //! The chain is transactional that's to say that changes will not be effective
         //! until either prepare or update is called.
+        //! Updating compiles the graph into an immutable plan that is published to the audio thread
+        //! with an atomic swap so ticking never waits for the updates and never allocates.
+        //! The chain can tick its independent nodes concurrently on the threads of a ThreadPool.
         
         class Chain final
         {
+        public: // classes
+            
+            //! @brief The time spent performing a processor over a window of ticks.
+            //! @details The 99th percentile is read from a histogram with four buckets per octave,
+            //! it's the upper bound of its bucket, at most 19% above the exact value.
+            struct Profile
+            {
+                size_t                      performs;
+                std::chrono::nanoseconds    min;
+                std::chrono::nanoseconds    average;
+                std::chrono::nanoseconds    max;
+                std::chrono::nanoseconds    p99;
+            };
+            
         public: // methods
             
             //! @brief The default constructor.
@@ -63,7 +88,12 @@ namespace kiwi
             //! @details As the chain is transactional changes are not effective immediatly. Changes are stored in
             //! a command stack that update will unstack and execute. Updating the chain will keep in it's previous
             //! state that it's to say that is the chain was prepared it will keep it that way. Update can be called
-            //! concurrently with tick.
+            //! concurrently with tick. Only the nodes affected by the changes are moved in the execution order
+            //! and only the processors whose inputs changed are prepared again, the others aren't released and
+            //! keep their state. The audio thread keeps ticking the previous plan until the new one is published. The
+            //! processors whose inputs change are prepared again once the audio thread has left the plans that perform them,
+            //! in the meantime they keep performing their previous step when their channels didn't change. They are only
+            //! skipped if a tick starts while they are being prepared.
             void update();
             
             //! @brief Allocates memory needed for chain execution.
@@ -77,7 +107,7 @@ namespace kiwi
             //! @brief Deallocate memory needed to perform tick method.
             //! @details Will call release on every processor and will deallocate signal memory.
             //! As release might throw it shal be called before chain destructor. Calling release
-            //! will disable chain tick.
+            //! will disable chain tick. Release waits for the audio thread to leave the current tick.
             //! @exception Error
             void release();
             
@@ -89,6 +119,86 @@ namespace kiwi
             //! @see getSampleRate
             size_t getVectorSize() const noexcept;
             
+            //! @brief Gets the number of signals allocated by the prepared chain.
+            //! @details Signals are reused by the nodes whose lifetimes don't overlap so the number
+            //! of signals is usually much smaller than the number of connected outlets.
+            //! @see getSignalMemorySize
+            size_t getNumberOfSignals() const noexcept;
+            
+            //! @brief Gets the size in bytes of the memory block that holds the signals.
+            //! @see getNumberOfSignals
+            size_t getSignalMemorySize() const noexcept;
+            
+            //! @brief Gets the number of processors prepared by the last update or prepare.
+            //! @details An update only prepares the processors affected by the changes.
+            //! @see getPrepareTime
+            size_t getNumberOfPreparedProcessors() const noexcept;
+            
+            //! @brief Gets the time spent preparing the processors during the last update or prepare.
+            //! @see getNumberOfPreparedProcessors
+            std::chrono::nanoseconds getPrepareTime() const noexcept;
+            
+            //! @brief Gets the number of processors that the last update or prepare folded.
+            //! @details The pure processors whose inputs are constant are only performed again when they are
+            //! invalidated, the folded ones are then no longer performed by the ticks.
+            //! @see Processor::setPure, Processor::invalidate
+            size_t getNumberOfFoldedProcessors() const noexcept;
+            
+            //! @brief Gets the number of times a processor has been skipped since the chain was prepared.
+            //! @details A processor is skipped when its connected inputs have been silent for longer than
+            //! its tail, its outputs are then filled with zeros. The count can be read while the chain ticks.
+            //! @see Processor::setTail
+            size_t getNumberOfSkippedPerforms() const noexcept;
+            
+            //! @brief Enables or disables the profiling of the processors.
+            //! @details While profiling, the ticks measure the time spent performing each processor. Enabling
+            //! the profiling starts a new window for every processor. It's effective from the next tick and can
+            //! be changed while the chain ticks. When disabled, the ticks only check it once.
+            //! @see collectProfile
+            void setProfiling(bool enabled) noexcept;
+            
+            //! @brief Returns true if the processors are profiled.
+            //! @see setProfiling
+            bool isProfiling() const noexcept;
+            
+            //! @brief Gets the profile of a processor since the previous collect and starts a new window.
+            //! @details The time of a run of fused processors is measured as a whole and counted by the last
+            //! processor of the run, the other ones and the folded processors are not performed. It includes
+            //! the summing of the fanning inlets. The profile of a processor that is not in the chain is empty.
+            //! It can be collected while the chain ticks.
+            //! @see setProfiling
+            Profile collectProfile(Processor const& processor);
+            
+            //! @brief Enables or disables the counting of the subnormal samples of the processors.
+            //! @details While counting, the ticks inspect the outputs of each processor after it has been
+            //! performed to find the processors that produce subnormal samples. The samples flushed to zero
+            //! are not counted. Enabling the counting resets the counters. It's effective from the next tick
+            //! and can be changed while the chain ticks.
+            //! @see collectDenormals, Denormals
+            void setCountingDenormals(bool enabled) noexcept;
+            
+            //! @brief Returns true if the subnormal samples are counted.
+            //! @see setCountingDenormals
+            bool isCountingDenormals() const noexcept;
+            
+            //! @brief Gets the number of subnormal samples of each output of a processor since the previous collect.
+            //! @details The outputs of a run of fused processors are counted by the last processor of the run.
+            //! The counts of a processor that is not in the chain are empty. It can be collected while the chain ticks.
+            //! @see setCountingDenormals
+            std::vector<size_t> collectDenormals(Processor const& processor);
+            
+            //! @brief Sets the thread pool used to tick the chain.
+            //! @details Nodes that don't depend on each other will then be performed concurrently
+            //! so the processors must not share unprotected states. Small chains and chains without
+            //! independent nodes are still ticked serially on the calling thread. A null pool makes the
+            //! chain serial. As the other changes, it becomes effective at update or prepare time.
+            //! @see isParallel
+            void setThreadPool(std::shared_ptr<ThreadPool> pool);
+            
+            //! @brief Returns true if the prepared chain ticks its nodes on several threads.
+            //! @see setThreadPool
+            bool isParallel() const noexcept;
+            
             //! @brief Adds a processor to the chain.
             //! @details Ownership is shared between caller and chain. The caller might
             //! keep a reference to the processor and update it. Calling addProcessor will add a command
@@ -118,7 +228,10 @@ namespace kiwi
             //! @brief Ticks once all the Processor objects. Not recursive.
             //! @details Call iteratively all the node on their perform method.
             //! if the chain is not prepared the tick will result in doing nothing.
-            //! Prepare, release, updates can be made concurrently to tick.
+            //! Prepare, release, updates can be made concurrently to tick. Tick is lock-free and
+            //! shall be called by a single thread at a time. The threads that perform the nodes flush
+            //! the subnormal samples to zero if the engine-wide mode is enabled.
+            //! @see Denormals::setFlushing
             void tick() noexcept;
             
         private: // classes
@@ -133,34 +246,82 @@ namespace kiwi
             };
             
             class Node;
+            class Step;
+            class Plan;
+            class Fusion;
+            class Fold;
+            class ParallelTick;
+            class Meter;
             
         private: // methods
             
-            //! @brief Functor called by indexNodes to index a node.
-            //! @details To avoid too many recursion on the graph, index_node will also
-            //! detect loops.
-            struct index_node;
-            
-            //! @brief Funtor that checks if the node countains the processor
-            //! @detail Used to retrieve the node that have a certain processor in findNode;
-            struct compare_proc;
-            
             //! @brief Returns an iterator to the object having processor proc.
+            //! @details The nodes are hashed by processor and the index of a node is its position.
             std::vector<std::unique_ptr<Node>>::iterator findNode(Processor& proc);
             
             //! @brief Returns an const iterator to the object having node_id.
             std::vector<std::unique_ptr<Node>>::const_iterator findNode(Processor& proc) const;
             
-            //! @brief Attributes an index to the node before sorting by index.
-            //! @details Indexing guarantees that every node will have a greater index than
-            //! than all its parent node. Called during prepare.
-            void indexNodes();
-            
-            //! @brief Sorts all node by index before computing.
-            //! @details Sorting node will guarantee that all parent node will be executed
-            //! before a chil node execution.
+            //! @brief Sorts all the nodes so that every node is placed after its parent nodes.
+            //! @details Iterative Kahn sort over a flat adjacency list built from the ties, linear in the
+            //! number of nodes and ties. The index of a node is then its position. Called during compile
+            //! if the order has been lost. If the nodes contain a loop, they are left unchanged and
+            //! LoopError is thrown.
             void sortNodes();
             
+            //! @brief Restores the order of the nodes after connecting source to dest.
+            //! @details Only the nodes between dest and source that depend on them are moved.
+            //! If the connection creates a loop, the order is lost and the next compile throws. If the
+            //! reorderings of an update visit more nodes than the chain has, the order is left to sortNodes.
+            void reorderNodes(Node& source, Node& dest);
+            
+            //! @brief Marks a node whose processor may have to be prepared again.
+            void setDirty(Node& node);
+            
+            //! @brief Prepares the dirty nodes whose inputs changed and publishes the plan.
+            //! @details The dirty nodes are prepared in order and their successors become dirty if they
+            //! start or stop performing. The nodes performed by a plan in use are not prepared: a plan without them is
+            //! published first and they are prepared once the audio thread has left the previous plans.
+            //! If the graph contains a loop the previous plan is kept and the LoopError is thrown.
+            void compile();
+            
+            //! @brief Finds the constant nodes among the dirty nodes and their successors.
+            //! @details A pure node is constant if its connected inputs all come from constant nodes. Its
+            //! outputs are held by a fold that the plans share, kept while the node isn't prepared again and
+            //! reads the same signals. Only the given nodes and the successors of the nodes whose fold changed
+            //! are visited. A constant node is folded, and left out of the plans, if it's the only connected
+            //! source of the inlets it's connected to.
+            void foldNodes(std::vector<Node*> nodes);
+            
+            //! @brief Creates a plan with the performing nodes that are not busy nor folded.
+            //! @details Fuses the runs of elementwise nodes, builds the dependencies between the steps,
+            //! chooses how to tick them, allocates their signals and binds the folds that they read.
+            std::unique_ptr<Plan> createPlan() const;
+            
+            //! @brief Binds the folds of the constant nodes that are read to the plan.
+            //! @details The folds are computed again by the audio thread, in order, when they are new or
+            //! their processor has been invalidated.
+            void planFolds(Plan& plan) const;
+            
+            //! @brief Marks the elementwise nodes performed by the step of the node they feed.
+            //! @details An elementwise node is fused if its output is only read by the first input of
+            //! another elementwise node. The last node of a run performs all of them in a single pass.
+            //! @see Processor::setElementwise
+            void fuseNodes() const;
+            
+            //! @brief Builds the dependencies between the steps of the plan and chooses how to tick them.
+            //! @details The plan is ticked in parallel if the chain has a thread pool, enough steps and
+            //! at least two steps that don't depend on each other.
+            void planExecution(Plan& plan) const;
+            
+            //! @brief Publishes a plan to the audio thread and retires the previous one.
+            void publishPlan(std::unique_ptr<Plan> plan);
+            
+            //! @brief Deletes the retired plans that the audio thread doesn't use anymore.
+            //! @details Releases and deletes the removed nodes that are not performed by a plan anymore.
+            //! If wait is true, waits for the audio thread to leave the retired plans.
+            void reclaimPlans(bool wait);
+            
         private: // commands
             
             //! @brief The command that will making adding a processor effective.
@@ -177,39 +338,89 @@ namespace kiwi
             void execDisconnect(Processor* source, size_t outlet_index,
                                 Processor* dest, size_t inlet_index);
             
-            //! @brief Puts back a node in to the commands' list in order to add it again.
-            //! @details If a nodes processor doesn't require compuration, for optimization concern,
-            //! we remove it from the chain but it back into the command list. If the node status changes afterward
-            //! the chain may be able to reinsert it into the chain.
-            void restackNode(Node & node);
-            
-            //! @brief Returns a allocated signal for disconnected inlets
-            //! @details Since disconnected inlet never modify their signal they can share the same signal.
-            //! @details The first disconnected inlet to ask this will cause it's allocation.
-            std::shared_ptr<Signal> getSignalIn();
-            
-            //! @brief Returns a allocated signal for disconnected outlets.
-            //! @details Since disconnected outlets signals are never used after they're computed and never read,
-            //! @details we can optimize and feed them the same signal.
-            std::shared_ptr<Signal> getSignalOutlet(size_t outlet_index);
-            
-            //! @brief Returns an allocated signal for fanning inlets.
-            //! @details Since fanning inlets always copy their parent node signal before computing.
-            //! @details we can optimize and feed them the same buffer which will be overwritten before node computation.
-            std::shared_ptr<Signal> getSignalInlet(size_t inlet_index);
+            //! @brief The command that will making setting the thread pool effective.
+            void execSetThreadPool(std::shared_ptr<ThreadPool> pool);
+            
+            //! @brief Allocates the signals of a plan and binds them to the steps.
+            //! @details The lifetime of each connected outlet goes from its step to its last
+            //! reader in the steps. Outlets and fanning inlets whose lifetimes don't overlap
+            //! share the same signal. Disconnected inlets share a read-only zero signal, inlets
+            //! connected to a folded node read the signal of its fold and disconnected outlets of the same index share a signal that is never read.
+            //! In a serial plan, the sources of a fanning inlet accumulate into the inlet's signal
+            //! right after being performed and the first one writes directly into it when possible.
+            //! An outlet declared in place takes the signal of its inlet when its step is the last and
+            //! only reader of the signal, serial or parallel. All the signals are laid out in a single memory block aligned on cache lines.
+            //! If the plan is ticked in parallel, the signals aren't shared nor reused. Each signal has a
+            //! silence flag, set by the outputs read by the steps that can be skipped and summed by the fan-ins,
+            //! the outputs of the folds have their own flags.
+            void allocateSignals(Plan& plan) const;
             
         private: // members
             
             std::vector<std::unique_ptr<Node>>          m_nodes;
+            std::unordered_map<Processor const*, Node*> m_processor_nodes;
             size_t                                      m_sample_rate;
             size_t                                      m_vector_size;
             State                                       m_state;
             std::deque<std::function<void(void)>>       m_commands;
-            std::mutex                                  m_tick_mutex;
+            std::shared_ptr<ThreadPool>                 m_thread_pool;
+            
+            std::unique_ptr<Plan>                       m_plan;
+            std::vector<std::unique_ptr<Plan>>          m_retired_plans;
+            std::vector<std::unique_ptr<Node>>          m_removed_nodes;
+            std::vector<Node*>                          m_dirty_nodes;
+            bool                                        m_sorted;
+            size_t                                      m_reordered_nodes;
+            size_t                                      m_nprepared;
+            std::chrono::nanoseconds                    m_prepare_time;
+            mutable std::atomic<size_t>                 m_nskipped;
+            std::atomic<bool>                           m_profiling;
+            std::atomic<bool>                           m_counting_denormals;
+            std::atomic<Plan*>                          m_published_plan;
+            std::atomic<Plan*>                          m_ticked_plan;
+        };
+        
+        // ================================================================================ //
+        //                                      METER                                       //
+        // ================================================================================ //
+        
+        //! @brief Accumulates the times spent performing a node.
+        //! @details A single thread adds the times while another one collects them, all the accumulators
+        //! are atomics so neither waits for the other. The histogram has four buckets per octave of
+        //! nanoseconds and the longer times are counted in the last bucket.
+        class Chain::Meter final
+        {
+        public: // methods
             
-            std::weak_ptr<Signal>                       m_signal_in;
-            std::map<size_t, std::weak_ptr<Signal>>     m_signal_outlet;
-            std::map<size_t, std::weak_ptr<Signal>>     m_signal_inlet;
+            //! @brief Constructor.
+            Meter() noexcept;
+            
+            //! @brief Destructor.
+            ~Meter() = default;
+            
+            //! @brief Adds the time of a perform.
+            void add(std::chrono::nanoseconds time) noexcept;
+            
+            //! @brief Gets the profile of the times added since the previous collect and resets them.
+            Profile collect() noexcept;
+            
+        private: // methods
+            
+            //! @brief Returns the bucket of a time in nanoseconds.
+            static size_t getBucket(uint64_t time) noexcept;
+            
+            //! @brief Returns the longest time of a bucket in nanoseconds.
+            static uint64_t getBucketMax(size_t bucket) noexcept;
+            
+        private: // members
+            
+            static constexpr size_t nbuckets = 128ul;
+            
+            std::atomic<uint64_t>                       m_performs;
+            std::atomic<uint64_t>                       m_sum;
+            std::atomic<uint64_t>                       m_min;
+            std::atomic<uint64_t>                       m_max;
+            std::array<std::atomic<uint32_t>, nbuckets> m_buckets;
         };
         
         // ================================================================================ //
@@ -218,8 +429,8 @@ namespace kiwi
         
         //! @brief The Node object wraps and manages a Processor object inside a Chain object.
         //! @details The node can be connected to other node and enables signal data
-        //! to go through its pins (inlet, outlet). Node also manages its signal allocation via
-        //! its prepare and release method.
+        //! to go through its pins (inlet, outlet). Node also manages the preparation of its processor
+        //! that plans' steps then perform.
         class Chain::Node final
         {
         public: // typedefs
@@ -242,13 +453,29 @@ namespace kiwi
             //! @details Returns true existed and was effectively removed.
             bool disconnectInput(const size_t input_index, Node& other_node, const size_t output_index);
             
+            //! @brief Gets the status of the inputs.
+            //! @details An input is connected if it's tied to a performing node.
+            std::vector<bool> getInputStatus() const;
+            
+            //! @brief Gets the connected inputs that hold the same value over a vector.
+            //! @details An input is scalar if all the performing nodes it's tied to declared a scalar output.
+            std::vector<bool> getScalarStatus() const;
+            
+            //! @brief Gets the number of channels of the inputs.
+            //! @details An input has as many channels as the widest performing node it's tied to.
+            std::vector<size_t> getChannelStatus() const;
+            
             //! @brief Prepare the Node object.
-            //! @details Allocates and bind its memory before its computation. Call its processor prepare method.
-            bool prepare(Chain& chain);
+            //! @details Calls its processor prepare method if the node isn't prepared or if the inputs changed.
+            //! @return Returns true if the processor has been prepared.
+            bool prepare(Chain const& chain, std::vector<bool> const& inputs,
+                         std::vector<bool> const& scalars, std::vector<size_t> const& channels);
             
-            //! @brief The digital signal processing perform method.
-            //! @details Feeds the processor a buffer of sample to be processed.
-            void perform() noexcept;
+            //! @brief Returns true if an input or an output of the prepared node has several channels.
+            bool isMultichannel() const noexcept;
+            
+            //! @brief Returns true if a plan in use performs the node.
+            bool isBusy() const noexcept;
             
             //! @brief Releases the node disabling performing it.
             void release();
@@ -263,10 +490,22 @@ namespace kiwi
             std::shared_ptr<Processor>                  m_processor;
             std::vector<Pin>                            m_inlets;
             std::vector<Pin>                            m_outlets;
-            Buffer                                      m_inputs;
-            Buffer                                      m_outputs;
-            std::vector<Buffer>                         m_buffer_copy;
             size_t                                      m_index;
+            bool                                        m_prepared;
+            size_t                                      m_preparations;
+            bool                                        m_perform;
+            bool                                        m_dirty;
+            bool                                        m_stale;
+            std::vector<bool>                           m_inputs;
+            std::vector<bool>                           m_scalars;
+            std::vector<size_t>                         m_channels;
+            size_t                                      m_nplans;
+            Step*                                       m_step;
+            std::shared_ptr<Fold>                       m_fold;
+            bool                                        m_folded;
+            bool                                        m_fused;
+            Meter                                       m_meter;
+            std::unique_ptr<std::atomic<size_t>[]>      m_denormals;
             
         private: // deleted methods
             
@@ -278,6 +517,390 @@ namespace kiwi
             friend class Chain;
         };
         
+        // ================================================================================ //
+        //                                      STEP                                        //
+        // ================================================================================ //
+        
+        //! @brief A step of a plan performs a node's processor with the signals of the plan.
+        //! @details The step holds the processor, the callback prepared for the plan and the buffers
+        //! that the plan's record points to so that preparing the processor again doesn't affect the
+        //! plans in use. The step of a run of fused nodes reads the inputs of all of them and its
+        //! callback is a Fusion. The step of a fold computes the constant outputs of its node.
+        class Chain::Step final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            Step(Node& node);
+            
+            //! @brief Destructor.
+            ~Step() = default;
+            
+        public: // members
+            
+            Node&                                       m_node;
+            std::vector<Node*>                          m_fused_nodes;
+            std::vector<Node::Pin*>                     m_input_pins;
+            std::shared_ptr<Processor>                  m_processor;
+            std::shared_ptr<IPerformCallBack>           m_call_back;
+            std::shared_ptr<Fold>                       m_fold;
+            Buffer                                      m_inputs;
+            Buffer                                      m_outputs;
+            size_t                                      m_index;
+            std::vector<Step*>                          m_successors;
+            size_t                                      m_npredecessors;
+            std::atomic<size_t>                         m_pending;
+            
+        private: // deleted methods
+            
+            Step(Step const& other) = delete;
+            Step& operator=(Step const& other) = delete;
+        };
+        
+        // ================================================================================ //
+        //                                      PLAN                                        //
+        // ================================================================================ //
+        
+        //! @brief An immutable list of steps ticked by the audio thread.
+        //! @details The plan owns the memory of its signals so that the audio thread can keep ticking
+        //! it while the next plan is compiled. The steps are flattened into a contiguous array of records
+        //! that the audio thread performs without virtual calls.
+        class Chain::Plan final
+        {
+        public: // classes
+            
+            //! @brief Adds a signal to another one to sum a fanning inlet.
+            //! @details If there is no rhs, lhs is copied. The sum is silent if both signals are silent.
+            //! The sizes differ if the signals don't have the same number of channels, the output is
+            //! then the widest and the channels that are missing in both operands are zeros.
+            struct FanIn
+            {
+                sample_t const*                 m_lhs;
+                sample_t const*                 m_rhs;
+                sample_t*                       m_output;
+                bool const*                     m_lhs_silent;
+                bool const*                     m_rhs_silent;
+                bool*                           m_output_silent;
+                size_t                          m_lhs_size;
+                size_t                          m_rhs_size;
+                size_t                          m_size;
+            };
+            
+            //! @brief Checks whether an output read by a skippable step is silent.
+            struct Detector
+            {
+                sample_t const*                 m_signal;
+                bool*                           m_silent;
+                size_t                          m_size;
+            };
+            
+            //! @brief The silence state of a step whose processor declared a tail.
+            //! @details The flags of the connected inputs range from m_first_input to m_last_input in the
+            //! plan and m_samples counts the samples since they are silent.
+            struct Silence
+            {
+                std::atomic<size_t> const*      m_tail;
+                std::atomic<bool> const*        m_any;
+                size_t                          m_first_input;
+                size_t                          m_last_input;
+                size_t                          m_last_tail;
+                size_t                          m_samples;
+            };
+            
+            //! @brief Accumulates the output of a fold into the sum of a fanning inlet of another fold.
+            struct FoldSum
+            {
+                sample_t const*                 m_source;
+                sample_t*                       m_output;
+                size_t                          m_size;
+                bool                            m_first;
+            };
+            
+            //! @brief The flat record of the step of a fold.
+            //! @details The sums from m_first_sum to m_last_sum are performed before the callback. The fold
+            //! is computed again if it's stale, if its processor has been invalidated or if one of the folds
+            //! it reads, from m_first_source to m_last_source in the plan, has been computed again.
+            struct Refold
+            {
+                IPerformCallBack::perform_t     m_perform;
+                IPerformCallBack*               m_context;
+                Buffer const*                   m_inputs;
+                Buffer*                         m_outputs;
+                std::atomic<bool>*              m_stale;
+                std::atomic<bool>*              m_invalid;
+                bool*                           m_silent;
+                size_t                          m_first_sum;
+                size_t                          m_last_sum;
+                size_t                          m_first_source;
+                size_t                          m_last_source;
+                bool                            m_changed;
+                char const*                     m_name;
+            };
+            
+            //! @brief The flat record of a step.
+            //! @details The fan-ins from m_first_fan_in to m_first_accumulation are performed before the
+            //! callback, the ones to m_last_accumulation accumulate the outputs after the callback.
+            //! The detectors from m_first_detector to m_last_detector check the outputs in between.
+            //! A step without silence state is never skipped. The meter and the denormal counters of the
+            //! outputs are the ones of the step's node.
+            //! The name is the mangled type of the step's processor, reported by the real-time checks.
+            struct Record
+            {
+                IPerformCallBack::perform_t     m_perform;
+                IPerformCallBack*               m_context;
+                Buffer const*                   m_inputs;
+                Buffer*                         m_outputs;
+                size_t                          m_first_fan_in;
+                size_t                          m_first_accumulation;
+                size_t                          m_last_accumulation;
+                size_t                          m_first_detector;
+                size_t                          m_last_detector;
+                Silence*                        m_silence;
+                Meter*                          m_meter;
+                std::atomic<size_t>*            m_denormals;
+                char const*                     m_name;
+            };
+            
+        public: // methods
+            
+            //! @brief Constructor.
+            Plan() = default;
+            
+            //! @brief Destructor.
+            ~Plan() = default;
+            
+            //! @brief Performs all the steps once.
+            //! @details The steps are measured if the chain is profiling or counting the subnormal samples.
+            //! The folds that changed are computed first.
+            void tick() noexcept;
+            
+            //! @brief Computes the folds that are stale or whose processor has been invalidated, in order.
+            //! @details The folds that read them are computed again and the silence of their outputs is updated.
+            void refold() noexcept;
+            
+            //! @brief Performs a step.
+            //! @details Sums the fanning inlets and feeds the processor a buffer of sample to be processed.
+            inline void perform(Record const& record) const noexcept
+            {
+                RealTime::Scope scope(record.m_name);
+                
+                for(size_t i = record.m_first_fan_in; i < record.m_first_accumulation; ++i)
+                {
+                    sum(m_fan_ins[i]);
+                }
+                
+                if(record.m_silence == nullptr || !skip(record))
+                {
+                    record.m_perform(*record.m_context, *record.m_inputs, *record.m_outputs);
+                    
+                    for(size_t i = record.m_first_detector; i < record.m_last_detector; ++i)
+                    {
+                        *m_detectors[i].m_silent = m_abs_max(m_detectors[i].m_signal, m_detectors[i].m_size) == 0.;
+                    }
+                }
+                
+                for(size_t i = record.m_first_accumulation; i < record.m_last_accumulation; ++i)
+                {
+                    sum(m_fan_ins[i]);
+                }
+            }
+            
+            //! @brief Performs a step and adds the time spent to its meter or its subnormal samples to its counters.
+            inline void measure(Record const& record) const noexcept
+            {
+                if(m_profiling->load(std::memory_order_relaxed))
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    
+                    perform(record);
+                    
+                    record.m_meter->add(std::chrono::steady_clock::now() - start);
+                }
+                else
+                {
+                    perform(record);
+                }
+                
+                if(m_counting_denormals->load(std::memory_order_relaxed))
+                {
+                    countDenormals(record);
+                }
+            }
+            
+            //! @brief Adds the subnormal samples of the outputs of a step to its counters.
+            void countDenormals(Record const& record) const noexcept;
+            
+            //! @brief Skips a step whose inputs have been silent for longer than its tail.
+            //! @details Counts the silent samples and fills the outputs with zeros if the step is skipped.
+            //! @return Returns true if the step has been skipped.
+            bool skip(Record const& record) const noexcept;
+            
+            //! @brief Performs a fan-in.
+            inline void sum(FanIn const& fan_in) const noexcept
+            {
+                if(fan_in.m_lhs_size != fan_in.m_size || (fan_in.m_rhs != nullptr && fan_in.m_rhs_size != fan_in.m_size))
+                {
+                    sumChannels(fan_in);
+                }
+                else if(fan_in.m_rhs != nullptr)
+                {
+                    m_add(fan_in.m_lhs, fan_in.m_rhs, fan_in.m_output, fan_in.m_size);
+                    *fan_in.m_output_silent = *fan_in.m_lhs_silent && *fan_in.m_rhs_silent;
+                }
+                else
+                {
+                    m_copy(fan_in.m_lhs, fan_in.m_output, fan_in.m_size);
+                    *fan_in.m_output_silent = *fan_in.m_lhs_silent;
+                }
+            }
+            
+            //! @brief Performs a fan-in of signals that don't have the same number of channels.
+            void sumChannels(FanIn const& fan_in) const noexcept;
+            
+        public: // members
+            
+            std::vector<std::unique_ptr<Step>>          m_steps;
+            std::vector<Record>                         m_records;
+            std::vector<std::unique_ptr<Step>>          m_fold_steps;
+            std::vector<Refold>                         m_refolds;
+            std::vector<FoldSum>                        m_fold_sums;
+            std::vector<size_t>                         m_fold_sources;
+            size_t                                      m_nfolded = 0ul;
+            std::vector<FanIn>                          m_fan_ins;
+            std::vector<Detector>                       m_detectors;
+            std::vector<Silence>                        m_silences;
+            std::vector<bool const*>                    m_silent_inputs;
+            std::unique_ptr<bool[]>                     m_silent_flags;
+            std::atomic<size_t>*                        m_nskipped = nullptr;
+            std::atomic<bool> const*                    m_profiling = nullptr;
+            std::atomic<bool> const*                    m_counting_denormals = nullptr;
+            Kernels::binary_t                           m_add = nullptr;
+            Kernels::copy_t                             m_copy = nullptr;
+            Kernels::abs_max_t                          m_abs_max = nullptr;
+            Kernels::fill_t                             m_fill = nullptr;
+            size_t                                      m_vector_size = 0ul;
+            std::unique_ptr<char[]>                     m_signal_memory;
+            size_t                                      m_signal_memory_size = 0ul;
+            std::vector<Signal::sPtr>                   m_signals;
+            Signal::sPtr                                m_zero;
+            std::shared_ptr<ThreadPool>                 m_thread_pool;
+            std::unique_ptr<ParallelTick>               m_parallel_tick;
+        };
+        
+        // ================================================================================ //
+        //                                      FUSION                                      //
+        // ================================================================================ //
+        
+        //! @brief Performs a run of elementwise processors with a fused kernel.
+        //! @details The first input is the first input of the run and the next inputs are the
+        //! signal operands of the processors, in order. The operands that are values or scalar
+        //! signals are read once per tick.
+        class Chain::Fusion final : public IPerformCallBack
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details The nodes are the run in order, their second input is read if they have no value.
+            Fusion(std::vector<Node*> const& nodes);
+            
+            //! @brief Destructor.
+            ~Fusion() = default;
+            
+            //! @brief Performs the run.
+            static void trampoline(IPerformCallBack& call_back, Buffer const& input, Buffer& output);
+            
+        private: // classes
+            
+            struct Operand
+            {
+                std::atomic<sample_t> const*    m_value;
+                size_t                          m_input;
+                bool                            m_scalar;
+            };
+            
+        private: // members
+            
+            std::vector<std::shared_ptr<Processor>>     m_processors;
+            std::vector<Kernels::Stage>                 m_stages;
+            std::vector<Operand>                        m_operands;
+            Kernels::fused_t                            m_fused;
+        };
+        
+        // ================================================================================ //
+        //                                       FOLD                                       //
+        // ================================================================================ //
+        
+        //! @brief The constant signals of a pure node whose connected inputs are constant.
+        //! @details The plans that read them share the fold. Only the audio thread writes the signals, when
+        //! it computes the fold, so a node that is prepared again or whose sources change gets a new fold.
+        class Chain::Fold final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details The fold is stale until the audio thread computes it.
+            Fold() noexcept : m_stale(true) {}
+            
+            //! @brief Destructor.
+            ~Fold() = default;
+            
+        public: // members
+            
+            size_t                                      m_preparation = 0ul;
+            std::vector<std::vector<Signal::sPtr>>      m_sources;
+            std::vector<Signal::sPtr>                   m_inputs;
+            std::vector<Signal::sPtr>                   m_outputs;
+            std::unique_ptr<bool[]>                     m_silent;
+            std::atomic<bool>                           m_stale;
+            
+        private: // deleted methods
+            
+            Fold(Fold const& other) = delete;
+            Fold& operator=(Fold const& other) = delete;
+        };
+        
+        // ================================================================================ //
+        //                                  PARALLEL TICK                                   //
+        // ================================================================================ //
+        
+        //! @brief Performs the steps of a plan on the threads of a ThreadPool.
+        //! @details Each thread owns a work stealing queue. A step is queued once all the steps it
+        //! depends on have been performed and the idle threads steal the steps queued by the others.
+        class Chain::ParallelTick final : public ThreadPool::Task
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details Steps must be sorted and their dependencies built.
+            ParallelTick(Plan const& plan, size_t nthreads);
+            
+            //! @brief Destructor.
+            ~ParallelTick() = default;
+            
+            //! @brief Performs all the steps once.
+            //! @details If measure is true, the time spent performing each step is added to its meter.
+            void tick(ThreadPool& pool, bool measure) noexcept;
+            
+            //! @brief Performs the queued steps until all the steps are performed.
+            void perform(size_t thread) noexcept override final;
+            
+        private: // methods
+            
+            //! @brief Performs or measures the queued steps until all the steps are performed.
+            template<bool TMeasure>
+            void run(size_t thread) noexcept;
+            
+        private: // members
+            
+            Plan const&                                 m_plan;
+            std::vector<Step*>                          m_steps;
+            std::vector<Step*>                          m_roots;
+            const size_t                                m_nthreads;
+            std::unique_ptr<StealingQueue<Step>[]>      m_queues;
+            std::atomic<size_t>                         m_remaining;
+            bool                                        m_measure;
+        };
+        
         // ================================================================================ //
         //                                    NODE::PIN                                     //
         // ================================================================================ //
@@ -314,7 +937,7 @@ namespace kiwi
             
             Node&                                                       m_owner;
             const size_t                                                m_index;
-            Signal::sPtr                                                m_signal;
+            size_t                                                      m_slot;
             std::set<Node::Tie>                                         m_ties;
             
         private: // deleted methods
@@ -23,6 +23,8 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <cstdint>
+#include <limits>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -50,5 +52,9 @@ namespace kiwi
         #endif
         
         const sample_t pi = 3.14159265358979323846264338327950288;
+        
+        //! @brief The alignment in bytes of the signals' samples.
+        //! @details The size of a cache line and of an AVX-512 register.
+        const size_t alignment = 64ul;
     }
 }
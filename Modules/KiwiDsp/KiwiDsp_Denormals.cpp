@@ -0,0 +1,158 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_Denormals.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define KIWI_DSP_DENORMALS_SSE 1
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define KIWI_DSP_DENORMALS_FPCR 1
+#endif
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      DENORMALS                                       //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            #if defined(KIWI_DSP_DENORMALS_SSE)
+            
+            // the flush to zero and denormals are zero bits of the MXCSR.
+            const uint64_t flush_bits = 0x8040;
+            
+            inline uint64_t getStatus() noexcept
+            {
+                return _mm_getcsr();
+            }
+            
+            inline void setStatus(uint64_t status) noexcept
+            {
+                _mm_setcsr(static_cast<unsigned int>(status));
+            }
+            
+            #elif defined(KIWI_DSP_DENORMALS_FPCR)
+            
+            // the flush to zero bit of the FPCR, it also flushes the inputs.
+            const uint64_t flush_bits = uint64_t(1) << 24;
+            
+            inline uint64_t getStatus() noexcept
+            {
+                uint64_t status;
+                asm volatile("mrs %0, fpcr" : "=r"(status));
+                return status;
+            }
+            
+            inline void setStatus(uint64_t status) noexcept
+            {
+                asm volatile("msr fpcr, %0" : : "r"(status));
+            }
+            
+            #else
+            
+            const uint64_t flush_bits = 0;
+            
+            inline uint64_t getStatus() noexcept
+            {
+                return 0;
+            }
+            
+            inline void setStatus(uint64_t) noexcept
+            {
+            }
+            
+            #endif
+            
+            std::atomic<bool> engine_flushing(false);
+        }
+        
+        Denormals::Scope::Scope() noexcept :
+        Scope(engine_flushing.load(std::memory_order_relaxed))
+        {
+        }
+        
+        Denormals::Scope::Scope(bool flush) noexcept :
+        m_previous(getStatus()),
+        m_changed(false)
+        {
+            const uint64_t status = flush ? (m_previous | flush_bits) : (m_previous & ~flush_bits);
+            
+            if(status != m_previous)
+            {
+                setStatus(status);
+                m_changed = true;
+            }
+        }
+        
+        Denormals::Scope::~Scope()
+        {
+            if(m_changed)
+            {
+                setStatus(m_previous);
+            }
+        }
+        
+        bool Denormals::isSupported() noexcept
+        {
+            return flush_bits != 0;
+        }
+        
+        void Denormals::setFlushing(bool flush) noexcept
+        {
+            engine_flushing.store(flush, std::memory_order_relaxed);
+        }
+        
+        bool Denormals::isFlushing() noexcept
+        {
+            return engine_flushing.load(std::memory_order_relaxed);
+        }
+        
+        bool Denormals::isFlushingThread() noexcept
+        {
+            return flush_bits != 0 && (getStatus() & flush_bits) == flush_bits;
+        }
+        
+        size_t Denormals::count(sample_t const* samples, size_t size) noexcept
+        {
+            using bits_t = std::conditional<sizeof(sample_t) == 4, uint32_t, uint64_t>::type;
+            
+            // a subnormal has a null exponent and a mantissa that isn't null.
+            const int mantissa_bits = std::numeric_limits<sample_t>::digits - 1;
+            const bits_t mantissa = (bits_t(1) << mantissa_bits) - 1;
+            const bits_t exponent = ~mantissa & ~(bits_t(1) << (sizeof(bits_t) * 8 - 1));
+            
+            size_t count = 0ul;
+            
+            for(size_t i = 0; i < size; ++i)
+            {
+                bits_t bits;
+                std::memcpy(&bits, samples + i, sizeof(bits_t));
+                count += (bits & exponent) == 0 && (bits & mantissa) != 0;
+            }
+            
+            return count;
+        }
+    }
+}
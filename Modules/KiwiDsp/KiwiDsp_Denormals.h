@@ -0,0 +1,90 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include "KiwiDsp_Def.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      DENORMALS                                       //
+        // ==================================================================================== //
+        
+        //! @brief Flushes the subnormal samples to zero.
+        //! @details The feedback paths and the decaying ramps produce subnormal samples that most
+        //! processors handle a hundred times slower than the normal ones. The flush to zero and denormals
+        //! are zero modes of the processor replace them with zeros, they are set by the registers of the
+        //! SSE unit on x86 and by the FZ bit of the FPCR on AArch64. The engine-wide mode is applied by the
+        //! chains to the threads that tick them, it's disabled by default.
+        //! @see Chain::tick
+        class Denormals final
+        {
+        public: // classes
+            
+            //! @brief Applies a flush mode to the calling thread for the lifetime of the object.
+            //! @details The previous mode of the thread is restored by the destructor. The register is only
+            //! written if the mode changes, so the nested scopes of a single mode are almost free.
+            class Scope
+            {
+            public:
+                
+                //! @brief Applies the engine-wide mode.
+                Scope() noexcept;
+                
+                //! @brief Applies a mode.
+                Scope(bool flush) noexcept;
+                
+                //! @brief Restores the previous mode.
+                ~Scope();
+                
+            private:
+                
+                uint64_t    m_previous;
+                bool        m_changed;
+                
+                Scope(Scope const& other) = delete;
+                Scope& operator=(Scope const& other) = delete;
+            };
+            
+        public: // methods
+            
+            //! @brief Returns true if the subnormal samples can be flushed on this processor.
+            static bool isSupported() noexcept;
+            
+            //! @brief Enables or disables the engine-wide flush mode.
+            //! @details It's effective from the next tick of each chain and can be changed while they tick.
+            static void setFlushing(bool flush) noexcept;
+            
+            //! @brief Returns true if the engine-wide flush mode is enabled.
+            static bool isFlushing() noexcept;
+            
+            //! @brief Returns true if the calling thread flushes the subnormal samples.
+            static bool isFlushingThread() noexcept;
+            
+            //! @brief Counts the subnormal samples of a vector.
+            //! @details The samples are inspected bitwise so the count is right whatever the mode.
+            static size_t count(sample_t const* samples, size_t size) noexcept;
+        };
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_Kernels.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                          KERNELS                                     //
+        // ==================================================================================== //
+        
+        // Defined by the translation units compiled with the instruction set flags,
+        // they return nullptr if the instruction set isn't available for the build.
+        
+        Kernels const* getKernelsSse2() noexcept;
+        Kernels const* getKernelsAvx2() noexcept;
+        Kernels const* getKernelsAvx512() noexcept;
+        
+        namespace
+        {
+            Kernels const* getKernelsScalar() noexcept
+            {
+                static const Kernels kernels = KernelsImpl<ScalarTraits, ScalarTraits>::make(Kernels::Isa::Scalar);
+                return &kernels;
+            }
+            
+            bool isSupportedByCpu(Kernels::Isa isa) noexcept
+            {
+                if(isa == Kernels::Isa::Scalar)
+                {
+                    return true;
+                }
+                
+                #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+                
+                __builtin_cpu_init();
+                
+                switch(isa)
+                {
+                    case Kernels::Isa::Sse2:
+                        return __builtin_cpu_supports("sse2");
+                    case Kernels::Isa::Avx2:
+                        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+                    case Kernels::Isa::Avx512:
+                        return __builtin_cpu_supports("avx512f");
+                    default:
+                        return false;
+                }
+                
+                #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                
+                int info[4];
+                __cpuid(info, 0);
+                const int max_leaf = info[0];
+                
+                __cpuid(info, 1);
+                const bool sse2 = (info[3] & (1 << 26)) != 0;
+                const bool fma = (info[2] & (1 << 12)) != 0;
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                
+                // checks that the OS saves the ymm and zmm registers.
+                const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0ull;
+                const bool ymm_state = (xcr0 & 0x6) == 0x6;
+                const bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+                
+                int extended_features = 0;
+                if(max_leaf >= 7)
+                {
+                    __cpuidex(info, 7, 0);
+                    extended_features = info[1];
+                }
+                
+                const bool avx2 = (extended_features & (1 << 5)) != 0;
+                const bool avx512f = (extended_features & (1 << 16)) != 0;
+                
+                switch(isa)
+                {
+                    case Kernels::Isa::Sse2: return sse2;
+                    case Kernels::Isa::Avx2: return avx2 && fma && ymm_state;
+                    case Kernels::Isa::Avx512: return avx512f && zmm_state;
+                    default: return false;
+                }
+                
+                #else
+                
+                return false;
+                
+                #endif
+            }
+        }
+        
+        Kernels const* Kernels::get(Isa isa) noexcept
+        {
+            if(!isSupportedByCpu(isa))
+            {
+                return nullptr;
+            }
+            
+            switch(isa)
+            {
+                case Isa::Scalar: return getKernelsScalar();
+                case Isa::Sse2: return getKernelsSse2();
+                case Isa::Avx2: return getKernelsAvx2();
+                case Isa::Avx512: return getKernelsAvx512();
+                default: return nullptr;
+            }
+        }
+        
+        Kernels const& Kernels::get() noexcept
+        {
+            static Kernels const& kernels = []() -> Kernels const&
+            {
+                for(Isa isa : {Isa::Avx512, Isa::Avx2, Isa::Sse2})
+                {
+                    if(Kernels const* kernels = get(isa))
+                    {
+                        return *kernels;
+                    }
+                }
+                
+                return *getKernelsScalar();
+            }();
+            
+            return kernels;
+        }
+        
+        char const* Kernels::getName(Isa isa) noexcept
+        {
+            switch(isa)
+            {
+                case Isa::Scalar: return "scalar";
+                case Isa::Sse2: return "sse2";
+                case Isa::Avx2: return "avx2";
+                case Isa::Avx512: return "avx512";
+                default: return "unknown";
+            }
+        }
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include "KiwiDsp_Def.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                          KERNELS                                     //
+        // ==================================================================================== //
+        
+        //! @brief A table of vectorized functions that operate on arrays of samples.
+        //! @details The functions are implemented for several instruction sets and the best
+        //! implementation supported by the CPU is picked once at startup. The functions accept
+        //! unaligned memory and any size but are faster with the aligned and padded memory of the
+        //! Signal objects. The input and output arrays can be the same but must not partially overlap.
+        //! @see Signal
+        class Kernels
+        {
+        public: // classes
+            
+            //! @brief The instruction sets.
+            enum class Isa : uint8_t
+            {
+                Scalar  = 0,    ///< Plain C++ loops.
+                Sse2    = 1,    ///< 128-bit SSE2 instructions.
+                Avx2    = 2,    ///< 256-bit AVX2 and FMA instructions.
+                Avx512  = 3     ///< 512-bit AVX-512 foundation instructions.
+            };
+            
+            //! @brief The elementwise operations of the binary kernels.
+            enum class Operation : uint8_t
+            {
+                Add             = 0,
+                Sub             = 1,
+                Mul             = 2,
+                Div             = 3,
+                Less            = 4,
+                LessEqual       = 5,
+                Greater         = 6,
+                GreaterEqual    = 7,
+                Equal           = 8,
+                NotEqual        = 9
+            };
+            
+            //! @brief An operation of a fused expression.
+            //! @details The right operand is read from signal or is value if signal is null.
+            struct Stage
+            {
+                Operation       operation;
+                sample_t const* signal;
+                sample_t        value;
+            };
+            
+            // The kernels read each sample before writing the same sample, the output can be an input.
+            
+            //! @brief Computes out[i] = in[i].
+            using copy_t = void (*)(sample_t const* in, sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] = value.
+            using fill_t = void (*)(sample_t value, sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] = lhs[i] op rhs[i].
+            using binary_t = void (*)(sample_t const* lhs, sample_t const* rhs, sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] = lhs[i] op rhs.
+            using binary_value_t = void (*)(sample_t const* lhs, sample_t rhs, sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] = in[i] * mul[i] + add[i].
+            using mul_add_t = void (*)(sample_t const* in, sample_t const* mul, sample_t const* add,
+                                       sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] = in[i] * mul + add.
+            using mul_add_value_t = void (*)(sample_t const* in, sample_t mul, sample_t add,
+                                             sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] = min(max(in[i], low), high).
+            using clamp_t = void (*)(sample_t const* in, sample_t low, sample_t high, sample_t* out, size_t size);
+            
+            //! @brief Returns the maximum of |in[i]|.
+            using abs_max_t = sample_t (*)(sample_t const* in, size_t size);
+            
+            //! @brief Computes out[i] = (((in[i] op0 rhs0) op1 rhs1) ...) in a single pass.
+            //! @details The intermediate results stay in registers instead of being stored between the operations.
+            using fused_t = void (*)(Stage const* stages, size_t nstages, sample_t const* in, sample_t* out, size_t size);
+            
+            //! @brief Computes out[i] by interpolating linearly a table at the fixed point phase phases[i].
+            //! @details The table has 2^resolution + 1 points, the last one repeats the first. The upper
+            //! resolution bits of a phase are the index of a point and the lower bits its fraction.
+            //! The resolution ranges from 1 to 16.
+            //! @see Wavetable
+            using lookup_t = void (*)(sample_t const* table, size_t resolution, uint32_t const* phases,
+                                      sample_t* out, size_t size);
+            
+        public: // methods
+            
+            //! @brief Returns the kernels of the best instruction set supported by the CPU.
+            static Kernels const& get() noexcept;
+            
+            //! @brief Returns the kernels of an instruction set.
+            //! @return nullptr if the instruction set isn't supported by the CPU or the build.
+            static Kernels const* get(Isa isa) noexcept;
+            
+            //! @brief Returns the name of an instruction set.
+            static char const* getName(Isa isa) noexcept;
+            
+        public: // members
+            
+            Isa             isa;
+            
+            copy_t          copy;
+            fill_t          fill;
+            
+            binary_t        add;
+            binary_t        sub;
+            binary_t        mul;
+            binary_t        div;            ///< Returns 0 when rhs[i] is 0.
+            binary_t        less;           ///< Returns 1 if true, otherwise 0.
+            binary_t        lessEqual;      ///< Returns 1 if true, otherwise 0.
+            binary_t        greater;        ///< Returns 1 if true, otherwise 0.
+            binary_t        greaterEqual;   ///< Returns 1 if true, otherwise 0.
+            binary_t        equal;          ///< Returns 1 if true, otherwise 0.
+            binary_t        notEqual;       ///< Returns 1 if true, otherwise 0.
+            
+            binary_value_t  addValue;
+            binary_value_t  subValue;
+            binary_value_t  mulValue;
+            binary_value_t  divValue;       ///< Returns 0 when rhs is 0.
+            binary_value_t  lessValue;
+            binary_value_t  lessEqualValue;
+            binary_value_t  greaterValue;
+            binary_value_t  greaterEqualValue;
+            binary_value_t  equalValue;
+            binary_value_t  notEqualValue;
+            
+            mul_add_t       mulAdd;
+            mul_add_value_t mulAddValue;
+            clamp_t         clamp;
+            abs_max_t       absMax;
+            fused_t         fused;
+            lookup_t        lookup;
+        };
+    }
+}
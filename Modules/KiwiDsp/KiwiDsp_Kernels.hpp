@@ -0,0 +1,381 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include "KiwiDsp_Kernels.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // The implementation is compiled once per instruction set with different compiler flags,
+        // the anonymous namespace prevents the linker from merging the functions of different
+        // instruction sets. This file must only be included by the kernels' translation units.
+        
+        namespace
+        {
+        // ==================================================================================== //
+        //                                   KERNELS IMPLEMENTATION                             //
+        // ==================================================================================== //
+        
+        //! @internal Implements the kernels with a traits class that wraps the registers and the
+        //! instructions of an instruction set. The traits class defines:
+        //! - reg, the register type, and size, the number of samples per register.
+        //! - load, store and set.
+        //! - add, sub, mul, div (returns 0 when the divisor is 0) and mulAdd.
+        //! - less, lessEqual, greater, greaterEqual, equal and notEqual (returns 1 or 0).
+        //! - min, max, abs and reduceMax.
+        //! - lookup, the linear interpolation of a table at fixed point phases.
+        //! The remaining samples that don't fill a register are computed with the scalar traits.
+        template<class TTraits, class TTail>
+        class KernelsImpl
+        {
+        public: // methods
+            
+            using V = TTraits;
+            using S = TTail;
+            using reg_t = typename V::reg;
+            
+            static void copy(sample_t const* in, sample_t* out, size_t size)
+            {
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, V::load(in + i));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = in[i];
+                }
+            }
+            
+            static void fill(sample_t value, sample_t* out, size_t size)
+            {
+                reg_t const v = V::set(value);
+                
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, v);
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = value;
+                }
+            }
+            
+            template<reg_t (*TVec)(reg_t, reg_t), sample_t (*TSca)(sample_t, sample_t)>
+            static void binary(sample_t const* lhs, sample_t const* rhs, sample_t* out, size_t size)
+            {
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, TVec(V::load(lhs + i), V::load(rhs + i)));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = TSca(lhs[i], rhs[i]);
+                }
+            }
+            
+            template<reg_t (*TVec)(reg_t, reg_t), sample_t (*TSca)(sample_t, sample_t)>
+            static void binaryValue(sample_t const* lhs, sample_t rhs, sample_t* out, size_t size)
+            {
+                reg_t const r = V::set(rhs);
+                
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, TVec(V::load(lhs + i), r));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = TSca(lhs[i], rhs);
+                }
+            }
+            
+            static void mulAdd(sample_t const* in, sample_t const* mul, sample_t const* add,
+                               sample_t* out, size_t size)
+            {
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, V::mulAdd(V::load(in + i), V::load(mul + i), V::load(add + i)));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = S::mulAdd(in[i], mul[i], add[i]);
+                }
+            }
+            
+            static void mulAddValue(sample_t const* in, sample_t mul, sample_t add, sample_t* out, size_t size)
+            {
+                reg_t const m = V::set(mul);
+                reg_t const a = V::set(add);
+                
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, V::mulAdd(V::load(in + i), m, a));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = S::mulAdd(in[i], mul, add);
+                }
+            }
+            
+            static void clamp(sample_t const* in, sample_t low, sample_t high, sample_t* out, size_t size)
+            {
+                reg_t const l = V::set(low);
+                reg_t const h = V::set(high);
+                
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, V::min(V::max(V::load(in + i), l), h));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = S::min(S::max(in[i], low), high);
+                }
+            }
+            
+            static sample_t absMax(sample_t const* in, size_t size)
+            {
+                sample_t result = 0;
+                
+                size_t i = 0;
+                if(size >= V::size)
+                {
+                    reg_t m = V::set(0);
+                    for(; i + V::size <= size; i += V::size)
+                    {
+                        m = V::max(m, V::abs(V::load(in + i)));
+                    }
+                    result = V::reduceMax(m);
+                }
+                for(; i < size; ++i)
+                {
+                    result = S::max(result, S::abs(in[i]));
+                }
+                
+                return result;
+            }
+            
+            //! @brief Applies a stage to a block of four registers.
+            //! @details The registers are passed separately so that they aren't stored between the stages.
+            template<reg_t (*TVec)(reg_t, reg_t)>
+            static inline void applyBlock(reg_t& a0, reg_t& a1, reg_t& a2, reg_t& a3,
+                                          Kernels::Stage const& stage, size_t i)
+            {
+                if(stage.signal != nullptr)
+                {
+                    sample_t const* rhs = stage.signal + i;
+                    
+                    a0 = TVec(a0, V::load(rhs));
+                    a1 = TVec(a1, V::load(rhs + V::size));
+                    a2 = TVec(a2, V::load(rhs + 2 * V::size));
+                    a3 = TVec(a3, V::load(rhs + 3 * V::size));
+                }
+                else
+                {
+                    reg_t const r = V::set(stage.value);
+                    
+                    a0 = TVec(a0, r);
+                    a1 = TVec(a1, r);
+                    a2 = TVec(a2, r);
+                    a3 = TVec(a3, r);
+                }
+            }
+            
+            //! @brief Applies a stage to a sample of the remainder.
+            static inline sample_t applySample(sample_t acc, Kernels::Stage const& stage, size_t i)
+            {
+                using Op = Kernels::Operation;
+                
+                sample_t const rhs = stage.signal != nullptr ? stage.signal[i] : stage.value;
+                
+                switch(stage.operation)
+                {
+                    case Op::Add:           return S::add(acc, rhs);
+                    case Op::Sub:           return S::sub(acc, rhs);
+                    case Op::Mul:           return S::mul(acc, rhs);
+                    case Op::Div:           return S::div(acc, rhs);
+                    case Op::Less:          return S::less(acc, rhs);
+                    case Op::LessEqual:     return S::lessEqual(acc, rhs);
+                    case Op::Greater:       return S::greater(acc, rhs);
+                    case Op::GreaterEqual:  return S::greaterEqual(acc, rhs);
+                    case Op::Equal:         return S::equal(acc, rhs);
+                    case Op::NotEqual:      return S::notEqual(acc, rhs);
+                }
+                
+                return acc;
+            }
+            
+            static void fused(Kernels::Stage const* stages, size_t nstages, sample_t const* in, sample_t* out, size_t size)
+            {
+                using Op = Kernels::Operation;
+                
+                // the operation of a stage is dispatched once per block of four registers.
+                size_t i = 0;
+                for(; i + 4 * V::size <= size; i += 4 * V::size)
+                {
+                    reg_t a0 = V::load(in + i);
+                    reg_t a1 = V::load(in + i + V::size);
+                    reg_t a2 = V::load(in + i + 2 * V::size);
+                    reg_t a3 = V::load(in + i + 3 * V::size);
+                    
+                    for(size_t s = 0; s < nstages; ++s)
+                    {
+                        Kernels::Stage const& stage = stages[s];
+                        
+                        switch(stage.operation)
+                        {
+                            case Op::Add:           applyBlock<&V::add>(a0, a1, a2, a3, stage, i); break;
+                            case Op::Sub:           applyBlock<&V::sub>(a0, a1, a2, a3, stage, i); break;
+                            case Op::Mul:           applyBlock<&V::mul>(a0, a1, a2, a3, stage, i); break;
+                            case Op::Div:           applyBlock<&V::div>(a0, a1, a2, a3, stage, i); break;
+                            case Op::Less:          applyBlock<&V::less>(a0, a1, a2, a3, stage, i); break;
+                            case Op::LessEqual:     applyBlock<&V::lessEqual>(a0, a1, a2, a3, stage, i); break;
+                            case Op::Greater:       applyBlock<&V::greater>(a0, a1, a2, a3, stage, i); break;
+                            case Op::GreaterEqual:  applyBlock<&V::greaterEqual>(a0, a1, a2, a3, stage, i); break;
+                            case Op::Equal:         applyBlock<&V::equal>(a0, a1, a2, a3, stage, i); break;
+                            case Op::NotEqual:      applyBlock<&V::notEqual>(a0, a1, a2, a3, stage, i); break;
+                        }
+                    }
+                    
+                    V::store(out + i, a0);
+                    V::store(out + i + V::size, a1);
+                    V::store(out + i + 2 * V::size, a2);
+                    V::store(out + i + 3 * V::size, a3);
+                }
+                for(; i < size; ++i)
+                {
+                    sample_t acc = in[i];
+                    
+                    for(size_t s = 0; s < nstages; ++s)
+                    {
+                        acc = applySample(acc, stages[s], i);
+                    }
+                    
+                    out[i] = acc;
+                }
+            }
+            
+            static void lookup(sample_t const* table, size_t resolution, uint32_t const* phases,
+                               sample_t* out, size_t size)
+            {
+                // the fraction of a phase is scaled by the integer part's weight.
+                const int shift = 32 - static_cast<int>(resolution);
+                const sample_t scale = sample_t(1) / static_cast<sample_t>(uint32_t(1) << shift);
+                
+                size_t i = 0;
+                for(; i + V::size <= size; i += V::size)
+                {
+                    V::store(out + i, V::lookup(table, shift, scale, phases + i));
+                }
+                for(; i < size; ++i)
+                {
+                    out[i] = S::lookup(table, shift, scale, phases + i);
+                }
+            }
+            
+            //! @brief Returns the table of kernels.
+            static Kernels make(Kernels::Isa isa) noexcept
+            {
+                Kernels k;
+                k.isa               = isa;
+                k.copy              = &copy;
+                k.fill              = &fill;
+                k.add               = &binary<&V::add, &S::add>;
+                k.sub               = &binary<&V::sub, &S::sub>;
+                k.mul               = &binary<&V::mul, &S::mul>;
+                k.div               = &binary<&V::div, &S::div>;
+                k.less              = &binary<&V::less, &S::less>;
+                k.lessEqual         = &binary<&V::lessEqual, &S::lessEqual>;
+                k.greater           = &binary<&V::greater, &S::greater>;
+                k.greaterEqual      = &binary<&V::greaterEqual, &S::greaterEqual>;
+                k.equal             = &binary<&V::equal, &S::equal>;
+                k.notEqual          = &binary<&V::notEqual, &S::notEqual>;
+                k.addValue          = &binaryValue<&V::add, &S::add>;
+                k.subValue          = &binaryValue<&V::sub, &S::sub>;
+                k.mulValue          = &binaryValue<&V::mul, &S::mul>;
+                k.divValue          = &binaryValue<&V::div, &S::div>;
+                k.lessValue         = &binaryValue<&V::less, &S::less>;
+                k.lessEqualValue    = &binaryValue<&V::lessEqual, &S::lessEqual>;
+                k.greaterValue      = &binaryValue<&V::greater, &S::greater>;
+                k.greaterEqualValue = &binaryValue<&V::greaterEqual, &S::greaterEqual>;
+                k.equalValue        = &binaryValue<&V::equal, &S::equal>;
+                k.notEqualValue     = &binaryValue<&V::notEqual, &S::notEqual>;
+                k.mulAdd            = &mulAdd;
+                k.mulAddValue       = &mulAddValue;
+                k.clamp             = &clamp;
+                k.absMax            = &absMax;
+                k.fused             = &fused;
+                k.lookup            = &lookup;
+                return k;
+            }
+        };
+        
+        // ==================================================================================== //
+        //                                      SCALAR TRAITS                                   //
+        // ==================================================================================== //
+        
+        //! @internal The scalar traits used by the fallback kernels and for the remaining samples.
+        struct ScalarTraits
+        {
+            using reg = sample_t;
+            static constexpr size_t size = 1ul;
+            
+            static inline reg load(sample_t const* p) { return *p; }
+            static inline void store(sample_t* p, reg a) { *p = a; }
+            static inline reg set(sample_t a) { return a; }
+            
+            static inline reg add(reg a, reg b) { return a + b; }
+            static inline reg sub(reg a, reg b) { return a - b; }
+            static inline reg mul(reg a, reg b) { return a * b; }
+            static inline reg div(reg a, reg b) { return b != 0 ? a / b : 0; }
+            static inline reg mulAdd(reg a, reg b, reg c) { return a * b + c; }
+            
+            static inline reg less(reg a, reg b) { return a < b ? 1 : 0; }
+            static inline reg lessEqual(reg a, reg b) { return a <= b ? 1 : 0; }
+            static inline reg greater(reg a, reg b) { return a > b ? 1 : 0; }
+            static inline reg greaterEqual(reg a, reg b) { return a >= b ? 1 : 0; }
+            static inline reg equal(reg a, reg b) { return a == b ? 1 : 0; }
+            static inline reg notEqual(reg a, reg b) { return a != b ? 1 : 0; }
+            
+            static inline reg min(reg a, reg b) { return b < a ? b : a; }
+            static inline reg max(reg a, reg b) { return a < b ? b : a; }
+            static inline reg abs(reg a) { return std::abs(a); }
+            static inline sample_t reduceMax(reg a) { return a; }
+            
+            static inline reg lookup(sample_t const* table, int shift, sample_t scale, uint32_t const* phases)
+            {
+                const uint32_t phase = *phases;
+                sample_t const* point = table + (phase >> shift);
+                const sample_t frac = static_cast<sample_t>(phase & ((uint32_t(1) << shift) - 1)) * scale;
+                return point[0] + (point[1] - point[0]) * frac;
+            }
+        };
+        } // namespace
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_Kernels.hpp"
+
+#if defined(KIWI_DSP_FLOAT) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+
+#include <immintrin.h>
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      AVX2 KERNELS                                    //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            struct Avx2Traits
+            {
+                using reg = __m256;
+                static constexpr size_t size = 8ul;
+                
+                static inline reg load(sample_t const* p) { return _mm256_loadu_ps(p); }
+                static inline void store(sample_t* p, reg a) { _mm256_storeu_ps(p, a); }
+                static inline reg set(sample_t a) { return _mm256_set1_ps(a); }
+                
+                static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+                static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+                static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+                static inline reg mulAdd(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+                
+                static inline reg div(reg a, reg b)
+                {
+                    return _mm256_and_ps(_mm256_cmp_ps(b, _mm256_setzero_ps(), _CMP_NEQ_UQ), _mm256_div_ps(a, b));
+                }
+                
+                template<int TPredicate>
+                static inline reg compare(reg a, reg b)
+                {
+                    return _mm256_and_ps(_mm256_cmp_ps(a, b, TPredicate), _mm256_set1_ps(1.f));
+                }
+                
+                static inline reg less(reg a, reg b) { return compare<_CMP_LT_OQ>(a, b); }
+                static inline reg lessEqual(reg a, reg b) { return compare<_CMP_LE_OQ>(a, b); }
+                static inline reg greater(reg a, reg b) { return compare<_CMP_GT_OQ>(a, b); }
+                static inline reg greaterEqual(reg a, reg b) { return compare<_CMP_GE_OQ>(a, b); }
+                static inline reg equal(reg a, reg b) { return compare<_CMP_EQ_OQ>(a, b); }
+                static inline reg notEqual(reg a, reg b) { return compare<_CMP_NEQ_UQ>(a, b); }
+                
+                static inline reg min(reg a, reg b) { return _mm256_min_ps(b, a); }
+                static inline reg max(reg a, reg b) { return _mm256_max_ps(b, a); }
+                static inline reg abs(reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+                
+                static inline sample_t reduceMax(reg a)
+                {
+                    __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+                    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+                    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, 1));
+                    return _mm_cvtss_f32(m);
+                }
+                
+                static inline reg lookup(sample_t const* table, int shift, sample_t scale, uint32_t const* phases)
+                {
+                    const __m256i phase = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(phases));
+                    const __m256i index = _mm256_srl_epi32(phase, _mm_cvtsi32_si128(shift));
+                    const __m256i fraction = _mm256_and_si256(phase, _mm256_set1_epi32((1 << shift) - 1));
+                    const reg frac = _mm256_mul_ps(_mm256_cvtepi32_ps(fraction), _mm256_set1_ps(scale));
+                    
+                    const reg lo = _mm256_i32gather_ps(table, index, 4);
+                    const reg hi = _mm256_i32gather_ps(table + 1, index, 4);
+                    
+                    return _mm256_fmadd_ps(_mm256_sub_ps(hi, lo), frac, lo);
+                }
+            };
+        }
+        
+        Kernels const* getKernelsAvx2() noexcept
+        {
+            static const Kernels kernels = KernelsImpl<Avx2Traits, ScalarTraits>::make(Kernels::Isa::Avx2);
+            return &kernels;
+        }
+    }
+}
+
+#else
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        Kernels const* getKernelsAvx2() noexcept
+        {
+            return nullptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_Kernels.hpp"
+
+#if defined(KIWI_DSP_FLOAT) && defined(__AVX512F__)
+
+#include <immintrin.h>
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                     AVX-512 KERNELS                                  //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            struct Avx512Traits
+            {
+                using reg = __m512;
+                static constexpr size_t size = 16ul;
+                
+                static inline reg load(sample_t const* p) { return _mm512_loadu_ps(p); }
+                static inline void store(sample_t* p, reg a) { _mm512_storeu_ps(p, a); }
+                static inline reg set(sample_t a) { return _mm512_set1_ps(a); }
+                
+                static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+                static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+                static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+                static inline reg mulAdd(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+                
+                static inline reg div(reg a, reg b)
+                {
+                    return _mm512_maskz_div_ps(_mm512_cmp_ps_mask(b, _mm512_setzero_ps(), _CMP_NEQ_UQ), a, b);
+                }
+                
+                template<int TPredicate>
+                static inline reg compare(reg a, reg b)
+                {
+                    return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(a, b, TPredicate), _mm512_set1_ps(1.f));
+                }
+                
+                static inline reg less(reg a, reg b) { return compare<_CMP_LT_OQ>(a, b); }
+                static inline reg lessEqual(reg a, reg b) { return compare<_CMP_LE_OQ>(a, b); }
+                static inline reg greater(reg a, reg b) { return compare<_CMP_GT_OQ>(a, b); }
+                static inline reg greaterEqual(reg a, reg b) { return compare<_CMP_GE_OQ>(a, b); }
+                static inline reg equal(reg a, reg b) { return compare<_CMP_EQ_OQ>(a, b); }
+                static inline reg notEqual(reg a, reg b) { return compare<_CMP_NEQ_UQ>(a, b); }
+                
+                static inline reg min(reg a, reg b) { return _mm512_min_ps(b, a); }
+                static inline reg max(reg a, reg b) { return _mm512_max_ps(b, a); }
+                static inline reg abs(reg a) { return _mm512_abs_ps(a); }
+                static inline sample_t reduceMax(reg a) { return _mm512_reduce_max_ps(a); }
+                
+                static inline reg lookup(sample_t const* table, int shift, sample_t scale, uint32_t const* phases)
+                {
+                    const __m512i phase = _mm512_loadu_si512(phases);
+                    const __m512i index = _mm512_srl_epi32(phase, _mm_cvtsi32_si128(shift));
+                    const __m512i fraction = _mm512_and_si512(phase, _mm512_set1_epi32((1 << shift) - 1));
+                    const reg frac = _mm512_mul_ps(_mm512_cvtepi32_ps(fraction), _mm512_set1_ps(scale));
+                    
+                    const reg lo = _mm512_i32gather_ps(index, table, 4);
+                    const reg hi = _mm512_i32gather_ps(index, table + 1, 4);
+                    
+                    return _mm512_fmadd_ps(_mm512_sub_ps(hi, lo), frac, lo);
+                }
+            };
+        }
+        
+        Kernels const* getKernelsAvx512() noexcept
+        {
+            static const Kernels kernels = KernelsImpl<Avx512Traits, ScalarTraits>::make(Kernels::Isa::Avx512);
+            return &kernels;
+        }
+    }
+}
+
+#else
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        Kernels const* getKernelsAvx512() noexcept
+        {
+            return nullptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_Kernels.hpp"
+
+#if defined(KIWI_DSP_FLOAT) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+
+#include <emmintrin.h>
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      SSE2 KERNELS                                    //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            struct Sse2Traits
+            {
+                using reg = __m128;
+                static constexpr size_t size = 4ul;
+                
+                static inline reg load(sample_t const* p) { return _mm_loadu_ps(p); }
+                static inline void store(sample_t* p, reg a) { _mm_storeu_ps(p, a); }
+                static inline reg set(sample_t a) { return _mm_set1_ps(a); }
+                
+                static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+                static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+                static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+                static inline reg div(reg a, reg b) { return _mm_and_ps(_mm_cmpneq_ps(b, _mm_setzero_ps()), _mm_div_ps(a, b)); }
+                static inline reg mulAdd(reg a, reg b, reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+                
+                static inline reg less(reg a, reg b) { return _mm_and_ps(_mm_cmplt_ps(a, b), _mm_set1_ps(1.f)); }
+                static inline reg lessEqual(reg a, reg b) { return _mm_and_ps(_mm_cmple_ps(a, b), _mm_set1_ps(1.f)); }
+                static inline reg greater(reg a, reg b) { return _mm_and_ps(_mm_cmpgt_ps(a, b), _mm_set1_ps(1.f)); }
+                static inline reg greaterEqual(reg a, reg b) { return _mm_and_ps(_mm_cmpge_ps(a, b), _mm_set1_ps(1.f)); }
+                static inline reg equal(reg a, reg b) { return _mm_and_ps(_mm_cmpeq_ps(a, b), _mm_set1_ps(1.f)); }
+                static inline reg notEqual(reg a, reg b) { return _mm_and_ps(_mm_cmpneq_ps(a, b), _mm_set1_ps(1.f)); }
+                
+                static inline reg min(reg a, reg b) { return _mm_min_ps(b, a); }
+                static inline reg max(reg a, reg b) { return _mm_max_ps(b, a); }
+                static inline reg abs(reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+                
+                static inline sample_t reduceMax(reg a)
+                {
+                    a = _mm_max_ps(a, _mm_movehl_ps(a, a));
+                    a = _mm_max_ps(a, _mm_shuffle_ps(a, a, 1));
+                    return _mm_cvtss_f32(a);
+                }
+                
+                static inline reg lookup(sample_t const* table, int shift, sample_t scale, uint32_t const* phases)
+                {
+                    // SSE2 has no gather, the points are loaded one by one.
+                    const __m128i phase = _mm_loadu_si128(reinterpret_cast<__m128i const*>(phases));
+                    const __m128i fraction = _mm_and_si128(phase, _mm_set1_epi32((1 << shift) - 1));
+                    const reg frac = _mm_mul_ps(_mm_cvtepi32_ps(fraction), _mm_set1_ps(scale));
+                    
+                    alignas(16) int32_t indices[4];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_srl_epi32(phase, _mm_cvtsi32_si128(shift)));
+                    
+                    const reg lo = _mm_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]]);
+                    const reg hi = _mm_setr_ps(table[indices[0] + 1], table[indices[1] + 1],
+                                               table[indices[2] + 1], table[indices[3] + 1]);
+                    
+                    return _mm_add_ps(lo, _mm_mul_ps(_mm_sub_ps(hi, lo), frac));
+                }
+            };
+        }
+        
+        Kernels const* getKernelsSse2() noexcept
+        {
+            static const Kernels kernels = KernelsImpl<Sse2Traits, ScalarTraits>::make(Kernels::Isa::Sse2);
+            return &kernels;
+        }
+    }
+}
+
+#else
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        Kernels const* getKernelsSse2() noexcept
+        {
+            return nullptr;
+        }
+    }
+}
+
+#endif
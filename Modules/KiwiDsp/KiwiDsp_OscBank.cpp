@@ -0,0 +1,209 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_OscBank.h"
+#include "KiwiDsp_Misc.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      OSC BANK                                        //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            // the phase request of a partial that keeps its phase.
+            const sample_t no_phase = std::numeric_limits<sample_t>::quiet_NaN();
+            
+            // a gain closer to its target is set to it, so the partials smoothed to zero become silent.
+            const sample_t gain_threshold = 1e-6;
+        }
+        
+        OscBank::OscBank(const size_t npartials) :
+        m_npartials(npartials),
+        m_frequencies(new std::atomic<sample_t>[npartials]),
+        m_amplitudes(new std::atomic<sample_t>[npartials]),
+        m_phase_requests(new std::atomic<sample_t>[npartials]),
+        m_phase_requested(false),
+        m_smoothing(20.),
+        m_phases(npartials, 0u),
+        m_gains(npartials, 0.),
+        m_vector_phases(),
+        m_vector_gains(),
+        m_values(),
+        m_ramp(),
+        m_table(nullptr),
+        m_sample_rate(0.),
+        m_period(0.),
+        m_time(0.),
+        m_coefficient(1.),
+        m_vector_size(0ul)
+        {
+            if(npartials == 0ul)
+            {
+                throw Error("an oscillator bank must have partials");
+            }
+            
+            for(size_t i = 0; i < npartials; ++i)
+            {
+                m_frequencies[i].store(0., std::memory_order_relaxed);
+                m_amplitudes[i].store(0., std::memory_order_relaxed);
+                m_phase_requests[i].store(no_phase, std::memory_order_relaxed);
+            }
+        }
+        
+        size_t OscBank::getNumberOfPartials() const noexcept
+        {
+            return m_npartials;
+        }
+        
+        void OscBank::setFrequency(const size_t partial, const sample_t frequency) noexcept
+        {
+            if(partial < m_npartials)
+            {
+                m_frequencies[partial].store(frequency, std::memory_order_relaxed);
+            }
+        }
+        
+        void OscBank::setAmplitude(const size_t partial, const sample_t amplitude) noexcept
+        {
+            if(partial < m_npartials)
+            {
+                m_amplitudes[partial].store(amplitude, std::memory_order_relaxed);
+            }
+        }
+        
+        void OscBank::setPhase(const size_t partial, const sample_t phase) noexcept
+        {
+            if(partial < m_npartials)
+            {
+                m_phase_requests[partial].store(phase, std::memory_order_relaxed);
+                m_phase_requested.store(true, std::memory_order_release);
+            }
+        }
+        
+        void OscBank::setSmoothing(const sample_t time) noexcept
+        {
+            m_smoothing.store(std::max(time, sample_t(0.)), std::memory_order_relaxed);
+        }
+        
+        void OscBank::setCoefficient(const sample_t time) noexcept
+        {
+            const double smoothing = time * 0.001 * m_sample_rate;
+            
+            m_time = time;
+            m_coefficient = smoothing > 0. ? static_cast<sample_t>(1. - std::exp(-(m_vector_size / smoothing))) : 1.;
+        }
+        
+        void OscBank::prepare(const size_t sample_rate, const size_t vector_size)
+        {
+            m_table = &Wavetable::getCosine();
+            m_sample_rate = static_cast<double>(sample_rate);
+            m_period = 1. / m_sample_rate;
+            m_vector_size = vector_size;
+            
+            setCoefficient(m_smoothing.load(std::memory_order_relaxed));
+            
+            m_vector_phases.resize(vector_size);
+            m_vector_gains.resize(vector_size);
+            m_values.resize(vector_size);
+            m_ramp.resize(vector_size);
+            
+            // the gains reach their value of the vector at its last sample.
+            for(size_t i = 0; i < vector_size; ++i)
+            {
+                m_ramp[i] = static_cast<sample_t>(i + 1) / static_cast<sample_t>(vector_size);
+            }
+        }
+        
+        void OscBank::perform(sample_t* output) noexcept
+        {
+            Kernels const& kernels = Kernels::get();
+            const size_t size = m_vector_size;
+            
+            kernels.fill(0., output, size);
+            
+            const sample_t time = m_smoothing.load(std::memory_order_relaxed);
+            
+            if(time != m_time)
+            {
+                setCoefficient(time);
+            }
+            
+            if(m_phase_requested.exchange(false, std::memory_order_acquire))
+            {
+                for(size_t k = 0; k < m_npartials; ++k)
+                {
+                    const sample_t phase = m_phase_requests[k].exchange(no_phase, std::memory_order_relaxed);
+                    
+                    if(!std::isnan(phase))
+                    {
+                        m_phases[k] = Wavetable::toPhase(phase);
+                    }
+                }
+            }
+            
+            for(size_t k = 0; k < m_npartials; ++k)
+            {
+                const phase_t phase = m_phases[k];
+                const phase_t inc = Wavetable::toPhase(m_frequencies[k].load(std::memory_order_relaxed) * m_period);
+                const sample_t target = m_amplitudes[k].load(std::memory_order_relaxed);
+                const sample_t gain = m_gains[k];
+                
+                sample_t next = gain + (target - gain) * m_coefficient;
+                
+                if(std::abs(target - next) < gain_threshold)
+                {
+                    next = target;
+                }
+                
+                m_phases[k] = phase + static_cast<phase_t>(size) * inc;
+                m_gains[k] = next;
+                
+                if(gain == 0. && next == 0.)
+                {
+                    continue;
+                }
+                
+                // the phases don't depend on each other so the loop is vectorized.
+                for(size_t i = 0; i < size; ++i)
+                {
+                    m_vector_phases[i] = phase + static_cast<phase_t>(i) * inc;
+                }
+                
+                m_table->read(m_vector_phases.data(), m_values.data(), size);
+                
+                if(gain == next)
+                {
+                    kernels.mulValue(m_values.data(), gain, m_values.data(), size);
+                    kernels.add(m_values.data(), output, output, size);
+                }
+                else
+                {
+                    kernels.mulAddValue(m_ramp.data(), next - gain, gain, m_vector_gains.data(), size);
+                    kernels.mulAdd(m_values.data(), m_vector_gains.data(), output, output, size);
+                }
+            }
+        }
+    }
+}
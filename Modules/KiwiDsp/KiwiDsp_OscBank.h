@@ -0,0 +1,118 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "KiwiDsp_Wavetable.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      OSC BANK                                        //
+        // ==================================================================================== //
+        
+        //! @brief A bank of cosine partials summed in a single signal.
+        //! @details The frequencies, the amplitudes and the phases of the partials are stored in separate
+        //! arrays. Each partial is read in the shared cosine table for a whole vector, multiplied by its
+        //! amplitude and added to the output with the kernels, the silent partials are skipped. The
+        //! partials are set by a control thread without locks while another thread performs the bank.
+        //! Their amplitudes are smoothed by a one-pole filter updated at every vector and interpolated
+        //! linearly over the vector.
+        //! @see Wavetable
+        class OscBank final
+        {
+        public: // methods
+            
+            //! @brief The constructor.
+            //! @param npartials The number of partials.
+            //! @exception Error if the number of partials is null.
+            OscBank(const size_t npartials);
+            
+            //! @brief The destructor.
+            ~OscBank() = default;
+            
+            //! @brief Gets the number of partials.
+            size_t getNumberOfPartials() const noexcept;
+            
+            //! @brief Sets the frequency of a partial in hertz.
+            //! @details The partials out of the range are ignored, as by the other setters.
+            void setFrequency(const size_t partial, const sample_t frequency) noexcept;
+            
+            //! @brief Sets the amplitude a partial is smoothed to.
+            void setAmplitude(const size_t partial, const sample_t amplitude) noexcept;
+            
+            //! @brief Sets the phase of a partial in periods from the next vector.
+            void setPhase(const size_t partial, const sample_t phase) noexcept;
+            
+            //! @brief Sets the time constant of the smoothing of the amplitudes in milliseconds.
+            //! @details The time is 20 milliseconds by default and a null time sets the amplitudes
+            //! without smoothing. A new time is effective at the next vector.
+            void setSmoothing(const sample_t time) noexcept;
+            
+            //! @brief Prepares the bank for a sample rate and a maximum vector size.
+            void prepare(const size_t sample_rate, const size_t vector_size);
+            
+            //! @brief Computes a vector of the sum of the partials.
+            //! @details The output has the vector size of the prepare.
+            void perform(sample_t* output) noexcept;
+            
+        private: // methods
+            
+            //! @internal Computes the coefficient of the smoothing for a time in milliseconds.
+            void setCoefficient(const sample_t time) noexcept;
+            
+        private: // members
+            
+            using phase_t = Wavetable::phase_t;
+            
+            const size_t                              m_npartials;
+            std::unique_ptr<std::atomic<sample_t>[]>  m_frequencies;
+            std::unique_ptr<std::atomic<sample_t>[]>  m_amplitudes;
+            std::unique_ptr<std::atomic<sample_t>[]>  m_phase_requests;
+            std::atomic<bool>                         m_phase_requested;
+            std::atomic<sample_t>                     m_smoothing;
+            
+            std::vector<phase_t>                      m_phases;
+            std::vector<sample_t>                     m_gains;
+            std::vector<phase_t>                      m_vector_phases;
+            std::vector<sample_t>                     m_vector_gains;
+            std::vector<sample_t>                     m_values;
+            std::vector<sample_t>                     m_ramp;
+            Wavetable const*                          m_table;
+            double                                    m_sample_rate;
+            double                                    m_period;
+            sample_t                                  m_time;
+            sample_t                                  m_coefficient;
+            size_t                                    m_vector_size;
+            
+        private: // deleted methods
+            
+            OscBank(OscBank const& other) = delete;
+            OscBank(OscBank && other) = delete;
+            OscBank& operator=(OscBank const& other) = delete;
+            OscBank& operator=(OscBank && other) = delete;
+        };
+    }
+}
@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "KiwiDsp_Signal.h"
+#include "KiwiDsp_Kernels.h"
 
 namespace kiwi
 {
@@ -33,21 +36,39 @@ namespace kiwi
         //                                    PERFORM CALL BACKC                                //
         // ==================================================================================== //
         
-        //! @brief Pure virtual interface that defines a perform function to be implemented by child classes.
+        //! @brief Interface that defines a perform function implemented by child classes.
         //! @details The call back is held by the processor and enables calling perform.
         //! Using the IPerformCallBack interface enanles dynamical perform method in an efficient way.
-        //! The implementation of the interface depends on the child processor type.
+        //! The implementation of the interface depends on the child processor type. Instead of a virtual
+        //! method, the implementation gives a static trampoline so that the chain can call it directly.
         class IPerformCallBack
         {
         public:
-            //! @brief The default contrustor.
-            IPerformCallBack() = default;
+            
+            //! @brief The type of the trampoline that performs the call back.
+            using perform_t = void (*)(IPerformCallBack& call_back, Buffer const& input, Buffer& output);
+            
+            //! @brief The contrustor.
+            IPerformCallBack(perform_t perform) noexcept : m_perform(perform) {}
             
             //! @brief Destructor
             virtual ~IPerformCallBack() = default;
             
-            //! @brief pure virtual method that perform input and output buffers.
-            virtual void perform(Buffer const& intput, Buffer& output) = 0;
+            //! @brief Performs input and output buffers.
+            inline void perform(Buffer const& input, Buffer& output)
+            {
+                m_perform(*this, input, output);
+            }
+            
+            //! @brief Gets the trampoline that performs the call back.
+            inline perform_t getTrampoline() const noexcept
+            {
+                return m_perform;
+            }
+            
+        private:
+            
+            const perform_t m_perform;
         };
         
         //! @brief Templated implementation of IPerformCallBack. Templated on type of processor.
@@ -60,15 +81,18 @@ namespace kiwi
             
             //! @brief Constructor, get a pointer to the processor and its call back to be called later.
             PerformCallBack(TProc & processor, void (TProc::*call_back)(Buffer const& input, Buffer &output)):
+            IPerformCallBack(&PerformCallBack::trampoline),
             m_processor(processor),
             m_call_back(call_back)
             {
             }
             
             //! @brief Implementation of perform that binds a processor and its method.
-            void perform(Buffer const& input, Buffer& output) override final
+            static void trampoline(IPerformCallBack& call_back, Buffer const& input, Buffer& output)
             {
-                (m_processor.*m_call_back)(input, output);
+                PerformCallBack& self = static_cast<PerformCallBack&>(call_back);
+                
+                (self.m_processor.*self.m_call_back)(input, output);
             }
             
             //! @brief Destructor.
@@ -100,8 +124,18 @@ namespace kiwi
                 const size_t             sample_rate;
                 const size_t             vector_size;
                 const std::vector<bool> &inputs;
+                const std::vector<bool> &scalars;   ///< The connected inputs that hold the same value over a vector.
+                const std::vector<size_t> &channels; ///< The number of channels of the inputs.
             };
             
+        public: // constants
+            
+            //! @brief The tail of the processors that are never skipped.
+            static constexpr size_t infinite_tail = static_cast<size_t>(-1);
+            
+            //! @brief The input of an output that can't be written in place.
+            static constexpr size_t no_input = static_cast<size_t>(-1);
+            
         public: // methods
             
             //! @brief The constructor.
@@ -109,7 +143,9 @@ namespace kiwi
             //! @param ninputs The number of inputs.
             //! @param noutputs The number of outputs.
             Processor(const size_t ninputs, const size_t noutputs) noexcept :
-            m_ninputs(ninputs), m_noutputs(noutputs) {}
+            m_ninputs(ninputs), m_noutputs(noutputs), m_pure(false), m_invalid(false),
+            m_tail(infinite_tail), m_tail_any(false), m_skippable(false),
+            m_elementwise(false), m_operation(Kernels::Operation::Add), m_operand(nullptr) {}
             
             //! @brief The destructor.
             virtual ~Processor() = default;
@@ -131,12 +167,49 @@ namespace kiwi
                 return m_call_back != nullptr;
             }
             
+            //! @brief Returns true if an output holds the same value over a vector.
+            //! @see setScalarOutput
+            bool isScalarOutput(const size_t index) const noexcept
+            {
+                return index < m_scalar_outputs.size() && m_scalar_outputs[index];
+            }
+            
+            //! @brief Gets the number of channels of an output.
+            //! @see setOutputChannels
+            size_t getNumberOfOutputChannels(const size_t index) const noexcept
+            {
+                return index < m_output_channels.size() ? m_output_channels[index] : 1ul;
+            }
+            
+            //! @brief Gets the input whose signal can hold an output.
+            //! @return The index of the input or no_input.
+            //! @see setInPlace
+            size_t getInPlaceInput(const size_t index) const noexcept
+            {
+                return index < m_in_place.size() ? m_in_place[index] : no_input;
+            }
+            
+            //! @brief Returns true if the outputs only depend on the inputs.
+            //! @see setPure
+            bool isPure() const noexcept
+            {
+                return m_pure;
+            }
+            
+            //! @brief Gets the number of samples the outputs stay audible once the inputs are silent.
+            //! @see setTail
+            size_t getTail() const noexcept
+            {
+                return m_tail.load(std::memory_order_relaxed);
+            }
+            
         protected: // methods
             
             //! @brief Constructs a callback that will bind a processor and its perform method.
             //! @details setPerformCallBack shall be called by the prepare method to set the callback
             //! that will be called when chain processes a processor.
             //! Different methods can be set as callback depending on PrepareInfo status.
+            //! The chain keeps the callback of the previous preparation until the audio thread stops using it.
             template<class TProc>
             void setPerformCallBack(TProc* processor,
                                     void (TProc::*call_back)(Buffer const& input, Buffer &output))
@@ -144,6 +217,100 @@ namespace kiwi
                 m_call_back.reset(new PerformCallBack<TProc>(*processor, call_back));
             }
             
+            //! @brief Declares that an output holds the same value over a vector.
+            //! @details setScalarOutput shall be called by the prepare method. The value can still change
+            //! from a tick to another. The processors connected to the output then see a scalar input
+            //! in their PrepareInfo and can read its first sample instead of the whole vector.
+            void setScalarOutput(const size_t index)
+            {
+                if(m_scalar_outputs.size() <= index)
+                {
+                    m_scalar_outputs.resize(index + 1, false);
+                }
+                
+                m_scalar_outputs[index] = true;
+            }
+            
+            //! @brief Declares the number of channels of an output.
+            //! @details setOutputChannels shall be called by the prepare method of a processor whose output
+            //! holds several channels, one vector after the other. An input has as many channels as its
+            //! widest source, the PrepareInfo gives their number and the narrower sources are summed in
+            //! its first channels. The Buffer gives the channels of each input and output.
+            //! @see Buffer::getSignalChannel
+            void setOutputChannels(const size_t index, const size_t nchannels)
+            {
+                if(m_output_channels.size() <= index)
+                {
+                    m_output_channels.resize(index + 1, 1ul);
+                }
+                
+                m_output_channels[index] = std::max(nchannels, size_t(1ul));
+            }
+            
+            //! @brief Declares that the outputs only depend on the inputs.
+            //! @details setPure shall be called by the prepare method of processors that have no state. If all
+            //! its inputs are constant, the chain performs the processor once and its outputs are read by the
+            //! other processors instead of performing it every tick. A processor whose outputs also depend on
+            //! values received from other threads calls invalidate when they change.
+            //! @see invalidate
+            void setPure() noexcept
+            {
+                m_pure = true;
+            }
+            
+            //! @brief Notifies the chain that the outputs of a pure processor changed.
+            //! @details invalidate can be called from any thread after changing a value that the perform method
+            //! reads. If the chain folded the processor, the audio thread performs it again at the next tick
+            //! with the processors that read its outputs.
+            //! @see setPure
+            void invalidate() noexcept
+            {
+                m_invalid.store(true, std::memory_order_release);
+            }
+            
+            //! @brief Declares how long the outputs stay audible once the connected inputs are silent.
+            //! @details setTail shall be called by the prepare method of a processor whose outputs are
+            //! silent once its connected inputs have been silent for a number of samples, 0 for a stateless
+            //! processor. The chain then skips it and fills its outputs with zeros. If any is true, a single
+            //! silent input is enough, as for a multiplication. The processor can call setTail again while
+            //! the chain ticks, for instance with an infinite tail while its state feeds back on itself.
+            void setTail(const size_t samples, const bool any = false) noexcept
+            {
+                m_tail.store(samples, std::memory_order_relaxed);
+                m_tail_any.store(any, std::memory_order_relaxed);
+                m_skippable.store(true, std::memory_order_relaxed);
+            }
+            
+            //! @brief Declares that the first output is the first input combined with an operand.
+            //! @details setElementwise shall be called by the prepare method of a processor with a single
+            //! output that computes output[0][i] = input[0][i] op rhs[i] where rhs is the second input, or
+            //! its first sample if it's scalar, or the value if it's not null. The value can change while the
+            //! chain ticks. The chain then performs a processor whose output is only read by the first input
+            //! of another elementwise processor with it in a fused kernel, without calling their callbacks.
+            //! @see Kernels::fused
+            void setElementwise(Kernels::Operation operation, std::atomic<sample_t> const* value = nullptr) noexcept
+            {
+                m_elementwise = true;
+                m_operation = operation;
+                m_operand = value;
+            }
+            
+            //! @brief Declares that an output can be written in the signal of an input.
+            //! @details setInPlace shall be called by the prepare method of a processor that reads every sample
+            //! of the input before writing the same sample of the output, as the kernels do. If no other
+            //! processor reads the input's signal and they have the same number of channels, the chain binds
+            //! the output to it so that the processor touches one signal instead of two. The processor must not
+            //! assume that they are bound, and the other inputs and outputs are never bound to the signal.
+            void setInPlace(const size_t output, const size_t input)
+            {
+                if(m_in_place.size() <= output)
+                {
+                    m_in_place.resize(output + 1, size_t(no_input));
+                }
+                
+                m_in_place[output] = input;
+            }
+            
         private: // methods
             
             //! @brief Prepares everything for the perform method.
@@ -176,7 +343,18 @@ namespace kiwi
             const size_t                        m_ninputs;
             const size_t                        m_noutputs;
             
-            std::unique_ptr<IPerformCallBack>   m_call_back;
+            std::shared_ptr<IPerformCallBack>   m_call_back;
+            std::vector<bool>                   m_scalar_outputs;
+            std::vector<size_t>                 m_output_channels;
+            std::vector<size_t>                 m_in_place;
+            bool                                m_pure;
+            std::atomic<bool>                   m_invalid;
+            std::atomic<size_t>                 m_tail;
+            std::atomic<bool>                   m_tail_any;
+            std::atomic<bool>                   m_skippable;
+            bool                                m_elementwise;
+            Kernels::Operation                  m_operation;
+            std::atomic<sample_t> const*        m_operand;
             
             friend class Chain;
         };
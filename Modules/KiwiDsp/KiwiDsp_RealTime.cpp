@@ -0,0 +1,316 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "KiwiDsp_RealTime.h"
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+#if defined(KIWI_DSP_REALTIME_CHECK) && defined(__linux__) && defined(__GLIBC__)
+#define KIWI_DSP_REALTIME_INTERPOSE 1
+#include <dlfcn.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      REAL TIME                                       //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            std::atomic<RealTime::handler_t> realtime_handler(nullptr);
+            std::atomic<size_t> realtime_nviolations(0ul);
+            
+            std::string demangle(char const* name)
+            {
+                #if defined(__GNUC__)
+                
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+                
+                if(demangled != nullptr)
+                {
+                    std::string result(demangled);
+                    std::free(demangled);
+                    return result;
+                }
+                
+                #endif
+                
+                return name;
+            }
+            
+            void writeViolation(RealTime::Violation const& violation)
+            {
+                std::fprintf(stderr, "KiwiDsp: %s called by a real-time thread while performing %s\n",
+                             violation.m_call.c_str(),
+                             violation.m_processor.empty() ? "the chain" : violation.m_processor.c_str());
+            }
+        }
+        
+        RealTime::State& RealTime::getState() noexcept
+        {
+            // a trivial thread local is initialized without allocating, even from the replaced malloc.
+            static thread_local State state = {nullptr, 0ul, 0ul};
+            return state;
+        }
+        
+        bool RealTime::isChecked() noexcept
+        {
+            #if defined(KIWI_DSP_REALTIME_CHECK)
+            State const& state = getState();
+            return state.m_depth != 0ul && state.m_waivers == 0ul;
+            #else
+            return false;
+            #endif
+        }
+        
+        void RealTime::check(char const* call) noexcept
+        {
+            if(!isChecked())
+            {
+                return;
+            }
+            
+            realtime_nviolations.fetch_add(1ul);
+            
+            Waiver waiver;
+            
+            try
+            {
+                char const* name = getState().m_name;
+                Violation const violation{call, name != nullptr ? demangle(name) : std::string()};
+                
+                handler_t handler = realtime_handler.load();
+                (handler != nullptr ? handler : &writeViolation)(violation);
+            }
+            catch(...)
+            {
+            }
+        }
+        
+        RealTime::handler_t RealTime::setHandler(handler_t handler) noexcept
+        {
+            return realtime_handler.exchange(handler);
+        }
+        
+        size_t RealTime::getNumberOfViolations() noexcept
+        {
+            return realtime_nviolations.load();
+        }
+    }
+}
+
+#if defined(KIWI_DSP_REALTIME_CHECK)
+
+// ==================================================================================== //
+//                                  REPLACED FUNCTIONS                                  //
+// ==================================================================================== //
+
+#if defined(KIWI_DSP_REALTIME_INTERPOSE)
+
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void __libc_free(void* ptr);
+}
+
+namespace
+{
+    void* allocate(size_t size) noexcept {return __libc_malloc(size);}
+    
+    void deallocate(void* ptr) noexcept {__libc_free(ptr);}
+    
+    //! @brief Gets the next definition of a function, the one replaced.
+    //! @details The pointer is cached without a static guard that could lock.
+    template<class TFunction>
+    TFunction next(std::atomic<TFunction>& function, char const* name) noexcept
+    {
+        TFunction result = function.load(std::memory_order_relaxed);
+        
+        if(result == nullptr)
+        {
+            kiwi::dsp::RealTime::Waiver waiver;
+            result = reinterpret_cast<TFunction>(dlsym(RTLD_NEXT, name));
+            function.store(result, std::memory_order_relaxed);
+        }
+        
+        return result;
+    }
+}
+
+//! @brief Defines a function that reports the call and calls the replaced function.
+#define KIWI_DSP_REALTIME_REPLACE(result, name, params, args, spec)                             \
+extern "C" result name params spec                                                              \
+{                                                                                               \
+    using function_t = result (*) params;                                                       \
+    static std::atomic<function_t> function(nullptr);                                           \
+    kiwi::dsp::RealTime::check(#name);                                                          \
+    return next(function, #name) args;                                                          \
+}
+
+KIWI_DSP_REALTIME_REPLACE(int, pthread_mutex_lock, (pthread_mutex_t* mutex), (mutex), noexcept)
+KIWI_DSP_REALTIME_REPLACE(int, pthread_rwlock_rdlock, (pthread_rwlock_t* lock), (lock), noexcept)
+KIWI_DSP_REALTIME_REPLACE(int, pthread_rwlock_wrlock, (pthread_rwlock_t* lock), (lock), noexcept)
+KIWI_DSP_REALTIME_REPLACE(int, pthread_cond_wait, (pthread_cond_t* condition, pthread_mutex_t* mutex),
+                          (condition, mutex), )
+KIWI_DSP_REALTIME_REPLACE(int, pthread_cond_timedwait, (pthread_cond_t* condition, pthread_mutex_t* mutex,
+                                                        timespec const* time), (condition, mutex, time), )
+KIWI_DSP_REALTIME_REPLACE(int, pthread_join, (pthread_t thread, void** result), (thread, result), )
+KIWI_DSP_REALTIME_REPLACE(int, nanosleep, (timespec const* time, timespec* remaining), (time, remaining), )
+KIWI_DSP_REALTIME_REPLACE(int, usleep, (useconds_t time), (time), )
+KIWI_DSP_REALTIME_REPLACE(unsigned int, sleep, (unsigned int time), (time), )
+KIWI_DSP_REALTIME_REPLACE(ssize_t, read, (int file, void* buffer, size_t size), (file, buffer, size), )
+KIWI_DSP_REALTIME_REPLACE(ssize_t, write, (int file, void const* buffer, size_t size), (file, buffer, size), )
+
+#undef KIWI_DSP_REALTIME_REPLACE
+
+extern "C" void* malloc(size_t size) noexcept
+{
+    kiwi::dsp::RealTime::check("malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept
+{
+    kiwi::dsp::RealTime::check("calloc");
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) noexcept
+{
+    kiwi::dsp::RealTime::check("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) noexcept
+{
+    if(ptr != nullptr)
+    {
+        kiwi::dsp::RealTime::check("free");
+    }
+    
+    __libc_free(ptr);
+}
+
+#else
+
+namespace
+{
+    void* allocate(size_t size) noexcept {return std::malloc(size);}
+    
+    void deallocate(void* ptr) noexcept {std::free(ptr);}
+}
+
+#endif
+
+void* operator new(size_t size)
+{
+    kiwi::dsp::RealTime::check("operator new");
+    
+    for(;;)
+    {
+        if(void* ptr = allocate(size != 0ul ? size : 1ul))
+        {
+            return ptr;
+        }
+        
+        std::new_handler handler = std::get_new_handler();
+        
+        if(handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        
+        handler();
+    }
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, std::nothrow_t const&) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch(...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, std::nothrow_t const&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if(ptr != nullptr)
+    {
+        kiwi::dsp::RealTime::check("operator delete");
+        deallocate(ptr);
+    }
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const&) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept
+{
+    operator delete(ptr);
+}
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "KiwiDsp_Misc.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      REAL TIME                                       //
+        // ==================================================================================== //
+        
+        //! @brief Checks that the audio thread doesn't break the real-time rules.
+        //! @details The checks are only compiled if KIWI_DSP_REALTIME_CHECK is defined, by the CMake
+        //! option of the same name. The chain then marks the threads that tick it with the processor they
+        //! perform, and the memory allocations, the locks and the blocking system calls made by a marked
+        //! thread are reported to a handler with the name of the processor. The operators new and delete
+        //! are replaced on every system, the malloc family only with the GNU C library and the locks and
+        //! blocking calls only on POSIX systems. Without the definition the class does nothing.
+        //! @see Chain
+        class RealTime final
+        {
+        public: // classes
+            
+            //! @brief A call that broke the real-time rules.
+            struct Violation
+            {
+                std::string m_call;         ///< The name of the function called.
+                std::string m_processor;    ///< The type of the processor performed or an empty string.
+            };
+            
+            //! @brief The type of the functions called for each violation.
+            //! @details The handler is called by the thread that broke the rules and is free to allocate,
+            //! the checks are suspended while it runs.
+            using handler_t = void (*)(Violation const& violation);
+            
+            //! @brief Marks the calling thread as a real-time thread for the lifetime of the object.
+            //! @details The scopes can be nested, an inner scope without a name keeps the name of the
+            //! outer scope. The name is expected to be a mangled type name or a static string.
+            class Scope
+            {
+            public:
+                
+                #if defined(KIWI_DSP_REALTIME_CHECK)
+                Scope(char const* name = nullptr) noexcept
+                {
+                    State& state = getState();
+                    m_previous_name = state.m_name;
+                    m_previous_depth = state.m_depth;
+                    state.m_name = name != nullptr ? name : m_previous_name;
+                    state.m_depth = m_previous_depth + 1;
+                }
+                #else
+                Scope(char const* = nullptr) noexcept
+                {
+                }
+                #endif
+                
+                ~Scope()
+                {
+                    #if defined(KIWI_DSP_REALTIME_CHECK)
+                    State& state = getState();
+                    state.m_name = m_previous_name;
+                    state.m_depth = m_previous_depth;
+                    #endif
+                }
+                
+            private:
+                
+                #if defined(KIWI_DSP_REALTIME_CHECK)
+                char const*     m_previous_name;
+                size_t          m_previous_depth;
+                #endif
+                
+                Scope(Scope const& other) = delete;
+                Scope& operator=(Scope const& other) = delete;
+            };
+            
+            //! @brief Suspends the checks of the calling thread for the lifetime of the object.
+            //! @details A waiver documents a call that is known to break the rules and is accepted,
+            //! for instance the probes of the tests that record the signals.
+            class Waiver
+            {
+            public:
+                
+                Waiver() noexcept
+                {
+                    #if defined(KIWI_DSP_REALTIME_CHECK)
+                    ++getState().m_waivers;
+                    #endif
+                }
+                
+                ~Waiver()
+                {
+                    #if defined(KIWI_DSP_REALTIME_CHECK)
+                    --getState().m_waivers;
+                    #endif
+                }
+                
+            private:
+                
+                Waiver(Waiver const& other) = delete;
+                Waiver& operator=(Waiver const& other) = delete;
+            };
+            
+        public: // methods
+            
+            //! @brief Returns true if the checks are compiled.
+            static constexpr bool isEnabled() noexcept
+            {
+                #if defined(KIWI_DSP_REALTIME_CHECK)
+                return true;
+                #else
+                return false;
+                #endif
+            }
+            
+            //! @brief Returns true if the calling thread is marked and its checks are not suspended.
+            static bool isChecked() noexcept;
+            
+            //! @brief Reports a call that breaks the real-time rules if the calling thread is checked.
+            //! @details Called by the replaced functions, it can also be called by the code that knows it
+            //! shouldn't run in a real-time thread.
+            static void check(char const* call) noexcept;
+            
+            //! @brief Sets the function called for each violation.
+            //! @details By default the violations are written to the standard error output. A null handler
+            //! restores the default one. The handler shouldn't be changed while a chain is ticked.
+            //! @return The previous handler.
+            static handler_t setHandler(handler_t handler) noexcept;
+            
+            //! @brief Gets the number of violations reported since the program started.
+            static size_t getNumberOfViolations() noexcept;
+            
+        private: // classes
+            
+            //! @brief The marks of a thread.
+            struct State
+            {
+                char const* m_name;
+                size_t      m_depth;
+                size_t      m_waivers;
+            };
+            
+        private: // methods
+            
+            //! @brief Gets the marks of the calling thread.
+            static State& getState() noexcept;
+        };
+    }
+}
@@ -0,0 +1,351 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <cmath>
+
+#include "KiwiDsp_Region.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      RESAMPLER                                       //
+        // ==================================================================================== //
+        
+        Resampler::Resampler(const size_t ratio, const size_t phase_size) :
+        m_ratio(ratio),
+        m_phase_size(ratio > 1ul ? phase_size : 1ul),
+        m_coefficients(m_ratio * m_phase_size, 1.),
+        m_history(),
+        m_vector_size(0ul)
+        {
+            const size_t size = m_coefficients.size();
+            
+            if(size > 1ul)
+            {
+                // The cutoff leaves a tenth of the lower Nyquist frequency to the transition band.
+                const double cutoff = 0.45 / m_ratio;
+                const double center = (size - 1) * 0.5;
+                double sum = 0.;
+                
+                for(size_t i = 0; i < size; ++i)
+                {
+                    const double x = i - center;
+                    const double sinc = x != 0. ? std::sin(2. * pi * cutoff * x) / (pi * x) : 2. * cutoff;
+                    const double window = 0.42
+                                        - 0.5 * std::cos(2. * pi * i / (size - 1))
+                                        + 0.08 * std::cos(4. * pi * i / (size - 1));
+                    
+                    m_coefficients[i] = sinc * window;
+                    sum += m_coefficients[i];
+                }
+                
+                for(sample_t& coefficient : m_coefficients)
+                {
+                    coefficient /= sum;
+                }
+            }
+        }
+        
+        void Resampler::prepare(const size_t vector_size)
+        {
+            m_vector_size = vector_size;
+            m_history.assign(m_coefficients.size() - 1 + vector_size * m_ratio, 0.);
+        }
+        
+        void Resampler::upsample(sample_t const* input, sample_t* output) noexcept
+        {
+            // The history holds the last inputs that the phases still need followed by the new ones.
+            
+            const size_t nhistory = m_phase_size - 1;
+            sample_t* history = m_history.data();
+            
+            std::copy(input, input + m_vector_size, history + nhistory);
+            
+            for(size_t i = 0; i < m_vector_size; ++i)
+            {
+                sample_t const* x = history + nhistory + i;
+                
+                for(size_t phase = 0; phase < m_ratio; ++phase)
+                {
+                    sample_t const* coefficient = m_coefficients.data() + phase;
+                    sample_t sum = 0.;
+                    
+                    for(size_t j = 0; j < m_phase_size; ++j)
+                    {
+                        sum += coefficient[j * m_ratio] * x[-static_cast<ptrdiff_t>(j)];
+                    }
+                    
+                    *output++ = sum * m_ratio;
+                }
+            }
+            
+            std::copy(history + m_vector_size, history + m_vector_size + nhistory, history);
+        }
+        
+        void Resampler::downsample(sample_t const* input, sample_t* output) noexcept
+        {
+            const size_t nhistory = m_coefficients.size() - 1;
+            const size_t size = m_vector_size * m_ratio;
+            sample_t* history = m_history.data();
+            
+            std::copy(input, input + size, history + nhistory);
+            
+            // the last sample of each period is kept so that upsampling then downsampling
+            // delays the signal by a whole number of samples.
+            for(size_t i = 0; i < m_vector_size; ++i)
+            {
+                sample_t const* x = history + nhistory + i * m_ratio + m_ratio - 1;
+                sample_t sum = 0.;
+                
+                for(size_t j = 0; j <= nhistory; ++j)
+                {
+                    sum += m_coefficients[j] * x[-static_cast<ptrdiff_t>(j)];
+                }
+                
+                output[i] = sum;
+            }
+            
+            std::copy(history + size, history + size + nhistory, history);
+        }
+        
+        size_t Resampler::getRatio() const noexcept
+        {
+            return m_ratio;
+        }
+        
+        size_t Resampler::getLatency() const noexcept
+        {
+            return m_phase_size - 1;
+        }
+        
+        // ==================================================================================== //
+        //                                        REGION                                        //
+        // ==================================================================================== //
+        
+        Region::Region(const size_t ninputs, const size_t noutputs,
+                       const size_t ratio, const size_t block_size) :
+        Processor(ninputs, noutputs),
+        m_ratio(ratio),
+        m_block_size(block_size),
+        m_inlets(),
+        m_outlets(),
+        m_upsamplers(),
+        m_downsamplers(),
+        m_input_fifo(),
+        m_output_fifo(),
+        m_input_fifo_size(0ul),
+        m_output_fifo_size(0ul),
+        m_read(0ul),
+        m_latency(0ul),
+        m_chain()
+        {
+            if(ratio == 0ul)
+            {
+                throw Error("the ratio of a region must be positive");
+            }
+            
+            m_inlets.reserve(ninputs);
+            m_upsamplers.reserve(ninputs);
+            
+            for(size_t i = 0; i < ninputs; ++i)
+            {
+                m_inlets.emplace_back(std::make_shared<Inlet>(*this, i));
+                m_upsamplers.emplace_back(ratio);
+                m_chain.addProcessor(m_inlets.back());
+            }
+            
+            m_outlets.reserve(noutputs);
+            m_downsamplers.reserve(noutputs);
+            
+            for(size_t i = 0; i < noutputs; ++i)
+            {
+                m_outlets.emplace_back(std::make_shared<Outlet>(*this, i));
+                m_downsamplers.emplace_back(ratio);
+                m_chain.addProcessor(m_outlets.back());
+            }
+        }
+        
+        Region::~Region()
+        {
+        }
+        
+        Chain& Region::getChain() noexcept
+        {
+            return m_chain;
+        }
+        
+        Processor& Region::getInlet(const size_t index)
+        {
+            return *m_inlets[index];
+        }
+        
+        Processor& Region::getOutlet(const size_t index)
+        {
+            return *m_outlets[index];
+        }
+        
+        size_t Region::getRatio() const noexcept
+        {
+            return m_ratio;
+        }
+        
+        size_t Region::getLatency() const noexcept
+        {
+            return m_latency;
+        }
+        
+        void Region::prepare(PrepareInfo const& infos)
+        {
+            const size_t size = infos.vector_size * m_ratio;
+            const size_t block_size = m_block_size != 0ul ? m_block_size : size;
+            
+            m_chain.prepare(infos.sample_rate * m_ratio, block_size);
+            
+            for(Resampler& resampler : m_upsamplers)
+            {
+                resampler.prepare(infos.vector_size);
+            }
+            
+            for(Resampler& resampler : m_downsamplers)
+            {
+                resampler.prepare(infos.vector_size);
+            }
+            
+            // if the size isn't a multiple of the block size the outputs are delayed by a block
+            // so that a vector can always be filled.
+            const size_t delay = (size % block_size) != 0ul ? block_size : 0ul;
+            
+            m_input_fifo = Buffer(getNumberOfInputs(), size + block_size);
+            m_output_fifo = Buffer(getNumberOfOutputs(), size + block_size + delay);
+            m_input_fifo_size = 0ul;
+            m_output_fifo_size = delay;
+            
+            m_latency = delay / m_ratio;
+            
+            if(!m_downsamplers.empty())
+            {
+                m_latency += m_downsamplers.front().getLatency();
+            }
+            
+            setPerformCallBack(this, &Region::perform);
+        }
+        
+        void Region::perform(Buffer const& input, Buffer& output) noexcept
+        {
+            const size_t size = input.getVectorSize() * m_ratio;
+            const size_t block_size = m_chain.getVectorSize();
+            
+            for(size_t i = 0; i < m_upsamplers.size(); ++i)
+            {
+                m_upsamplers[i].upsample(input[i].data(), m_input_fifo[i].data() + m_input_fifo_size);
+            }
+            
+            m_input_fifo_size += size;
+            
+            for(m_read = 0ul; m_input_fifo_size - m_read >= block_size; m_read += block_size)
+            {
+                // the outlets that aren't performed during an update of the sub-chain output silence.
+                for(size_t i = 0; i < m_output_fifo.getNumberOfChannels(); ++i)
+                {
+                    sample_t* output_fifo = m_output_fifo[i].data() + m_output_fifo_size;
+                    std::fill(output_fifo, output_fifo + block_size, 0.);
+                }
+                
+                m_chain.tick();
+                
+                m_output_fifo_size += block_size;
+            }
+            
+            for(size_t i = 0; i < m_input_fifo.getNumberOfChannels(); ++i)
+            {
+                sample_t* input_fifo = m_input_fifo[i].data();
+                std::copy(input_fifo + m_read, input_fifo + m_input_fifo_size, input_fifo);
+            }
+            
+            m_input_fifo_size -= m_read;
+            
+            for(size_t i = 0; i < m_downsamplers.size(); ++i)
+            {
+                sample_t* output_fifo = m_output_fifo[i].data();
+                m_downsamplers[i].downsample(output_fifo, output[i].data());
+                std::copy(output_fifo + size, output_fifo + m_output_fifo_size, output_fifo);
+            }
+            
+            m_output_fifo_size -= size;
+        }
+        
+        void Region::release()
+        {
+            m_chain.release();
+        }
+        
+        // ==================================================================================== //
+        //                                    REGION::INLET                                     //
+        // ==================================================================================== //
+        
+        Region::Inlet::Inlet(Region& region, const size_t index) noexcept :
+        Processor(0ul, 1ul),
+        m_region(region),
+        m_index(index)
+        {
+        }
+        
+        void Region::Inlet::prepare(PrepareInfo const&)
+        {
+            setPerformCallBack(this, &Inlet::perform);
+        }
+        
+        void Region::Inlet::perform(Buffer const&, Buffer& output) noexcept
+        {
+            Signal& signal = output[0ul];
+            sample_t const* input_fifo = m_region.m_input_fifo[m_index].data() + m_region.m_read;
+            
+            std::copy(input_fifo, input_fifo + signal.size(), signal.data());
+        }
+        
+        // ==================================================================================== //
+        //                                    REGION::OUTLET                                    //
+        // ==================================================================================== //
+        
+        Region::Outlet::Outlet(Region& region, const size_t index) noexcept :
+        Processor(1ul, 0ul),
+        m_region(region),
+        m_index(index)
+        {
+        }
+        
+        void Region::Outlet::prepare(PrepareInfo const&)
+        {
+            setPerformCallBack(this, &Outlet::perform);
+        }
+        
+        void Region::Outlet::perform(Buffer const& input, Buffer&) noexcept
+        {
+            Signal const& signal = input[0ul];
+            sample_t* output_fifo = m_region.m_output_fifo[m_index].data() + m_region.m_output_fifo_size;
+            
+            std::copy(signal.data(), signal.data() + signal.size(), output_fifo);
+        }
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include "KiwiDsp_Chain.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      RESAMPLER                                       //
+        // ==================================================================================== //
+        
+        //! @brief A polyphase FIR filter that changes the sample rate by an integer ratio.
+        //! @details The low-pass filter is a Blackman windowed sinc whose cutoff is just below the
+        //! Nyquist frequency of the lower rate. Upsampling only computes the phases of the filter
+        //! that meet a non-zero sample and downsampling only computes the samples that are kept.
+        //! Upsampling then downsampling a signal delays it by the number of taps per phase minus one.
+        class Resampler
+        {
+        public: // methods
+            
+            //! @brief The constructor.
+            //! @param ratio        The ratio between the higher and the lower sample rates.
+            //! @param phase_size   The number of taps of the filter for each phase.
+            Resampler(const size_t ratio, const size_t phase_size = 16ul);
+            
+            //! @brief The destructor.
+            ~Resampler() = default;
+            
+            //! @brief Allocates the history for a vector size at the lower rate and clears it.
+            void prepare(const size_t vector_size);
+            
+            //! @brief Upsamples a vector.
+            //! @param input    The vector size samples at the lower rate.
+            //! @param output   The vector size times ratio samples at the higher rate.
+            void upsample(sample_t const* input, sample_t* output) noexcept;
+            
+            //! @brief Downsamples a vector.
+            //! @param input    The vector size times ratio samples at the higher rate.
+            //! @param output   The vector size samples at the lower rate.
+            void downsample(sample_t const* input, sample_t* output) noexcept;
+            
+            //! @brief Gets the ratio between the higher and the lower sample rates.
+            size_t getRatio() const noexcept;
+            
+            //! @brief Gets the delay of upsampling then downsampling a signal in samples at the lower rate.
+            size_t getLatency() const noexcept;
+            
+        private: // members
+            
+            const size_t            m_ratio;
+            const size_t            m_phase_size;
+            std::vector<sample_t>   m_coefficients;
+            std::vector<sample_t>   m_history;
+            size_t                  m_vector_size;
+        };
+        
+        // ==================================================================================== //
+        //                                        REGION                                        //
+        // ==================================================================================== //
+        
+        //! @brief A processor that performs a sub-chain at its own sample rate and vector size.
+        //! @details The region oversamples its inputs by an integer ratio, ticks its chain with
+        //! its own block size and downsamples the results to its outputs. Only the processors of the
+        //! sub-chain pay the cost of the higher rate. The processors are added to the chain of the
+        //! region and connected to its inlets and outlets, which are processors of the sub-chain with
+        //! respectively one output and one input. The sub-chain is prepared with the region and the
+        //! changes made afterwards are effective when its update method is called.
+        //! If the vector size times the ratio isn't a multiple of the block size, the signals are
+        //! delayed by a block to go through FIFOs.
+        //! The region is only available to the code that builds chains, the patchers can't host one
+        //! as long as they can't be nested.
+        class Region final : public Processor
+        {
+        public: // methods
+            
+            //! @brief The constructor.
+            //! @param ninputs      The number of inputs.
+            //! @param noutputs     The number of outputs.
+            //! @param ratio        The oversampling ratio, 1 doesn't resample.
+            //! @param block_size   The vector size of the sub-chain, 0 uses the vector size times the ratio.
+            //! @exception Error if the ratio is null.
+            Region(const size_t ninputs, const size_t noutputs,
+                   const size_t ratio, const size_t block_size = 0ul);
+            
+            //! @brief The destructor.
+            ~Region();
+            
+            //! @brief Gets the sub-chain of the region.
+            Chain& getChain() noexcept;
+            
+            //! @brief Gets the processor of the sub-chain that outputs an input of the region.
+            Processor& getInlet(const size_t index);
+            
+            //! @brief Gets the processor of the sub-chain whose input is an output of the region.
+            Processor& getOutlet(const size_t index);
+            
+            //! @brief Gets the oversampling ratio.
+            size_t getRatio() const noexcept;
+            
+            //! @brief Gets the delay of the outputs in samples at the rate of the region's chain.
+            //! @details Includes the delay of the resampling filters and of the FIFOs, rounded down if
+            //! the block size isn't a multiple of the ratio. Valid once prepared.
+            size_t getLatency() const noexcept;
+            
+        private: // classes
+            
+            class Inlet;
+            class Outlet;
+            
+        private: // methods
+            
+            //! @brief Prepares the sub-chain at the ratio of the sample rate with the block size.
+            //! @exception LoopError if the sub-chain contains a loop.
+            void prepare(PrepareInfo const& infos) override final;
+            
+            //! @brief Resamples the signals and ticks the sub-chain for every complete block.
+            void perform(Buffer const& input, Buffer& output) noexcept;
+            
+            //! @brief Releases the sub-chain.
+            void release() override final;
+            
+        private: // members
+            
+            const size_t                            m_ratio;
+            const size_t                            m_block_size;
+            std::vector<std::shared_ptr<Inlet>>     m_inlets;
+            std::vector<std::shared_ptr<Outlet>>    m_outlets;
+            std::vector<Resampler>                  m_upsamplers;
+            std::vector<Resampler>                  m_downsamplers;
+            Buffer                                  m_input_fifo;
+            Buffer                                  m_output_fifo;
+            size_t                                  m_input_fifo_size;
+            size_t                                  m_output_fifo_size;
+            size_t                                  m_read;
+            size_t                                  m_latency;
+            Chain                                   m_chain;
+        };
+        
+        // ==================================================================================== //
+        //                                    REGION::INLET                                     //
+        // ==================================================================================== //
+        
+        //! @brief Outputs a block of an input of the region in its sub-chain.
+        class Region::Inlet final : public Processor
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            Inlet(Region& region, const size_t index) noexcept;
+            
+            //! @brief Destructor.
+            ~Inlet() = default;
+            
+        private: // methods
+            
+            void prepare(PrepareInfo const& infos) override final;
+            
+            void perform(Buffer const& input, Buffer& output) noexcept;
+            
+        private: // members
+            
+            Region&         m_region;
+            const size_t    m_index;
+        };
+        
+        // ==================================================================================== //
+        //                                    REGION::OUTLET                                    //
+        // ==================================================================================== //
+        
+        //! @brief Appends a block of its input to an output of the region.
+        class Region::Outlet final : public Processor
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            Outlet(Region& region, const size_t index) noexcept;
+            
+            //! @brief Destructor.
+            ~Outlet() = default;
+            
+        private: // methods
+            
+            void prepare(PrepareInfo const& infos) override final;
+            
+            void perform(Buffer const& input, Buffer& output) noexcept;
+            
+        private: // members
+            
+            Region&         m_region;
+            const size_t    m_index;
+        };
+    }
+}
@@ -21,6 +21,7 @@
 
 #include "KiwiDsp_Signal.h"
 #include "KiwiDsp_Misc.h"
+#include "KiwiDsp_Kernels.h"
 
 namespace kiwi
 {
@@ -31,42 +32,110 @@ namespace kiwi
         //                                       SIGNAL                                     //
         // ================================================================================ //
         
+        namespace
+        {
+            //! @internal Allocates aligned samples padded with zeros.
+            //! @details The offset to the allocated address is stored in the byte preceding the samples.
+            sample_t* allocateSamples(const size_t size)
+            {
+                if(size > (std::numeric_limits<size_t>::max() - 2 * alignment) / sizeof(sample_t))
+                {
+                    throw std::bad_alloc();
+                }
+                
+                const size_t padded_size = ((size * sizeof(sample_t) + alignment - 1) / alignment) * alignment;
+                
+                char* memory = static_cast<char*>(::operator new(padded_size + alignment));
+                const size_t offset = alignment - reinterpret_cast<uintptr_t>(memory) % alignment;
+                char* samples = memory + offset;
+                samples[-1] = static_cast<char>(offset - 1);
+                
+                std::memset(samples + size * sizeof(sample_t), 0, padded_size - size * sizeof(sample_t));
+                
+                return reinterpret_cast<sample_t*>(samples);
+            }
+            
+            //! @internal Frees samples allocated with allocateSamples.
+            void freeSamples(sample_t* samples) noexcept
+            {
+                char* memory = reinterpret_cast<char*>(samples);
+                const size_t offset = static_cast<unsigned char>(memory[-1]) + 1;
+                ::operator delete(memory - offset);
+            }
+        }
+        
         Signal::Signal(const size_t size, const sample_t val) :
         m_size(size),
-        m_samples(new sample_t[size])
+        m_samples(allocateSamples(size)),
+        m_owner(true),
+        m_zero(false)
         {
             assert(size && "size must be greater than 0");
             fill(val);
         }
         
+        Signal::Signal(sample_t* samples, const size_t size) noexcept :
+        m_size(size),
+        m_samples(samples),
+        m_owner(false),
+        m_zero(false)
+        {
+            assert(samples != nullptr && size && "samples must be allocated");
+        }
+        
         Signal::Signal(Signal&& other) noexcept :
         m_size(std::move(other.m_size)),
-        m_samples(std::move(other.m_samples))
+        m_samples(std::move(other.m_samples)),
+        m_owner(std::move(other.m_owner)),
+        m_zero(std::move(other.m_zero))
         {
             other.m_size = 0ul;
             other.m_samples = nullptr;
+            other.m_owner = false;
+            other.m_zero = false;
         }
         
         Signal& Signal::operator=(Signal&& other) noexcept
         {
+            if(m_owner && m_samples != nullptr)
+            {
+                freeSamples(m_samples);
+            }
+            
             m_size = std::move(other.m_size);
             m_samples = std::move(other.m_samples);
+            m_owner = std::move(other.m_owner);
+            m_zero = std::move(other.m_zero);
             other.m_size = 0ul;
             other.m_samples = nullptr;
+            other.m_owner = false;
+            other.m_zero = false;
             
             return *this;
         }
         
         Signal::~Signal()
         {
-            if(m_samples != nullptr)
+            if(m_owner && m_samples != nullptr)
             {
-                delete [] m_samples;
+                freeSamples(m_samples);
             }
             m_samples = nullptr;
             m_size    = 0ul;
         }
         
+        Signal::sPtr Signal::createZero(const size_t size)
+        {
+            Signal::sPtr zero = std::make_shared<Signal>(size);
+            zero->m_zero = true;
+            return zero;
+        }
+        
+        bool Signal::isZero() const noexcept
+        {
+            return m_zero;
+        }
+        
         size_t Signal::size() const noexcept
         {
             return m_size;
@@ -79,6 +148,8 @@ namespace kiwi
         
         sample_t* Signal::data() noexcept
         {
+            assert(!m_zero && "The zero signal is read-only.");
+            
             return m_samples;
         }
         
@@ -92,73 +163,36 @@ namespace kiwi
         sample_t& Signal::operator[](const size_t index)
         {
             assert(index < size() && "Index out of range.");
+            assert(!m_zero && "The zero signal is read-only.");
             
             return m_samples[index];
         }
         
         void Signal::fill(sample_t const& value) noexcept
         {
-            std::fill(m_samples, m_samples + m_size, value);
+            Kernels::get().fill(value, m_samples, m_size);
         }
         
         void Signal::copy(Signal const& other_signal) noexcept
         {
             assert(m_size == other_signal.size() && "Copying signals of different size");
             
-            sample_t const* in = other_signal.m_samples;
-            sample_t* out = m_samples;
-            
-            for(size_t i = m_size>>3; i; --i, in += 8, out += 8)
-            {
-                out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; out[3] = in[3];
-                out[4] = in[4]; out[5] = in[5]; out[6] = in[6]; out[7] = in[7];
-            }
-            for(size_t i = m_size&7; i; --i, in++, out++)
-            {
-                out[0] = in[0];
-            }
+            Kernels::get().copy(other_signal.m_samples, m_samples, m_size);
         }
         
         void Signal::add(Signal const& other_signal) noexcept
         {
             assert(m_size == other_signal.size() && "Adding signals of different size");
             
-            sample_t const* in = other_signal.m_samples;
-            sample_t* out = m_samples;
-            
-            for(size_t i = m_size>>3; i; --i, in += 8, out += 8)
-            {   
-                out[0] += in[0]; out[1] += in[1]; out[2] += in[2]; out[3] += in[3];
-                out[4] += in[4]; out[5] += in[5]; out[6] += in[6]; out[7] += in[7];
-            }
-            for(size_t i = m_size&7; i; --i, in++, out++)
-            {
-                out[0] += in[0];
-            }
+            Kernels::get().add(m_samples, other_signal.m_samples, m_samples, m_size);
         }
         
         void Signal::add(Signal const& signal_1, Signal const& signal_2, Signal& result)
         {
-            const size_t size = signal_1.size();
-            
-            assert(size == signal_2.size()
+            assert(signal_1.size() == signal_2.size() && signal_1.size() == result.size()
                    && "The two signals must have an equal size");
             
-            sample_t const* in1 = signal_1.m_samples;
-            sample_t const* in2 = signal_2.m_samples;
-            sample_t* out = result.m_samples;
-            
-            for(size_t i = size>>3; i; --i, in1 += 8, in2 += 8, out += 8)
-            {
-                out[0] = in1[0] + in2[0]; out[1] = in1[1] + in2[1];
-                out[2] = in1[2] + in2[2]; out[3] = in1[3] + in2[3];
-                out[4] = in1[4] + in2[4]; out[5] = in1[5] + in2[5];
-                out[6] = in1[6] + in2[6]; out[7] = in1[7] + in2[7];
-            }
-            for(size_t i = size&7; i; --i, in1++, in2++, out++)
-            {
-                out[0] = in1[0] + in2[0];
-            }
+            Kernels::get().add(signal_1.m_samples, signal_2.m_samples, result.m_samples, result.m_size);
         }
         
         // ================================================================================ //
@@ -259,6 +293,20 @@ namespace kiwi
             }
         }
 
+        void Buffer::setChannels(std::vector<Signal::sPtr> signals, const size_t vector_size)
+        {
+            m_signals = std::move(signals);
+            m_vectorsize = m_signals.empty() ? 0ul : vector_size;
+            
+#ifndef NDEBUG
+            for(Signal::sPtr const& signal : m_signals)
+            {
+                assert(vector_size != 0 && signal->size() % vector_size == 0
+                       && "Aggregating signals that are not multiple of the vector size");
+            }
+#endif
+        }
+        
         void Buffer::clear()
         {
             m_signals.clear();
@@ -292,5 +340,26 @@ namespace kiwi
             
             return *m_signals[index].get();
         }
+        
+        size_t Buffer::getNumberOfSignalChannels(const size_t index) const
+        {
+            assert(index < m_signals.size() && "Index out of range.");
+            
+            return m_vectorsize != 0 ? m_signals[index]->size() / m_vectorsize : 0ul;
+        }
+        
+        sample_t const* Buffer::getSignalChannel(const size_t index, const size_t channel) const
+        {
+            assert(channel < getNumberOfSignalChannels(index) && "Channel out of range.");
+            
+            return m_signals[index]->data() + channel * m_vectorsize;
+        }
+        
+        sample_t* Buffer::getSignalChannel(const size_t index, const size_t channel)
+        {
+            assert(channel < getNumberOfSignalChannels(index) && "Channel out of range.");
+            
+            return m_signals[index]->data() + channel * m_vectorsize;
+        }
     }
 }
@@ -35,7 +35,9 @@ namespace kiwi
         //! @brief A class that wraps a vector of sample_t.
         //! @details The class is a wrapper for a vector of sample_t values that offers optimized
         //! operations. The class also offers static methods to perform these operations
-        //! with other Signal objects.
+        //! with other Signal objects. The samples allocated by the Signal are aligned on
+        //! dsp::alignment bytes and padded with zeros to a multiple of dsp::alignment bytes.
+        //! @see Kernels
         class Signal
         {
         public: // methods
@@ -50,6 +52,13 @@ namespace kiwi
             //! @param val  The default value of the signal.
             Signal(const size_t size, const sample_t val = sample_t(0.));
             
+            //! @brief Constructs a Signal object that refers to external samples.
+            //! @details The Signal object doesn't own the samples and won't free them, the caller
+            //! must guarantee that the memory outlives the Signal object.
+            //! @param samples  The address of the samples.
+            //! @param size     The number of samples.
+            Signal(sample_t* samples, const size_t size) noexcept;
+            
             //! @brief Move constructor.
             //! @details Moves the content of a Signal object to a new one.
             //! The size of the other signal is set to 0 and its data are reset to nullptr.
@@ -66,6 +75,16 @@ namespace kiwi
             //! @details Frees the content of the Signal object if needed.
             ~Signal();
             
+            //! @brief Creates a read-only Signal object filled with zeros.
+            //! @details The chain binds the unconnected inlets to it so processors can recognise them
+            //! with isZero. The samples must never be written.
+            //! @param size The number of samples.
+            static sPtr createZero(const size_t size);
+            
+            //! @brief Returns true if the Signal object is a read-only signal filled with zeros.
+            //! @see createZero
+            bool isZero() const noexcept;
+            
             //! @brief Gets the number of samples that the Signal object currently holds.
             size_t size() const noexcept;
             
@@ -100,6 +119,8 @@ namespace kiwi
             
             size_t      m_size;
             sample_t*   m_samples;
+            bool        m_owner;
+            bool        m_zero;
             
         private: // deleted methods
             
@@ -163,6 +184,14 @@ namespace kiwi
             //! @param signals A vector of aggregated signals. Shall have same vectorsize.
             void setChannels(std::vector<Signal::sPtr> signals);
             
+            //! @brief Resets the entire buffer with new multichannel signals.
+            //! @details A multichannel signal holds its channels one after the other, each one being
+            //! vector_size samples long, so the size of each signal shall be a multiple of vector_size.
+            //! @param signals      A vector of aggregated signals.
+            //! @param vector_size  The number of samples of a channel.
+            //! @see getNumberOfSignalChannels
+            void setChannels(std::vector<Signal::sPtr> signals, const size_t vector_size);
+            
             //! @brief Clears buffers data. The resulting buffer will be empty.
             //! @brief If signal ownership was shared this method will release signal.
             void clear();
@@ -182,6 +211,16 @@ namespace kiwi
             //! @brief Gets the Signal object for a given channel.
             Signal& operator[](const size_t index);
             
+            //! @brief Gets the number of channels held by the Signal object of a given channel.
+            //! @see setChannels
+            size_t getNumberOfSignalChannels(const size_t index) const;
+            
+            //! @brief Gets the samples of a channel of the Signal object of a given channel.
+            sample_t const* getSignalChannel(const size_t index, const size_t channel) const;
+            
+            //! @brief Gets the samples of a channel of the Signal object of a given channel.
+            sample_t* getSignalChannel(const size_t index, const size_t channel);
+            
         private: // members
             
             size_t                      m_vectorsize;
@@ -0,0 +1,339 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include "KiwiDsp_ThreadPool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KIWI_DSP_PAUSE() _mm_pause()
+#else
+#define KIWI_DSP_PAUSE() std::this_thread::yield()
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <climits>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#elif !defined(_WIN32)
+#include <semaphore.h>
+#include <cerrno>
+#endif
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                  THREAD POOL SEMAPHORE                               //
+        // ==================================================================================== //
+        
+        //! @brief A counting semaphore of the system.
+        //! @details Unlike a condition variable, posting neither takes a lock nor allocates.
+        class ThreadPool::Semaphore final
+        {
+        public: // methods
+            
+            Semaphore()
+            {
+                #if defined(_WIN32)
+                m_semaphore = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr);
+                const bool created = m_semaphore != nullptr;
+                #elif defined(__APPLE__)
+                m_semaphore = dispatch_semaphore_create(0);
+                const bool created = m_semaphore != nullptr;
+                #else
+                const bool created = sem_init(&m_semaphore, 0, 0) == 0;
+                #endif
+                
+                if(!created)
+                {
+                    throw Error("The semaphore of a thread pool can't be created");
+                }
+            }
+            
+            ~Semaphore()
+            {
+                #if defined(_WIN32)
+                CloseHandle(m_semaphore);
+                #elif defined(__APPLE__)
+                dispatch_release(m_semaphore);
+                #else
+                sem_destroy(&m_semaphore);
+                #endif
+            }
+            
+            //! @brief Increments the count, waking up as many waiting threads.
+            void post(size_t count) noexcept
+            {
+                #if defined(_WIN32)
+                ReleaseSemaphore(m_semaphore, static_cast<LONG>(count), nullptr);
+                #else
+                while(count--)
+                {
+                    #if defined(__APPLE__)
+                    dispatch_semaphore_signal(m_semaphore);
+                    #else
+                    sem_post(&m_semaphore);
+                    #endif
+                }
+                #endif
+            }
+            
+            //! @brief Waits for the count to be positive and decrements it.
+            void wait() noexcept
+            {
+                #if defined(_WIN32)
+                WaitForSingleObject(m_semaphore, INFINITE);
+                #elif defined(__APPLE__)
+                dispatch_semaphore_wait(m_semaphore, DISPATCH_TIME_FOREVER);
+                #else
+                while(sem_wait(&m_semaphore) != 0 && errno == EINTR) {}
+                #endif
+            }
+            
+        private: // members
+            
+            #if defined(_WIN32)
+            HANDLE                  m_semaphore;
+            #elif defined(__APPLE__)
+            dispatch_semaphore_t    m_semaphore;
+            #else
+            sem_t                   m_semaphore;
+            #endif
+        };
+        
+        // ==================================================================================== //
+        //                                       THREAD POOL                                    //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            // The number of pauses a worker spins before sleeping, roughly a hundred microseconds.
+            const size_t spin_count = 4096ul;
+            
+            // The high bit of the joined counter closes the task to the late workers.
+            const size_t closed = size_t(1) << (std::numeric_limits<size_t>::digits - 1);
+            
+            // The pool whose task the thread performs and the index of the thread in this pool.
+            thread_local ThreadPool const* current_pool = nullptr;
+            thread_local size_t current_thread = 0ul;
+            
+            void setRealTimePriority(std::thread& thread) noexcept
+            {
+                // The priority is a best effort, the workers still run if the system refuses it.
+                
+                #if defined(_WIN32)
+                
+                SetThreadPriority(thread.native_handle(), THREAD_PRIORITY_TIME_CRITICAL);
+                
+                #elif defined(__unix__) || defined(__APPLE__)
+                
+                sched_param param;
+                param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+                pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+                
+                #endif
+            }
+        }
+        
+        ThreadPool::ThreadPool(size_t nthreads) :
+        m_workers(),
+        m_task(nullptr),
+        m_generation(0ul),
+        m_joined(closed),
+        m_sleepers(0ul),
+        m_running(true),
+        m_semaphore(new Semaphore())
+        {
+            if(nthreads == 0)
+            {
+                throw Error("A thread pool needs at least one thread");
+            }
+            
+            m_workers.reserve(nthreads - 1);
+            
+            for(size_t i = 1; i < nthreads; ++i)
+            {
+                m_workers.emplace_back(&ThreadPool::run, this, i);
+                setRealTimePriority(m_workers.back());
+            }
+        }
+        
+        ThreadPool::~ThreadPool()
+        {
+            m_running.store(false);
+            m_generation.fetch_add(1ul);
+            
+            wake();
+            
+            for(std::thread& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+        
+        size_t ThreadPool::getNumberOfThreads() const noexcept
+        {
+            return m_workers.size() + 1;
+        }
+        
+        void ThreadPool::pause() noexcept
+        {
+            KIWI_DSP_PAUSE();
+        }
+        
+        size_t ThreadPool::getCurrentThread() noexcept
+        {
+            return current_thread;
+        }
+        
+        void ThreadPool::perform(Task& task) noexcept
+        {
+            if(m_workers.empty() || current_pool == this)
+            {
+                task.perform(0);
+                return;
+            }
+            
+            ThreadPool const* const previous_pool = current_pool;
+            const size_t previous_thread = current_thread;
+            
+            current_pool = this;
+            current_thread = 0ul;
+            
+            // publishes the task then wakes up the sleeping workers.
+            m_task.store(&task, std::memory_order_relaxed);
+            m_joined.store(0ul, std::memory_order_release);
+            m_generation.fetch_add(1ul);
+            
+            wake();
+            
+            task.perform(0);
+            
+            // closes the task and waits for the workers that joined it.
+            m_joined.fetch_or(closed, std::memory_order_acq_rel);
+            
+            while(m_joined.load(std::memory_order_acquire) != closed)
+            {
+                pause();
+            }
+            
+            current_pool = previous_pool;
+            current_thread = previous_thread;
+        }
+        
+        void ThreadPool::wake() noexcept
+        {
+            // the counts are exchanged so that a sleeping worker is posted once. A post can wake up
+            // another sleeping worker: it sleeps again if the generation didn't change and is counted.
+            if(m_sleepers.load() != 0ul)
+            {
+                const size_t sleepers = m_sleepers.exchange(0ul);
+                
+                if(sleepers != 0ul)
+                {
+                    m_semaphore->post(sleepers);
+                }
+            }
+        }
+        
+        void ThreadPool::run(size_t thread) noexcept
+        {
+            size_t generation = 0ul;
+            
+            current_pool = this;
+            current_thread = thread;
+            
+            while(m_running.load(std::memory_order_relaxed))
+            {
+                // ==================================================================== //
+                //                          WAIT FOR A TASK                             //
+                // ==================================================================== //
+                
+                for(size_t i = 0; i < spin_count && m_generation.load(std::memory_order_relaxed) == generation; ++i)
+                {
+                    pause();
+                }
+                
+                while(m_generation.load() == generation)
+                {
+                    // the worker counts itself before it checks the generation a last time, so either
+                    // it sees the new generation or the thread that published it posts for it.
+                    m_sleepers.fetch_add(1ul);
+                    
+                    if(m_generation.load() == generation)
+                    {
+                        m_semaphore->wait();
+                    }
+                    else
+                    {
+                        // takes its count back, or consumes the post made for it if it's already taken.
+                        size_t sleepers = m_sleepers.load();
+                        
+                        while(sleepers != 0ul && !m_sleepers.compare_exchange_weak(sleepers, sleepers - 1ul)) {}
+                        
+                        if(sleepers == 0ul)
+                        {
+                            m_semaphore->wait();
+                        }
+                    }
+                }
+                
+                generation = m_generation.load();
+                
+                if(!m_running.load())
+                {
+                    break;
+                }
+                
+                // ==================================================================== //
+                //                      JOIN THE TASK IF STILL OPENED                   //
+                // ==================================================================== //
+                
+                size_t joined = m_joined.load(std::memory_order_relaxed);
+                
+                do
+                {
+                    if(joined & closed)
+                    {
+                        break;
+                    }
+                }
+                while(!m_joined.compare_exchange_weak(joined, joined + 1,
+                                                      std::memory_order_acquire,
+                                                      std::memory_order_relaxed));
+                
+                if(!(joined & closed))
+                {
+                    m_task.load(std::memory_order_relaxed)->perform(thread);
+                    m_joined.fetch_sub(1ul, std::memory_order_release);
+                }
+            }
+        }
+    }
+}
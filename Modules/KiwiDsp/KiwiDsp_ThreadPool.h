@@ -0,0 +1,233 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <thread>
+#include <memory>
+
+#include "KiwiDsp_Misc.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                       THREAD POOL                                    //
+        // ==================================================================================== //
+        
+        //! @brief A fixed set of worker threads that helps the audio thread to perform a task.
+        //! @details The workers are created once with a real-time priority when the system allows it.
+        //! Between two tasks they spin for a short while and then sleep on a semaphore until the next
+        //! task is published. The audio thread wakes them without a lock and never waits for a worker
+        //! to wake up: the workers join the task when they are ready and leave it when the task's work
+        //! is done.
+        //! @see Chain
+        class ThreadPool final
+        {
+        public: // classes
+            
+            //! @brief The work shared by the threads of the pool.
+            //! @details The perform method is called concurrently by the calling thread with the index 0
+            //! and by the workers with the indices 1 to getNumberOfThreads() - 1. It must return once all the
+            //! work is done, the calling thread's call is guaranteed to happen but the workers' calls are not.
+            class Task
+            {
+            public:
+                
+                virtual ~Task() = default;
+                
+                virtual void perform(size_t thread) noexcept = 0;
+            };
+            
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details The number of threads shouldn't exceed the number of cores.
+            //! @param nthreads The number of threads that perform the tasks including the calling thread.
+            //! @exception Error if the number of threads is zero.
+            ThreadPool(size_t nthreads);
+            
+            //! @brief Destructor.
+            //! @details Stops and joins the workers.
+            ~ThreadPool();
+            
+            //! @brief Gets the number of threads including the calling thread.
+            size_t getNumberOfThreads() const noexcept;
+            
+            //! @brief Performs a task on the calling thread and on the available workers.
+            //! @details Returns once the calling thread has performed the task and no worker performs it
+            //! anymore. Must not be called concurrently, except by the threads that perform a task of the
+            //! pool: they perform the nested task alone with the index 0, so chains that share the pool
+            //! can be ticked by its tasks.
+            void perform(Task& task) noexcept;
+            
+            //! @brief Gets the index of the calling thread in the pool whose task it performs.
+            //! @details The index is the one of the outermost task, 0 for the thread that called perform
+            //! and for the threads that don't perform any task.
+            static size_t getCurrentThread() noexcept;
+            
+            //! @brief Hints the processor that the calling thread is spinning.
+            static void pause() noexcept;
+            
+        private: // classes
+            
+            class Semaphore;
+            
+        private: // methods
+            
+            //! @brief The loop of the workers.
+            void run(size_t thread) noexcept;
+            
+            //! @brief Wakes up the workers that sleep or are about to sleep.
+            void wake() noexcept;
+            
+        private: // members
+            
+            std::vector<std::thread>    m_workers;
+            std::atomic<Task*>          m_task;
+            std::atomic<size_t>         m_generation;
+            std::atomic<size_t>         m_joined;
+            std::atomic<size_t>         m_sleepers;
+            std::atomic<bool>           m_running;
+            std::unique_ptr<Semaphore>  m_semaphore;
+            
+        private: // deleted methods
+            
+            ThreadPool(ThreadPool const& other) = delete;
+            ThreadPool(ThreadPool && other) = delete;
+            ThreadPool& operator=(ThreadPool const& other) = delete;
+            ThreadPool& operator=(ThreadPool && other) = delete;
+        };
+        
+        // ==================================================================================== //
+        //                                      STEALING QUEUE                                  //
+        // ==================================================================================== //
+        
+        //! @brief A lock-free work stealing queue.
+        //! @details The owner thread pushes and pops at the bottom while the other threads steal at
+        //! the top (Chase-Lev). The queue doesn't wrap around: it must be reset when nobody uses it and
+        //! it can hold as many pushes as its capacity between two resets.
+        template<class TItem>
+        class StealingQueue final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            StealingQueue() : m_items(), m_capacity(0), m_top(0), m_bottom(0) {}
+            
+            //! @brief Empties the queue and makes it able to receive capacity pushes.
+            //! @details Allocates only if the capacity grows.
+            void reset(const size_t capacity)
+            {
+                if(capacity > m_capacity)
+                {
+                    m_items.reset(new std::atomic<TItem*>[capacity]);
+                    m_capacity = capacity;
+                }
+                
+                m_top.store(0, std::memory_order_relaxed);
+                m_bottom.store(0, std::memory_order_relaxed);
+            }
+            
+            //! @brief Pushes an item at the bottom. Called by the owner.
+            void push(TItem* item) noexcept
+            {
+                const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+                assert(static_cast<size_t>(bottom) < m_capacity);
+                
+                m_items[bottom].store(item, std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_release);
+            }
+            
+            //! @brief Pops an item from the bottom or returns nullptr. Called by the owner.
+            TItem* pop() noexcept
+            {
+                const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+                m_bottom.store(bottom, std::memory_order_relaxed);
+                
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                
+                int64_t top = m_top.load(std::memory_order_relaxed);
+                
+                if(top > bottom)
+                {
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                
+                TItem* item = m_items[bottom].load(std::memory_order_relaxed);
+                
+                if(top == bottom)
+                {
+                    // the last item can be stolen concurrently.
+                    if(!m_top.compare_exchange_strong(top, top + 1,
+                                                      std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed))
+                    {
+                        item = nullptr;
+                    }
+                    
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                }
+                
+                return item;
+            }
+            
+            //! @brief Steals an item from the top or returns nullptr. Called by any thread.
+            TItem* steal() noexcept
+            {
+                int64_t top = m_top.load(std::memory_order_acquire);
+                
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                
+                const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+                
+                if(top < bottom)
+                {
+                    TItem* item = m_items[top].load(std::memory_order_relaxed);
+                    
+                    if(m_top.compare_exchange_strong(top, top + 1,
+                                                     std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed))
+                    {
+                        return item;
+                    }
+                }
+                
+                return nullptr;
+            }
+            
+        private: // members
+            
+            std::unique_ptr<std::atomic<TItem*>[]>  m_items;
+            size_t                                  m_capacity;
+            std::atomic<int64_t>                    m_top;
+            std::atomic<int64_t>                    m_bottom;
+            
+        private: // deleted methods
+            
+            StealingQueue(StealingQueue const& other) = delete;
+            StealingQueue& operator=(StealingQueue const& other) = delete;
+        };
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <array>
+#include <mutex>
+
+#include "KiwiDsp_Wavetable.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      WAVETABLE                                       //
+        // ==================================================================================== //
+        
+        namespace
+        {
+            const size_t min_resolution = 6ul;
+            const size_t max_resolution = 16ul;
+            
+            std::atomic<double> engine_quality(120.);
+            
+            // the error of a linear interpolation of the cosine is at most the square of the step over 8.
+            double getQualityOfResolution(size_t resolution) noexcept
+            {
+                const double step = 2. * pi / static_cast<double>(size_t(1) << resolution);
+                return -20. * std::log10(step * step / 8.);
+            }
+        }
+        
+        Wavetable::Wavetable(size_t resolution) :
+        m_resolution(resolution),
+        m_points(new sample_t[(size_t(1) << resolution) + 1ul]),
+        m_lookup(Kernels::get().lookup)
+        {
+            const size_t size = size_t(1) << resolution;
+            
+            for(size_t i = 0; i < size; ++i)
+            {
+                m_points[i] = static_cast<sample_t>(std::cos(2. * pi * static_cast<double>(i) / static_cast<double>(size)));
+            }
+            
+            m_points[size] = m_points[0];
+        }
+        
+        Wavetable const& Wavetable::getCosine(double quality)
+        {
+            static std::array<std::unique_ptr<Wavetable>, max_resolution + 1> tables;
+            static std::mutex mutex;
+            
+            size_t resolution = min_resolution;
+            
+            while(resolution < max_resolution && getQualityOfResolution(resolution) < quality)
+            {
+                ++resolution;
+            }
+            
+            std::lock_guard<std::mutex> lock(mutex);
+            
+            if(tables[resolution] == nullptr)
+            {
+                tables[resolution].reset(new Wavetable(resolution));
+            }
+            
+            return *tables[resolution];
+        }
+        
+        Wavetable const& Wavetable::getCosine()
+        {
+            return getCosine(getQuality());
+        }
+        
+        void Wavetable::setQuality(double quality) noexcept
+        {
+            engine_quality.store(quality, std::memory_order_relaxed);
+        }
+        
+        double Wavetable::getQuality() noexcept
+        {
+            return engine_quality.load(std::memory_order_relaxed);
+        }
+        
+        size_t Wavetable::getResolution() const noexcept
+        {
+            return m_resolution;
+        }
+        
+        size_t Wavetable::getSize() const noexcept
+        {
+            return size_t(1) << m_resolution;
+        }
+        
+        double Wavetable::getTableQuality() const noexcept
+        {
+            return getQualityOfResolution(m_resolution);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "KiwiDsp_Kernels.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      WAVETABLE                                       //
+        // ==================================================================================== //
+        
+        //! @brief A shared table of a period of cosine read at fixed point phases.
+        //! @details A phase is an unsigned 32-bit integer whose whole range is a period, so the phases
+        //! wrap without a test and accumulate without drift. The table is interpolated linearly and its
+        //! size is chosen for a quality, the ratio between the full scale and the worst interpolation
+        //! error in decibels. The tables are generated once per size, the first time they are got, and
+        //! are kept until the program exits. They should be got at prepare time and then only read.
+        //! @see Kernels::lookup
+        class Wavetable final
+        {
+        public: // classes
+            
+            //! @brief The fixed point phase, a period is 2^32.
+            using phase_t = uint32_t;
+            
+        public: // methods
+            
+            //! @brief Gets the cosine table of a quality in decibels.
+            //! @details The quality is clipped to the range of the tables, from 6 to 16 bits of resolution.
+            static Wavetable const& getCosine(double quality);
+            
+            //! @brief Gets the cosine table of the engine-wide quality.
+            //! @see setQuality
+            static Wavetable const& getCosine();
+            
+            //! @brief Sets the engine-wide quality of the tables in decibels.
+            //! @details The oscillators get their table when they are prepared. By default the quality is
+            //! 120dB, a table of 4096 points that is read faster than the cosine of a single precision sample.
+            static void setQuality(double quality) noexcept;
+            
+            //! @brief Gets the engine-wide quality of the tables in decibels.
+            static double getQuality() noexcept;
+            
+            //! @brief Converts a phase in periods to a fixed point phase.
+            //! @details The phase can be negative or greater than a period.
+            static inline phase_t toPhase(double periods) noexcept
+            {
+                return static_cast<phase_t>(static_cast<int64_t>((periods - std::floor(periods)) * 4294967296.));
+            }
+            
+            //! @brief Converts a fixed point phase to a phase in periods, from 0 to 1 excluded.
+            static inline sample_t toPeriods(phase_t phase) noexcept
+            {
+                // the bits that a sample can't hold are dropped so the phase can't be rounded to 1.
+                const int shift = std::numeric_limits<sample_t>::digits < 32 ? 32 - std::numeric_limits<sample_t>::digits : 0;
+                return static_cast<sample_t>(phase >> shift) / static_cast<sample_t>(uint64_t(1) << (32 - shift));
+            }
+            
+            //! @brief Gets the number of bits of the index of the points.
+            size_t getResolution() const noexcept;
+            
+            //! @brief Gets the number of points of a period.
+            size_t getSize() const noexcept;
+            
+            //! @brief Gets the quality of the table in decibels.
+            double getTableQuality() const noexcept;
+            
+            //! @brief Reads the table at a phase.
+            inline sample_t read(phase_t phase) const noexcept
+            {
+                sample_t result;
+                m_lookup(m_points.get(), m_resolution, &phase, &result, 1ul);
+                return result;
+            }
+            
+            //! @brief Reads the table at the phases of a vector with the best kernel.
+            inline void read(phase_t const* phases, sample_t* out, size_t size) const noexcept
+            {
+                m_lookup(m_points.get(), m_resolution, phases, out, size);
+            }
+            
+        private: // methods
+            
+            //! @brief Constructor.
+            Wavetable(size_t resolution);
+            
+        private: // members
+            
+            const size_t                m_resolution;
+            std::unique_ptr<sample_t[]> m_points;
+            Kernels::lookup_t           m_lookup;
+            
+        private: // deleted methods
+            
+            Wavetable(Wavetable const& other) = delete;
+            Wavetable(Wavetable && other) = delete;
+            Wavetable& operator=(Wavetable const& other) = delete;
+            Wavetable& operator=(Wavetable && other) = delete;
+        };
+    }
+}
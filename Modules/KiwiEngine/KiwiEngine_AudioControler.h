@@ -63,6 +63,9 @@ namespace kiwi
             //! @brief Gets a signal from one of the input channels of the AudioControler.
             virtual void getFromChannel(size_t const channel, dsp::Signal & input_signal) = 0;
             
+            //! @brief Returns the number of output channels of the AudioControler.
+            virtual size_t getNumberOfOutputChannels() const = 0;
+            
         private: // deleted methods
             
             AudioControler(AudioControler const& other) = delete;
@@ -30,19 +30,33 @@ namespace kiwi
         //                                      INSTANCE                                    //
         // ================================================================================ //
         
-        Instance::Instance(std::unique_ptr<AudioControler> audio_controler, tool::Scheduler<> & main_scheduler):
+        Instance::Instance(std::unique_ptr<AudioControler> audio_controler,
+                           tool::Scheduler<> & main_scheduler,
+                           bool logical_time):
         m_audio_controler(std::move(audio_controler)),
         m_scheduler(),
         m_main_scheduler(main_scheduler),
         m_quit(false),
-        m_engine_thread(std::bind(&Instance::processScheduler, this))
+        m_engine_thread()
         {
+            if(logical_time)
+            {
+                m_scheduler.setLogicalTime(tool::Scheduler<>::time_point_t());
+            }
+            else
+            {
+                m_engine_thread = std::thread(std::bind(&Instance::processScheduler, this));
+            }
         }
         
         Instance::~Instance()
         {
             m_quit.store(true);
-            m_engine_thread.join();
+            
+            if(m_engine_thread.joinable())
+            {
+                m_engine_thread.join();
+            }
         }
         
         // ================================================================================ //
@@ -102,6 +116,12 @@ namespace kiwi
             return m_main_scheduler;
         }
         
+        void Instance::advanceTime(tool::Scheduler<>::duration_t duration)
+        {
+            m_scheduler.setLogicalTime(m_scheduler.now() + duration);
+            m_scheduler.process();
+        }
+        
         void Instance::processScheduler()
         {
             m_scheduler.setThreadAsConsumer();
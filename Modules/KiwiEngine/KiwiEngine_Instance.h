@@ -48,7 +48,11 @@ namespace kiwi
         public: // methods
             
             //! @brief Constructs an Instance and adds the engine objects to the engine::Factory.
-            Instance(std::unique_ptr<AudioControler> audio_controler, tool::Scheduler<> & main_scheduler);
+            //! @details If logical_time is true, no engine thread is started. The calling thread becomes
+            //! the consumer of the engine's scheduler and its time only moves forward with advanceTime.
+            Instance(std::unique_ptr<AudioControler> audio_controler,
+                     tool::Scheduler<> & main_scheduler,
+                     bool logical_time = false);
             
             //! @brief Destructor.
             ~Instance();
@@ -91,6 +95,10 @@ namespace kiwi
             //! @brief Returns the main's scheduler.
             tool::Scheduler<> & getMainScheduler();
             
+            //! @brief Moves the logical time of the engine's scheduler forward and processes its tasks.
+            //! @details Shall only be called by the thread that constructed an Instance with a logical time.
+            void advanceTime(tool::Scheduler<>::duration_t duration);
+            
         private: // methods
             
             //! @internal Processes the scheduler to check if new messages have been added.
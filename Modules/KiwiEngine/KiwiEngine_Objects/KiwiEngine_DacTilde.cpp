@@ -51,9 +51,51 @@ namespace kiwi { namespace engine {
         }
     }
     
+    void DacTilde::performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::Kernels const& kernels = dsp::Kernels::get();
+        dsp::sample_t* samples = m_channel->data();
+        const size_t vector_size = m_channel->size();
+        const size_t noutputs = m_audio_controler.getNumberOfOutputChannels();
+        
+        for (size_t inlet = 0; inlet < m_routes.size(); ++inlet)
+        {
+            const size_t route = m_routes[inlet];
+            
+            if(m_channels[inlet] > 1)
+            {
+                // the channel i of the cord is sent to the route + i, the channels beyond the device are dropped.
+                const size_t nchannels = route < noutputs ? std::min(m_channels[inlet], noutputs - route) : 0ul;
+                
+                for(size_t channel = 0; channel < nchannels; ++channel)
+                {
+                    kernels.copy(input.getSignalChannel(inlet, channel), samples, vector_size);
+                    m_audio_controler.addToChannel(route + channel, *m_channel);
+                }
+            }
+            else
+            {
+                m_audio_controler.addToChannel(route, input[inlet]);
+            }
+        }
+    }
+    
     void DacTilde::prepare(dsp::Processor::PrepareInfo const& infos)
     {
-        setPerformCallBack(this, &DacTilde::perform);
+        // adding silent inputs to the channels does nothing.
+        setTail(0);
+        
+        m_channels = infos.channels;
+        
+        if(std::any_of(m_channels.begin(), m_channels.end(), [](size_t nchannels) {return nchannels > 1;}))
+        {
+            m_channel.reset(new dsp::Signal(infos.vector_size));
+            setPerformCallBack(this, &DacTilde::performChannels);
+        }
+        else
+        {
+            setPerformCallBack(this, &DacTilde::perform);
+        }
     }
     
 }}
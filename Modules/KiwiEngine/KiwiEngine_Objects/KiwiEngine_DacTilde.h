@@ -41,6 +41,14 @@ namespace kiwi { namespace engine {
         
         void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
+        //! @brief Performs with multichannel inputs, spread from their route to the next audio channels.
+        void performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
+        
+    private: // members
+        
+        std::vector<size_t>             m_channels;
+        std::unique_ptr<dsp::Signal>    m_channel;
     };
 }}
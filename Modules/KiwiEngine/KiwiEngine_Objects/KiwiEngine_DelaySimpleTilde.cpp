@@ -50,6 +50,7 @@ namespace kiwi { namespace engine {
     m_delay(1.),
     m_reinject_level(0.),
     m_sr(0.),
+    m_buffer_size(0),
     m_pool()
     {
         std::vector<tool::Atom> const& args = model.getArguments();
@@ -133,6 +134,7 @@ namespace kiwi { namespace engine {
             if (args[0].isNumber())
             {
                 m_reinject_level.store(std::max(0., std::min(1., args[0].getFloat())));
+                updateTail();
             }
             else
             {
@@ -141,6 +143,19 @@ namespace kiwi { namespace engine {
         }
     }
     
+    void DelaySimpleTilde::updateTail()
+    {
+        // the silence never reaches the end of the buffer once reinjected.
+        if(m_reinject_level.load() == 0.)
+        {
+            setTail(m_buffer_size.load());
+        }
+        else
+        {
+            setTail(dsp::Processor::infinite_tail);
+        }
+    }
+    
     dsp::sample_t DelaySimpleTilde::cubicInterpolate(float const& x,
                                                      float const& y0,
                                                      float const& y1,
@@ -220,6 +235,9 @@ namespace kiwi { namespace engine {
         
         m_reinject_signal.reset(new dsp::Signal(vector_size));
         
+        m_buffer_size.store(buffer_size);
+        updateTail();
+        
         if (infos.inputs.size() > 1 && infos.inputs[1])
         {
             setPerformCallBack(this, &DelaySimpleTilde::performDelay);
@@ -85,6 +85,9 @@ namespace kiwi { namespace engine {
         
     private: // methods
         
+        //! @brief Declares the length of the buffer as tail unless the delay feeds back on itself.
+        void updateTail();
+        
         dsp::sample_t cubicInterpolate(float const& x,
                                        float const& y0,
                                        float const& y1,
@@ -99,6 +102,7 @@ namespace kiwi { namespace engine {
         std::atomic<float>                  m_delay;
         std::atomic<float>                  m_reinject_level;
         dsp::sample_t                       m_sr;
+        std::atomic<size_t>                 m_buffer_size;
         ReleasePool                         m_pool;
         mutable std::mutex                  m_mutex;
     };
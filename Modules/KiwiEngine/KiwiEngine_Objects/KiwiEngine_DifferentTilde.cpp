@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void DifferentTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void DifferentTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs != rhs ? 1. : 0.;
+        dsp::Kernels::get().notEqual(lhs, rhs, result, size);
+    }
+    
+    void DifferentTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().notEqualValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation DifferentTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::NotEqual;
     }
     
 }}
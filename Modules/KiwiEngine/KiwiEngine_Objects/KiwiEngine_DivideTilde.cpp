@@ -47,9 +47,24 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void DivideTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void DivideTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = rhs != 0 ? lhs / rhs : 0.;
+        dsp::Kernels::get().div(lhs, rhs, result, size);
+    }
+    
+    void DivideTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().divValue(lhs, rhs, result, size);
+    }
+    
+    bool DivideTilde::absorbsZero() const noexcept
+    {
+        return true;
+    }
+    
+    dsp::Kernels::Operation DivideTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Div;
     }
     
 }}
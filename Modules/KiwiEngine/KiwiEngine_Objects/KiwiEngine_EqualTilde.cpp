@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void EqualTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void EqualTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs == rhs ? 1 : 0;
+        dsp::Kernels::get().equal(lhs, rhs, result, size);
+    }
+    
+    void EqualTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().equalValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation EqualTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Equal;
     }
     
 }}
@@ -39,7 +39,11 @@ namespace kiwi { namespace engine {
         
         EqualTilde(model::Object const& model, Patcher& patcher);
         
-        void compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs);
+        void computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept;
+        
+        void computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept;
+        
+        dsp::Kernels::Operation getOperation() const noexcept;
     };
 
 }}
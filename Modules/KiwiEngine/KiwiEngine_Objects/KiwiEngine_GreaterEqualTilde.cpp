@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void GreaterEqualTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void GreaterEqualTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs >= rhs ? 1 : 0;
+        dsp::Kernels::get().greaterEqual(lhs, rhs, result, size);
+    }
+    
+    void GreaterEqualTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().greaterEqualValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation GreaterEqualTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::GreaterEqual;
     }
     
 }}
@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void GreaterTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void GreaterTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs > rhs ? 1 : 0;
+        dsp::Kernels::get().greater(lhs, rhs, result, size);
+    }
+    
+    void GreaterTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().greaterValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation GreaterTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Greater;
     }
     
 }}
@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void LessEqualTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void LessEqualTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs <= rhs ? 1 : 0;
+        dsp::Kernels::get().lessEqual(lhs, rhs, result, size);
+    }
+    
+    void LessEqualTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().lessEqualValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation LessEqualTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::LessEqual;
     }
     
 }}
@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void LessTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void LessTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs < rhs ? 1 : 0;
+        dsp::Kernels::get().less(lhs, rhs, result, size);
+    }
+    
+    void LessTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().lessValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation LessTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Less;
     }
     
 }}
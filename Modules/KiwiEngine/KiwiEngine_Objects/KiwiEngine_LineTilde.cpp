@@ -159,16 +159,23 @@ namespace kiwi{ namespace engine {
     LineTilde::LineTilde(model::Object const& model, Patcher& patcher)
     : AudioObject(model, patcher)
     , m_bang_task(std::make_shared<BangTask>(*this))
-    , m_ramp(0.)
+    , m_ramps()
     {
         std::vector<tool::Atom> const& args = model.getArguments();
         
-        if (!args.empty() && args[0].isNumber())
+        // a ramp has a channel per initial value.
+        for(tool::Atom const& arg : args)
         {
-            m_ramp.setValueDirect(args[0].getFloat());
+            m_ramps.emplace_back(new Ramp(arg.getFloat()));
         }
         
-        m_ramp.setEndOfRampCallback([this]{
+        if (m_ramps.empty())
+        {
+            m_ramps.emplace_back(new Ramp(0.));
+        }
+        
+        // the ramps reach their destinations together, the first one notifies it.
+        m_ramps[0]->setEndOfRampCallback([this]{
             getScheduler().defer(m_bang_task);
         });
     }
@@ -209,6 +216,71 @@ namespace kiwi{ namespace engine {
         return value_time_pairs;
     }
     
+    void LineTilde::setValueTimePairs(std::vector<Ramp::ValueTimePair> const& value_time_pairs)
+    {
+        for(std::unique_ptr<Ramp>& ramp : m_ramps)
+        {
+            ramp->setValueTimePairs(value_time_pairs);
+        }
+    }
+    
+    void LineTilde::setValueDirect(dsp::sample_t value) noexcept
+    {
+        for(std::unique_ptr<Ramp>& ramp : m_ramps)
+        {
+            ramp->setValueDirect(value);
+        }
+    }
+    
+    void LineTilde::setChannelDestinations(std::vector<tool::Atom> const& atoms)
+    {
+        const size_t nchannels = m_ramps.size();
+        
+        if((atoms.size() != nchannels && atoms.size() != nchannels + 1)
+           || !std::all_of(atoms.begin(), atoms.end(), [](tool::Atom const& atom) {return atom.isNumber();}))
+        {
+            error("line~ channels expects a destination number per channel followed by an optional ramp time");
+            return;
+        }
+        
+        double time_ms = 0.;
+        
+        if(atoms.size() > nchannels)
+        {
+            time_ms = atoms[nchannels].getFloat();
+            
+            if(time_ms < 0.)
+            {
+                error("line~ do not accepts negative ramp time");
+                return;
+            }
+        }
+        else if(!m_next_ramp_time_consumed)
+        {
+            time_ms = m_next_ramp_time_ms;
+            m_next_ramp_time_consumed = true;
+        }
+        else
+        {
+            for(size_t channel = 0; channel < nchannels; ++channel)
+            {
+                m_ramps[channel]->setValueDirect(atoms[channel].getFloat());
+            }
+            
+            return;
+        }
+        
+        for(size_t channel = 0; channel < nchannels; ++channel)
+        {
+            Ramp::ValueTimePair pair {
+                (dsp::sample_t) atoms[channel].getFloat(),
+                (dsp::sample_t) time_ms
+            };
+            
+            m_ramps[channel]->setValueTimePairs({std::move(pair)});
+        }
+    }
+    
     void LineTilde::receive(size_t index, std::vector<tool::Atom> const& args)
     {
         if (!args.empty())
@@ -223,7 +295,7 @@ namespace kiwi{ namespace engine {
                         
                         if(!value_time_pairs.empty())
                         {
-                            m_ramp.setValueTimePairs(value_time_pairs);
+                            setValueTimePairs(value_time_pairs);
                         }
                     }
                     else
@@ -235,12 +307,12 @@ namespace kiwi{ namespace engine {
                                 (dsp::sample_t) m_next_ramp_time_ms
                             };
                             
-                            m_ramp.setValueTimePairs({std::move(pair)});
+                            setValueTimePairs({std::move(pair)});
                             m_next_ramp_time_consumed = true;
                         }
                         else
                         {
-                            m_ramp.setValueDirect(args[0].getFloat());
+                            setValueDirect(args[0].getFloat());
                         }
                     }
                 }
@@ -253,6 +325,11 @@ namespace kiwi{ namespace engine {
                     }
                 }
             }
+            else if(index == 0 && args[0].isString() && args[0].getString() == "channels")
+            {
+                // a destination per channel, followed by an optional ramp time.
+                setChannelDestinations(std::vector<tool::Atom>(args.begin() + 1, args.end()));
+            }
             else
             {
                 warning("line~ inlet " + std::to_string(index + 1) + " parameter must be a number");
@@ -280,18 +357,47 @@ namespace kiwi{ namespace engine {
     
     void LineTilde::prepare(PrepareInfo const& infos)
     {
-        m_ramp.setSampleRate((double) infos.sample_rate);
-        setPerformCallBack(this, &LineTilde::perform);
+        for(std::unique_ptr<Ramp>& ramp : m_ramps)
+        {
+            ramp->setSampleRate((double) infos.sample_rate);
+        }
+        
+        if(m_ramps.size() > 1)
+        {
+            setOutputChannels(0, m_ramps.size());
+            setPerformCallBack(this, &LineTilde::performChannels);
+        }
+        else
+        {
+            setPerformCallBack(this, &LineTilde::perform);
+        }
     }
     
     void LineTilde::perform(dsp::Buffer const&, dsp::Buffer& output) noexcept
     {
         size_t sampleframes = output[0ul].size();
         dsp::sample_t* out = output[0ul].data();
+        Ramp& ramp = *m_ramps[0];
         
         while(sampleframes--)
         {
-            *out++ = m_ramp.getNextValue();
+            *out++ = ramp.getNextValue();
+        }
+    }
+    
+    void LineTilde::performChannels(dsp::Buffer const&, dsp::Buffer& output) noexcept
+    {
+        const size_t vector_size = output[0ul].size() / m_ramps.size();
+        
+        for(size_t channel = 0; channel < m_ramps.size(); ++channel)
+        {
+            dsp::sample_t* out = output.getSignalChannel(0ul, channel);
+            Ramp& ramp = *m_ramps[channel];
+            
+            for(size_t i = 0; i < vector_size; ++i)
+            {
+                out[i] = ramp.getNextValue();
+            }
         }
     }
     
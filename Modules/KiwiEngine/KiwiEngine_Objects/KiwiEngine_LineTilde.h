@@ -23,6 +23,7 @@
 
 #include <KiwiEngine/KiwiEngine_Object.h>
 
+#include <algorithm>
 #include <queue>
 
 namespace kiwi { namespace engine {
@@ -117,10 +118,20 @@ namespace kiwi { namespace engine {
         
         void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
+        //! @brief Performs the channels of a multichannel ramp.
+        void performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
     private: // methods
         
         std::vector<Ramp::ValueTimePair> parseAtomsAsValueTimePairs(std::vector<tool::Atom> const& atoms) const;
         
+        void setValueTimePairs(std::vector<Ramp::ValueTimePair> const& value_time_pairs);
+        
+        void setValueDirect(dsp::sample_t value) noexcept;
+        
+        //! @brief Sets a destination per channel, reached in the time that follows them if any.
+        void setChannelDestinations(std::vector<tool::Atom> const& atoms);
+        
     private: // variables
         
         class BangTask;
@@ -129,7 +140,8 @@ namespace kiwi { namespace engine {
         double m_next_ramp_time_ms;
         bool m_next_ramp_time_consumed;
         
-        Ramp m_ramp;
+        //! @brief A ramp per channel, they reach their destinations in the same time.
+        std::vector<std::unique_ptr<Ramp>> m_ramps;
     };
     
 }}
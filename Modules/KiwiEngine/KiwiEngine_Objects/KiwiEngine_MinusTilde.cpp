@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void MinusTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void MinusTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs - rhs;
+        dsp::Kernels::get().sub(lhs, rhs, result, size);
+    }
+    
+    void MinusTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().subValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation MinusTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Sub;
     }
     
 }}
@@ -43,11 +43,14 @@ namespace kiwi { namespace engine {
     NoiseTilde::NoiseTilde(model::Object const& model,
                            Patcher& patcher)
     : AudioObject(model, patcher)
-    , m_random_devive()
-    , m_random_generator(m_random_devive())
-    , m_random_distribution(-1., 1.)
+    , m_random()
     {
-        ;
+        std::vector<tool::Atom> const& args = model.getArguments();
+        
+        if (!args.empty() && args[0].isNumber())
+        {
+            m_random.seed(static_cast<uint64_t>(args[0].getInt()));
+        }
     }
     
     void NoiseTilde::receive(size_t index, std::vector<tool::Atom> const& args)
@@ -57,13 +60,7 @@ namespace kiwi { namespace engine {
     
     void NoiseTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t frames = output[0].size();
-        dsp::sample_t* out = output[0].data();
-        
-        while(frames--)
-        {
-            *out++ = m_random_distribution(m_random_generator);
-        }
+        m_random.fill(output[0].data(), output[0].size(), -1., 1.);
     }
     
     void NoiseTilde::prepare(dsp::Processor::PrepareInfo const& infos)
@@ -23,7 +23,7 @@
 
 #include <KiwiEngine/KiwiEngine_Object.h>
 
-#include <random>
+#include <KiwiTool/KiwiTool_Random.h>
 
 namespace kiwi { namespace engine {
     
@@ -31,6 +31,9 @@ namespace kiwi { namespace engine {
     //                                     NOISE~                                       //
     // ================================================================================ //
     
+    //! @brief A white noise in [-1, 1).
+    //! @details The argument seeds the generator, otherwise it's seeded by the global sequence.
+    //! @see tool::Random
     class NoiseTilde : public AudioObject
     {
     public: // methods
@@ -49,9 +52,7 @@ namespace kiwi { namespace engine {
         
     private: // members
         
-        std::random_device                              m_random_devive;
-        std::mt19937                                    m_random_generator;
-        std::uniform_real_distribution<dsp::sample_t>   m_random_distribution;
+        tool::Random m_random;
     };
     
 }}
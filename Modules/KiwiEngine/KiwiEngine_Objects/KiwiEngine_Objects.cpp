@@ -0,0 +1,90 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Objects.h>
+
+namespace kiwi
+{
+    namespace engine
+    {
+        void declareObjects()
+        {
+            NewBox::declare();
+            ErrorBox::declare();
+            Slider::declare();
+            Print::declare();
+            Receive::declare();
+            Plus::declare();
+            Times::declare();
+            Delay::declare();
+            Metro::declare();
+            Pipe::declare();
+            Bang::declare();
+            Toggle::declare();
+            AdcTilde::declare();
+            DacTilde::declare();
+            OscTilde::declare();
+            Loadmess::declare();
+            SigTilde::declare();
+            TimesTilde::declare();
+            PlusTilde::declare();
+            MeterTilde::declare();
+            DelaySimpleTilde::declare();
+            Message::declare();
+            NoiseTilde::declare();
+            PhasorTilde::declare();
+            SahTilde::declare();
+            SnapshotTilde::declare();
+            Trigger::declare();
+            LineTilde::declare();
+            Minus::declare();
+            Divide::declare();
+            Equal::declare();
+            Less::declare();
+            Greater::declare();
+            Different::declare();
+            Pow::declare();
+            Modulo::declare();
+            MinusTilde::declare();
+            DivideTilde::declare();
+            LessTilde::declare();
+            GreaterTilde::declare();
+            EqualTilde::declare();
+            DifferentTilde::declare();
+            LessEqual::declare();
+            LessEqualTilde::declare();
+            GreaterEqual::declare();
+            GreaterEqualTilde::declare();
+            Comment::declare();
+            Pack::declare();
+            Unpack::declare();
+            Random::declare();
+            Scale::declare();
+            Select::declare();
+            Number::declare();
+            NumberTilde::declare();
+            Hub::declare();
+            Mtof::declare();
+            Send::declare();
+            OscBankTilde::declare();
+        }
+    }
+}
@@ -78,3 +78,14 @@
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Hub.h>
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Mtof.h>
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Send.h>
+#include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_OscBankTilde.h>
+
+namespace kiwi
+{
+    namespace engine
+    {
+        //! @brief Adds all the engine objects to the engine::Factory.
+        //! @details The model objects shall have been declared before, this function shall be called once.
+        void declareObjects();
+    }
+}
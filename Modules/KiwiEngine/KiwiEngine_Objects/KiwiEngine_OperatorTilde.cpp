@@ -46,6 +46,7 @@ namespace kiwi { namespace engine {
             if(args[0].isNumber() && index == 1)
             {
                 m_rhs = args[0].getFloat();
+                invalidate();
             }
         }
     }
@@ -53,63 +54,171 @@ namespace kiwi { namespace engine {
     void OperatorTilde::performVec(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
         dsp::Signal const& in = input[0];
-        const size_t size = in.size();
-        dsp::sample_t const* in1 = in.data();
-        dsp::sample_t const* in2 = input[1].data();
-        dsp::sample_t* out = output[0].data();
+        computeVec(in.data(), input[1].data(), output[0].data(), in.size());
+    }
+    
+    void OperatorTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::Signal const& in = input[0];
+        computeValue(in.data(), m_rhs, output[0].data(), in.size());
+    }
+    
+    void OperatorTilde::performVecScalar(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::Signal const& in = input[0];
+        computeValue(in.data(), input[1][0], output[0].data(), in.size());
+    }
+    
+    void OperatorTilde::performScalarValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::Signal& out = output[0];
+        computeValue(input[0].data(), m_rhs, out.data(), 1ul);
+        
+        const dsp::sample_t result = out[0];
+        out.fill(result);
+    }
+    
+    void OperatorTilde::performScalarScalar(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::Signal& out = output[0];
+        computeValue(input[0].data(), input[1][0], out.data(), 1ul);
+        
+        const dsp::sample_t result = out[0];
+        out.fill(result);
+    }
+    
+    void OperatorTilde::performChannelsValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::Signal const& in = input[0];
+        dsp::Signal& out = output[0];
         
-        for(size_t i = size>>3; i; --i, in1 += 8, in2 += 8, out += 8)
+        if(m_lhs_channels == m_nchannels)
         {
-            compute(out[0], in1[0], in2[0]);
-            compute(out[1], in1[1], in2[1]);
-            compute(out[2], in1[2], in2[2]);
-            compute(out[3], in1[3], in2[3]);
-            compute(out[4], in1[4], in2[4]);
-            compute(out[5], in1[5], in2[5]);
-            compute(out[6], in1[6], in2[6]);
-            compute(out[7], in1[7], in2[7]);
+            // the channels are contiguous, a single call computes all of them.
+            computeValue(in.data(), m_rhs, out.data(), out.size());
         }
-        for(size_t i = size&7; i; --i, in1++, in2++, out++)
+        else
         {
-            compute(out[0], in1[0], in2[0]);
+            const size_t vector_size = out.size() / m_nchannels;
+            const dsp::sample_t rhs = m_rhs;
+            
+            for(size_t channel = 0; channel < m_nchannels; ++channel)
+            {
+                computeValue(input.getSignalChannel(0, channel % m_lhs_channels), rhs,
+                             output.getSignalChannel(0, channel), vector_size);
+            }
         }
     }
     
-    void OperatorTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    void OperatorTilde::performChannelsVec(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        dsp::Signal const& in = input[0];
-        const size_t size = in.size();
-        dsp::sample_t const* in1 = in.data();
-        dsp::sample_t* out = output[0].data();
-        
-        dsp::sample_t const value = m_rhs;
+        dsp::Signal& out = output[0];
         
-        for(size_t i = size>>3; i; --i, in1 += 8, out += 8)
+        if(m_lhs_channels == m_nchannels && m_rhs_channels == m_nchannels)
         {
-            compute(out[0], in1[0], value);
-            compute(out[1], in1[1], value);
-            compute(out[2], in1[2], value);
-            compute(out[3], in1[3], value);
-            compute(out[4], in1[4], value);
-            compute(out[5], in1[5], value);
-            compute(out[6], in1[6], value);
-            compute(out[7], in1[7], value);
+            // the channels are contiguous, a single call computes all of them.
+            computeVec(input[0].data(), input[1].data(), out.data(), out.size());
         }
-        
-        for(size_t i = size&7; i; --i, in1++, out++)
+        else
         {
-            compute(out[0], in1[0], value);
+            const size_t vector_size = out.size() / m_nchannels;
+            
+            for(size_t channel = 0; channel < m_nchannels; ++channel)
+            {
+                computeVec(input.getSignalChannel(0, channel % m_lhs_channels),
+                           input.getSignalChannel(1, channel % m_rhs_channels),
+                           output.getSignalChannel(0, channel), vector_size);
+            }
         }
     }
     
     void OperatorTilde::prepare(dsp::Processor::PrepareInfo const& infos)
     {
+        // a disconnected left input reads zeros.
+        const bool lhs_scalar = !infos.inputs[0] || infos.scalars[0];
+        
+        // the output has as many channels as the widest operand.
+        m_lhs_channels = infos.inputs[0] ? infos.channels[0] : 1ul;
+        m_rhs_channels = infos.inputs.size() > 1 && infos.inputs[1] ? infos.channels[1] : 1ul;
+        m_nchannels = std::max(m_lhs_channels, m_rhs_channels);
+        
+        // every sample of the left operand is read before the same sample of the result is written.
+        if(infos.inputs[0])
+        {
+            setInPlace(0, 0);
+        }
+        
+        // the result only depends on the inputs and on the right operand, that invalidates the
+        // processor when it changes, so constant or disconnected inputs are folded.
+        setPure();
+        
         if (infos.inputs.size() > 1 && infos.inputs[1])
         {
-            setPerformCallBack(this, &OperatorTilde::performVec);
+            if(absorbsZero())
+            {
+                setTail(0, true);
+            }
+            else
+            {
+                alignas(dsp::alignment) dsp::sample_t zero[1] {0.};
+                alignas(dsp::alignment) dsp::sample_t result[1] {0.};
+                computeVec(zero, zero, result, 1ul);
+                
+                if(result[0] == 0.)
+                {
+                    setTail(0);
+                }
+            }
+            
+            if(m_nchannels > 1)
+            {
+                setOutputChannels(0, m_nchannels);
+                setPerformCallBack(this, &OperatorTilde::performChannelsVec);
+            }
+            else if(infos.scalars[1] && lhs_scalar)
+            {
+                setScalarOutput(0);
+                setPerformCallBack(this, &OperatorTilde::performScalarScalar);
+            }
+            else if(infos.scalars[1])
+            {
+                setElementwise(getOperation());
+                setPerformCallBack(this, &OperatorTilde::performVecScalar);
+            }
+            else
+            {
+                setElementwise(getOperation());
+                setPerformCallBack(this, &OperatorTilde::performVec);
+            }
+        }
+        else if(m_nchannels > 1)
+        {
+            if(absorbsZero())
+            {
+                setTail(0);
+            }
+            
+            setOutputChannels(0, m_nchannels);
+            setPerformCallBack(this, &OperatorTilde::performChannelsValue);
+        }
+        else if(lhs_scalar)
+        {
+            if(absorbsZero())
+            {
+                setTail(0);
+            }
+            
+            setScalarOutput(0);
+            setPerformCallBack(this, &OperatorTilde::performScalarValue);
         }
         else
         {
+            if(absorbsZero())
+            {
+                setTail(0);
+            }
+            
+            setElementwise(getOperation(), &m_rhs);
             setPerformCallBack(this, &OperatorTilde::performValue);
         }
     }
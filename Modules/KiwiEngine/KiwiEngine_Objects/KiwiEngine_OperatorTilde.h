@@ -23,6 +23,8 @@
 
 #include <KiwiEngine/KiwiEngine_Object.h>
 
+#include <KiwiDsp/KiwiDsp_Kernels.h>
+
 namespace kiwi { namespace engine {
     
     // ================================================================================ //
@@ -43,11 +45,46 @@ namespace kiwi { namespace engine {
         
         void performVec(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
-        virtual void compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs) = 0;
+        //! @brief Performs with a scalar signal right operand.
+        void performVecScalar(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
+        //! @brief Performs with a scalar left operand, only the first sample is computed.
+        void performScalarValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
+        //! @brief Performs with scalar operands, only the first sample is computed.
+        void performScalarScalar(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
+        //! @brief Performs a multichannel left operand with a value right operand.
+        void performChannelsValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
+        //! @brief Performs multichannel operands, a narrower operand wraps around the channels.
+        void performChannelsVec(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
+        //! @brief Computes a whole vector with a signal right operand.
+        //! @details Implementations should rely on dsp::Kernels.
+        virtual void computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept = 0;
+        
+        //! @brief Computes a whole vector with a scalar right operand.
+        //! @details Implementations should rely on dsp::Kernels.
+        virtual void computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept = 0;
+        
+        //! @brief Returns true if the result is zero as soon as an operand is zero.
+        //! @details The chain then skips the operator if one of its inputs is silent.
+        virtual bool absorbsZero() const noexcept { return false; }
+        
+        //! @brief Returns the elementwise operation computed by the operator.
+        //! @details The chain fuses the operator with the other operators it is chained with.
+        virtual dsp::Kernels::Operation getOperation() const noexcept = 0;
         
     protected:
         
         std::atomic<dsp::sample_t>   m_rhs{0.f};
+        
+    private:
+        
+        size_t                       m_nchannels = 1ul;
+        size_t                       m_lhs_channels = 1ul;
+        size_t                       m_rhs_channels = 1ul;
     };
     
 }}
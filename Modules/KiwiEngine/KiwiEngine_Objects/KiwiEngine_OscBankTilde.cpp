@@ -0,0 +1,152 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <algorithm>
+
+#include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_OscBankTilde.h>
+#include <KiwiEngine/KiwiEngine_Factory.h>
+
+namespace kiwi { namespace engine {
+    
+    // ================================================================================ //
+    //                                    OSCBANK~                                      //
+    // ================================================================================ //
+    
+    void OscBankTilde::declare()
+    {
+        Factory::add<OscBankTilde>("oscbank~", &OscBankTilde::create);
+    }
+    
+    std::unique_ptr<Object> OscBankTilde::create(model::Object const& model, Patcher & patcher)
+    {
+        return std::make_unique<OscBankTilde>(model, patcher);
+    }
+    
+    OscBankTilde::OscBankTilde(model::Object const& model, Patcher& patcher):
+    AudioObject(model, patcher),
+    m_bank(static_cast<size_t>(model.getArguments()[0].getInt()))
+    {
+        std::vector<tool::Atom> const& args = model.getArguments();
+        
+        if(args.size() > 1)
+        {
+            m_bank.setSmoothing(args[1].getFloat());
+        }
+    }
+    
+    bool OscBankTilde::setPartials(std::vector<tool::Atom> const& args, size_t offset,
+                                   void (dsp::OscBank::*setter)(const size_t, const dsp::sample_t) noexcept)
+    {
+        for(size_t i = offset; i < args.size(); ++i)
+        {
+            if(!args[i].isNumber())
+            {
+                return false;
+            }
+        }
+        
+        for(size_t i = offset; i < args.size(); ++i)
+        {
+            (m_bank.*setter)(i - offset, args[i].getFloat());
+        }
+        
+        return true;
+    }
+    
+    void OscBankTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    {
+        if(args.empty())
+        {
+            warning("oscbank~ inlet 1 doesn't understand an empty message");
+        }
+        else if(args[0].isNumber())
+        {
+            // a list of frequency amplitude pairs sets the partials from the first one.
+            if(args.size() % 2 == 0 && std::all_of(args.begin(), args.end(),
+                                                   [](tool::Atom const& atom) { return atom.isNumber(); }))
+            {
+                for(size_t i = 0; i < args.size(); i += 2)
+                {
+                    m_bank.setFrequency(i / 2, args[i].getFloat());
+                    m_bank.setAmplitude(i / 2, args[i + 1].getFloat());
+                }
+            }
+            else
+            {
+                warning("oscbank~ inlet 1 expects a list of frequency amplitude pairs");
+            }
+        }
+        else if(args[0].isString())
+        {
+            const std::string name = args[0].getString();
+            
+            if(name == "freqs" || name == "amps" || name == "phases")
+            {
+                const bool set = name == "freqs" ? setPartials(args, 1ul, &dsp::OscBank::setFrequency)
+                               : name == "amps" ? setPartials(args, 1ul, &dsp::OscBank::setAmplitude)
+                               : setPartials(args, 1ul, &dsp::OscBank::setPhase);
+                
+                if(!set)
+                {
+                    warning("oscbank~ " + name + " expects a list of numbers");
+                }
+            }
+            else if(name == "partial" && args.size() == 4 && args[1].isNumber() && args[1].getInt() >= 0
+                    && args[2].isNumber() && args[3].isNumber())
+            {
+                const size_t partial = static_cast<size_t>(args[1].getInt());
+                m_bank.setFrequency(partial, args[2].getFloat());
+                m_bank.setAmplitude(partial, args[3].getFloat());
+            }
+            else if(name == "clear" && args.size() == 1)
+            {
+                for(size_t i = 0; i < m_bank.getNumberOfPartials(); ++i)
+                {
+                    m_bank.setAmplitude(i, 0.);
+                }
+            }
+            else if(name == "smooth" && args.size() == 2 && args[1].isNumber())
+            {
+                m_bank.setSmoothing(args[1].getFloat());
+            }
+            else
+            {
+                warning("oscbank~ inlet 1 only understands freqs, amps, phases, partial, clear and smooth");
+            }
+        }
+        else
+        {
+            warning("oscbank~ inlet 1 only understands lists and messages");
+        }
+    }
+    
+    void OscBankTilde::prepare(dsp::Processor::PrepareInfo const& infos)
+    {
+        m_bank.prepare(infos.sample_rate, infos.vector_size);
+        setPerformCallBack(this, &OscBankTilde::perform);
+    }
+    
+    void OscBankTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        m_bank.perform(output[0ul].data());
+    }
+    
+}}
@@ -0,0 +1,67 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <KiwiEngine/KiwiEngine_Object.h>
+
+#include <KiwiDsp/KiwiDsp_OscBank.h>
+
+namespace kiwi { namespace engine {
+    
+    // ================================================================================ //
+    //                                    OSCBANK~                                      //
+    // ================================================================================ //
+    
+    //! @brief A bank of cosine partials summed in a single signal.
+    //! @details The first argument is the number of partials and the second one the smoothing time
+    //! of the amplitudes in milliseconds. The partials are updated in bulk by lists of frequencies
+    //! and amplitudes, they replace a subpatch with an oscillator and a gain per partial.
+    //! @see dsp::OscBank
+    class OscBankTilde : public AudioObject
+    {
+    public: // methods
+        
+        static void declare();
+        
+        static std::unique_ptr<Object> create(model::Object const& model, Patcher & patcher);
+        
+        OscBankTilde(model::Object const& model, Patcher& patcher);
+        
+        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        
+        void prepare(dsp::Processor::PrepareInfo const& infos) override final;
+        
+        void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
+    private: // methods
+        
+        //! @brief Sets a parameter of the partials from the atoms after an offset.
+        //! @return false if an atom isn't a number.
+        bool setPartials(std::vector<tool::Atom> const& args, size_t offset,
+                         void (dsp::OscBank::*setter)(const size_t, const dsp::sample_t) noexcept);
+        
+    private: // members
+        
+        dsp::OscBank m_bank;
+    };
+    
+}}
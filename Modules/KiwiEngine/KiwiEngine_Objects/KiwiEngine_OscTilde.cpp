@@ -39,19 +39,31 @@ namespace kiwi { namespace engine {
     }
     
     OscTilde::OscTilde(model::Object const& model, Patcher& patcher):
-    AudioObject(model, patcher)
+    AudioObject(model, patcher),
+    m_freqs(std::max(model.getArguments().size(), size_t(1ul)))
     {
-        std::vector<tool::Atom> const& args = model.getArguments();
-        
-        if (!args.empty() && args[0].isNumber())
+        // an oscillator has a channel per frequency argument.
+        setFrequency(0.f);
+        setFrequencies(model.getArguments());
+    }
+    
+    void OscTilde::setFrequency(dsp::sample_t const& freq) noexcept
+    {
+        for(std::atomic<dsp::sample_t>& channel_freq : m_freqs)
         {
-            setFrequency(args[0].getFloat());
+            channel_freq = freq;
         }
     }
     
-    void OscTilde::setFrequency(dsp::sample_t const& freq) noexcept
+    void OscTilde::setFrequencies(std::vector<tool::Atom> const& freqs) noexcept
     {
-        m_freq = freq;
+        for(size_t i = 0; i < freqs.size() && i < m_freqs.size(); ++i)
+        {
+            if(freqs[i].isNumber())
+            {
+                m_freqs[i] = freqs[i].getFloat();
+            }
+        }
     }
     
     void OscTilde::setSampleRate(dsp::sample_t const& sample_rate)
@@ -68,7 +80,11 @@ namespace kiwi { namespace engine {
     {
         if (index == 0)
         {
-            if (args[0].isNumber())
+            if (args.size() > 1 && args[0].isNumber())
+            {
+                setFrequencies(args);
+            }
+            else if (args[0].isNumber())
             {
                 setFrequency(args[0].getFloat());
             }
@@ -94,10 +110,31 @@ namespace kiwi { namespace engine {
     {
         setSampleRate(static_cast<dsp::sample_t>(infos.sample_rate));
         
-        if (infos.inputs[0] && infos.inputs[1])
+        m_table = &dsp::Wavetable::getCosine();
+        m_phases.resize(infos.vector_size);
+        
+        m_freq_channels = infos.inputs[0] ? infos.channels[0] : 0ul;
+        m_phase_channels = infos.inputs[1] ? infos.channels[1] : 0ul;
+        m_nchannels = std::max(infos.inputs[0] ? m_freq_channels : m_freqs.size(), m_phase_channels);
+        
+        if (m_nchannels > 1)
+        {
+            if(m_times.size() < m_nchannels)
+            {
+                m_times.resize(m_nchannels, 0u);
+            }
+            
+            setOutputChannels(0, m_nchannels);
+            setPerformCallBack(this, &OscTilde::performChannels);
+        }
+        else if (infos.inputs[0] && infos.inputs[1])
         {
             setPerformCallBack(this, &OscTilde::performPhaseAndFreq);
         }
+        else if(infos.inputs[0] && infos.scalars[0])
+        {
+            setPerformCallBack(this, &OscTilde::performScalarFreq);
+        }
         else if(infos.inputs[0])
         {
             setPerformCallBack(this, &OscTilde::performFreq);
@@ -112,64 +149,118 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void OscTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    dsp::Wavetable::phase_t OscTilde::accumulate(phase_t phase, dsp::sample_t const* freq,
+                                                 phase_t offset, size_t size) noexcept
     {
-        dsp::sample_t *sig_data = output[0ul].data();
-        size_t sample_index = output[0ul].size();
-        dsp::sample_t const time_inc = m_freq/m_sr;
-        dsp::sample_t const offset = m_offset;
+        const double period = 1. / m_sr;
         
-        while(sample_index--)
+        for(size_t i = 0; i < size; ++i)
         {
-            *sig_data++ = std::cos(2.f * dsp::pi * (m_time + offset));
-            m_time += time_inc;
+            m_phases[i] = phase + offset;
+            phase += dsp::Wavetable::toPhase(freq[i] * period);
         }
         
-        m_time = fmodf(m_time, 1.f);
+        return phase;
     }
     
-    void OscTilde::performFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    dsp::Wavetable::phase_t OscTilde::accumulate(phase_t phase, phase_t inc, phase_t offset, size_t size) noexcept
     {
-        size_t sample_index = output[0ul].size();
-        dsp::sample_t* output_sig = output[0ul].data();
-        dsp::sample_t const* freq = input[0ul].data();
-        dsp::sample_t const offset = m_offset;
+        // the phases don't depend on each other so the loop is vectorized.
+        const phase_t start = phase + offset;
         
-        while(sample_index--)
+        for(size_t i = 0; i < size; ++i)
         {
-            *output_sig++ = std::cos(2.f *dsp::pi * (m_time + offset));
-            m_time += (*freq++ / m_sr);
+            m_phases[i] = start + static_cast<phase_t>(i) * inc;
         }
         
-        m_time = fmodf(m_time, 1.f);
+        return phase + static_cast<phase_t>(size) * inc;
     }
     
-    void OscTilde::performPhase(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    void OscTilde::addPhases(dsp::sample_t const* phase, size_t size) noexcept
     {
-        dsp::sample_t* output_sig = output[0ul].data();
-        size_t sample_index = output[0ul].size();
-        dsp::sample_t const* phase = input[1ul].data();
-        
-        while(sample_index--)
+        for(size_t i = 0; i < size; ++i)
         {
-            *output_sig++  = std::cos(2.f * dsp::pi * fmodf(*phase++, 1.f));
+            m_phases[i] += dsp::Wavetable::toPhase(phase[i]);
         }
     }
     
+    void OscTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        const size_t size = output[0ul].size();
+        const phase_t inc = dsp::Wavetable::toPhase(m_freqs[0] / static_cast<double>(m_sr));
+        
+        m_time = accumulate(m_time, inc, dsp::Wavetable::toPhase(m_offset), size);
+        m_table->read(m_phases.data(), output[0ul].data(), size);
+    }
+    
+    void OscTilde::performFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        const size_t size = output[0ul].size();
+        
+        m_time = accumulate(m_time, input[0ul].data(), dsp::Wavetable::toPhase(m_offset), size);
+        m_table->read(m_phases.data(), output[0ul].data(), size);
+    }
+    
+    void OscTilde::performScalarFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        // the frequency is the same over the vector.
+        const size_t size = output[0ul].size();
+        const phase_t inc = dsp::Wavetable::toPhase(input[0ul][0ul] / static_cast<double>(m_sr));
+        
+        m_time = accumulate(m_time, inc, dsp::Wavetable::toPhase(m_offset), size);
+        m_table->read(m_phases.data(), output[0ul].data(), size);
+    }
+    
+    void OscTilde::performPhase(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        const size_t size = output[0ul].size();
+        
+        std::fill(m_phases.begin(), m_phases.begin() + size, 0u);
+        addPhases(input[1ul].data(), size);
+        m_table->read(m_phases.data(), output[0ul].data(), size);
+    }
+    
     void OscTilde::performPhaseAndFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sample_index = output[0].size();
-        dsp::sample_t* output_sig = output[0].data();
-        dsp::sample_t const* freq = input[0].data();
-        dsp::sample_t const* phase = input[1].data();
+        const size_t size = output[0ul].size();
         
-        while(sample_index--)
+        m_time = accumulate(m_time, input[0ul].data(), 0u, size);
+        addPhases(input[1ul].data(), size);
+        m_table->read(m_phases.data(), output[0ul].data(), size);
+    }
+    
+    void OscTilde::performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        const size_t vector_size = output[0ul].size() / m_nchannels;
+        const phase_t offset = dsp::Wavetable::toPhase(m_offset);
+        
+        for(size_t channel = 0; channel < m_nchannels; ++channel)
         {
-            *output_sig++  = std::cos(2.f * dsp::pi * (m_time + fmodf(*phase++, 1.f)));
-            m_time += (*freq++ / m_sr);
+            phase_t& time = m_times[channel];
+            
+            // a narrower signal input wraps around the channels.
+            if(m_freq_channels && m_phase_channels)
+            {
+                time = accumulate(time, input.getSignalChannel(0ul, channel % m_freq_channels), 0u, vector_size);
+                addPhases(input.getSignalChannel(1ul, channel % m_phase_channels), vector_size);
+            }
+            else if(m_freq_channels)
+            {
+                time = accumulate(time, input.getSignalChannel(0ul, channel % m_freq_channels), offset, vector_size);
+            }
+            else if(m_phase_channels)
+            {
+                std::fill(m_phases.begin(), m_phases.begin() + vector_size, 0u);
+                addPhases(input.getSignalChannel(1ul, channel % m_phase_channels), vector_size);
+            }
+            else
+            {
+                const phase_t inc = dsp::Wavetable::toPhase(m_freqs[channel] / static_cast<double>(m_sr));
+                time = accumulate(time, inc, offset, vector_size);
+            }
+            
+            m_table->read(m_phases.data(), output.getSignalChannel(0ul, channel), vector_size);
         }
-        
-        m_time = fmodf(m_time, 1.f);
     }
     
 }}
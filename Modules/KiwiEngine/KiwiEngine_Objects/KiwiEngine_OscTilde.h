@@ -22,6 +22,7 @@
 #pragma once
 
 #include <KiwiEngine/KiwiEngine_Object.h>
+#include <KiwiDsp/KiwiDsp_Wavetable.h>
 
 namespace kiwi { namespace engine {
     
@@ -29,6 +30,10 @@ namespace kiwi { namespace engine {
     //                                       OSC~                                       //
     // ================================================================================ //
     
+    //! @brief A cosine oscillator.
+    //! @details The phases are accumulated in fixed point and read in the shared cosine table of the
+    //! engine-wide quality. The phases of a vector are computed first and read at once by the kernels.
+    //! @see dsp::Wavetable
     class OscTilde : public AudioObject
     {
     public: // methods
@@ -45,26 +50,54 @@ namespace kiwi { namespace engine {
         
         void performFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
+        void performScalarFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
         void performPhase(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
         void performPhaseAndFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
+        //! @brief Performs the channels of a multichannel oscillator.
+        void performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
         
     private: // methods
         
         void setFrequency(dsp::sample_t const& freq) noexcept;
         
+        void setFrequencies(std::vector<tool::Atom> const& freqs) noexcept;
+        
         void setOffset(dsp::sample_t const& offset) noexcept;
         
         void setSampleRate(dsp::sample_t const& sample_rate);
         
+        //! @brief Computes the phases of a vector from a frequency signal and returns the next phase.
+        dsp::Wavetable::phase_t accumulate(dsp::Wavetable::phase_t phase, dsp::sample_t const* freq,
+                                           dsp::Wavetable::phase_t offset, size_t size) noexcept;
+        
+        //! @brief Computes the phases of a vector from a constant increment and returns the next phase.
+        dsp::Wavetable::phase_t accumulate(dsp::Wavetable::phase_t phase, dsp::Wavetable::phase_t inc,
+                                           dsp::Wavetable::phase_t offset, size_t size) noexcept;
+        
+        //! @brief Adds a phase signal to the phases of a vector.
+        void addPhases(dsp::sample_t const* phase, size_t size) noexcept;
+        
     private: // members
         
+        using phase_t = dsp::Wavetable::phase_t;
+        
         dsp::sample_t m_sr = 0.f;
-        dsp::sample_t m_time = 0.f;
-        std::atomic<dsp::sample_t> m_freq{0.f};
+        phase_t m_time = 0u;
+        std::vector<std::atomic<dsp::sample_t>> m_freqs;
         std::atomic<dsp::sample_t> m_offset{0.f};
+        
+        size_t m_nchannels = 1ul;
+        size_t m_freq_channels = 0ul;
+        size_t m_phase_channels = 0ul;
+        std::vector<phase_t> m_times;
+        
+        dsp::Wavetable const* m_table = nullptr;
+        std::vector<phase_t> m_phases;
     };
     
 }}
@@ -39,26 +39,40 @@ namespace kiwi{ namespace engine {
     }
     
     PhasorTilde::PhasorTilde(model::Object const& model, Patcher& patcher):
-    AudioObject(model, patcher)
+    AudioObject(model, patcher),
+    m_freqs(std::max(model.getArguments().size(), size_t(1ul)))
     {
-        std::vector<tool::Atom> const& args = model.getArguments();
-        
-        if (!args.empty() && args[0].isNumber())
+        // a phasor has a channel per frequency argument.
+        for(std::atomic<dsp::sample_t>& channel_freq : m_freqs)
         {
-            setFrequency(args[0].getFloat());
+            channel_freq = 0.f;
         }
+        
+        setFrequencies(model.getArguments());
     }
     
     void PhasorTilde::setFrequency(dsp::sample_t const& freq) noexcept
     {
-        m_freq = freq;
-        m_phase_inc.store(m_freq / m_sr);
+        for(std::atomic<dsp::sample_t>& channel_freq : m_freqs)
+        {
+            channel_freq = freq;
+        }
+    }
+    
+    void PhasorTilde::setFrequencies(std::vector<tool::Atom> const& freqs) noexcept
+    {
+        for(size_t i = 0; i < freqs.size() && i < m_freqs.size(); ++i)
+        {
+            if(freqs[i].isNumber())
+            {
+                m_freqs[i] = freqs[i].getFloat();
+            }
+        }
     }
     
     void PhasorTilde::setSampleRate(dsp::sample_t const& sample_rate)
     {
         m_sr = sample_rate;
-        m_phase_inc.store(m_freq / m_sr);
     }
     
     void PhasorTilde::setPhase(dsp::sample_t const& phase) noexcept
@@ -67,13 +81,18 @@ namespace kiwi{ namespace engine {
         while(new_phase > 1.f) { new_phase -= 1.f; }
         while(new_phase < 0.f) { new_phase += 1.f; }
         m_phase.store(new_phase);
+        m_reset_phases.store(true);
     }
     
     void PhasorTilde::receive(size_t index, std::vector<tool::Atom> const& args)
     {
         if (index == 0)
         {
-            if (args[0].isNumber())
+            if (args.size() > 1 && args[0].isNumber())
+            {
+                setFrequencies(args);
+            }
+            else if (args[0].isNumber())
             {
                 setFrequency(args[0].getFloat());
             }
@@ -99,45 +118,109 @@ namespace kiwi{ namespace engine {
     {
         setSampleRate(static_cast<dsp::sample_t>(infos.sample_rate));
         
-        setPerformCallBack(this, (infos.inputs[0]
-                                  ? &PhasorTilde::performSignal
-                                  : &PhasorTilde::performValue));
+        m_freq_channels = infos.inputs[0] ? infos.channels[0] : 0ul;
+        m_nchannels = infos.inputs[0] ? m_freq_channels : m_freqs.size();
+        
+        if(m_phases.size() < m_nchannels)
+        {
+            m_phases.resize(m_nchannels, dsp::Wavetable::toPhase(m_phase.load()));
+        }
+        
+        if (m_nchannels > 1)
+        {
+            setOutputChannels(0, m_nchannels);
+            setPerformCallBack(this, &PhasorTilde::performChannels);
+        }
+        else
+        {
+            setPerformCallBack(this, (infos.inputs[0]
+                                      ? &PhasorTilde::performSignal
+                                      : &PhasorTilde::performValue));
+        }
     }
     
-    dsp::sample_t PhasorTilde::getAndIncrementPhase(const dsp::sample_t inc)
+    void PhasorTilde::resetPhases() noexcept
     {
-        dsp::sample_t old_phase = m_phase.load();
-        dsp::sample_t phase = old_phase;
-        
-        if(phase > 1.f) { phase -= 1.f; }
-        else if(phase < 0.f) { phase += 1.f; }
-
-        m_phase.compare_exchange_strong(old_phase, phase += inc);
-        return phase;
+        // a phase message sets the phase of all the channels.
+        if(m_reset_phases.exchange(false))
+        {
+            std::fill(m_phases.begin(), m_phases.end(), dsp::Wavetable::toPhase(m_phase.load()));
+        }
     }
     
     void PhasorTilde::performSignal(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sampleframes = output[0ul].size();
+        const size_t size = output[0ul].size();
         dsp::sample_t const* in = input[0ul].data();
         dsp::sample_t* out = output[0ul].data();
-        dsp::sample_t freq = 0.f;
+        const double period = 1. / m_sr;
         
-        while(sampleframes--)
+        resetPhases();
+        
+        phase_t phase = m_phases[0];
+        
+        for(size_t i = 0; i < size; ++i)
         {
-            freq = *in++;
-            *out++ = getAndIncrementPhase(freq / m_sr);
+            out[i] = dsp::Wavetable::toPeriods(phase);
+            phase += dsp::Wavetable::toPhase(in[i] * period);
         }
+        
+        m_phases[0] = phase;
     }
     
     void PhasorTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sampleframes = output[0ul].size();
-        dsp::sample_t *out = output[0ul].data();
+        const size_t size = output[0ul].size();
+        dsp::sample_t* out = output[0ul].data();
+        const phase_t inc = dsp::Wavetable::toPhase(m_freqs[0] / static_cast<double>(m_sr));
+        
+        resetPhases();
+        
+        phase_t phase = m_phases[0];
+        
+        for(size_t i = 0; i < size; ++i)
+        {
+            out[i] = dsp::Wavetable::toPeriods(phase);
+            phase += inc;
+        }
+        
+        m_phases[0] = phase;
+    }
+    
+    void PhasorTilde::performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        const size_t vector_size = output[0ul].size() / m_nchannels;
+        const double period = 1. / m_sr;
+        
+        resetPhases();
         
-        while(sampleframes--)
+        for(size_t channel = 0; channel < m_nchannels; ++channel)
         {
-            *out++ = getAndIncrementPhase(m_phase_inc.load());
+            dsp::sample_t* out = output.getSignalChannel(0ul, channel);
+            phase_t phase = m_phases[channel];
+            
+            if(m_freq_channels)
+            {
+                dsp::sample_t const* in = input.getSignalChannel(0ul, channel % m_freq_channels);
+                
+                for(size_t i = 0; i < vector_size; ++i)
+                {
+                    out[i] = dsp::Wavetable::toPeriods(phase);
+                    phase += dsp::Wavetable::toPhase(in[i] * period);
+                }
+            }
+            else
+            {
+                const phase_t inc = dsp::Wavetable::toPhase(m_freqs[channel] * period);
+                
+                for(size_t i = 0; i < vector_size; ++i)
+                {
+                    out[i] = dsp::Wavetable::toPeriods(phase);
+                    phase += inc;
+                }
+            }
+            
+            m_phases[channel] = phase;
         }
     }
     
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <KiwiEngine/KiwiEngine_Object.h>
+#include <KiwiDsp/KiwiDsp_Wavetable.h>
 
 namespace kiwi { namespace engine {
     
@@ -29,6 +30,9 @@ namespace kiwi { namespace engine {
     //                                     PHASOR~                                      //
     // ================================================================================ //
     
+    //! @brief A sawtooth from 0 to 1.
+    //! @details The phases are accumulated in fixed point as the ones of the osc~ object.
+    //! @see dsp::Wavetable
     class PhasorTilde : public AudioObject
     {
     public: // methods
@@ -47,22 +51,34 @@ namespace kiwi { namespace engine {
         
         void performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
+        //! @brief Performs the channels of a multichannel phasor.
+        void performChannels(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
+        
     private: // methods
         
         void setFrequency(dsp::sample_t const& freq) noexcept;
         
+        void setFrequencies(std::vector<tool::Atom> const& freqs) noexcept;
+        
         void setPhase(dsp::sample_t const& phase) noexcept;
         
         void setSampleRate(dsp::sample_t const& sample_rate);
         
-        dsp::sample_t getAndIncrementPhase(const dsp::sample_t inc);
+        //! @brief Sets the phases of the channels if a phase message has been received.
+        void resetPhases() noexcept;
         
     private: // members
         
+        using phase_t = dsp::Wavetable::phase_t;
+        
         dsp::sample_t               m_sr {0.f};
-        dsp::sample_t               m_freq {0.f};
         std::atomic<dsp::sample_t>  m_phase {0.f};
-        std::atomic<dsp::sample_t>  m_phase_inc {0.f};
+        
+        std::vector<std::atomic<dsp::sample_t>> m_freqs;
+        std::atomic<bool>           m_reset_phases {false};
+        size_t                      m_nchannels = 1ul;
+        size_t                      m_freq_channels = 0ul;
+        std::vector<phase_t>        m_phases;
     };
     
 }}
@@ -43,9 +43,19 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void PlusTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void PlusTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs + rhs;
+        dsp::Kernels::get().add(lhs, rhs, result, size);
+    }
+    
+    void PlusTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().addValue(lhs, rhs, result, size);
+    }
+    
+    dsp::Kernels::Operation PlusTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Add;
     }
     
 }}
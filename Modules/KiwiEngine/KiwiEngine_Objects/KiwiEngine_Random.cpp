@@ -21,6 +21,7 @@
 
 #include <functional>
 #include <cmath>
+#include <algorithm>
 
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Random.h>
 #include <KiwiEngine/KiwiEngine_Factory.h>
@@ -43,11 +44,9 @@ namespace kiwi { namespace engine {
     
     Random::Random(model::Object const& model, Patcher& patcher):
     Object(model, patcher),
-    m_random_generator(),
-    m_random_distribution(0, 100)
+    m_random_generator(1),
+    m_range(101)
     {
-        m_random_generator.seed(1);
-        
         std::vector<tool::Atom> const& args = model.getArguments();
         
         if (args.size() > 0 && args[0].isNumber())
@@ -67,7 +66,7 @@ namespace kiwi { namespace engine {
         {
             if (args[0].isBang())
             {
-                send(0, {m_random_distribution(m_random_generator)});
+                send(0, {static_cast<int>(m_random_generator.next(m_range))});
             }
             else
             {
@@ -100,11 +99,12 @@ namespace kiwi { namespace engine {
     
     void Random::setRange(int range)
     {
-        m_random_distribution.param(std::uniform_int_distribution<int>::param_type(0, std::max(0, range)));
+        // the range is inclusive.
+        m_range = static_cast<uint32_t>(std::max(0, range)) + 1u;
     }
     
     void Random::setSeed(int seed)
     {
-        m_random_generator.seed();
+        m_random_generator.seed(static_cast<uint64_t>(seed));
     }
 }}
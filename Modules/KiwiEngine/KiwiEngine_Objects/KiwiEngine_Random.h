@@ -23,7 +23,7 @@
 
 #include <KiwiEngine/KiwiEngine_Object.h>
 
-#include <random>
+#include <KiwiTool/KiwiTool_Random.h>
 
 namespace kiwi { namespace engine {
     
@@ -51,8 +51,8 @@ namespace kiwi { namespace engine {
         
     private: // members
         
-        std::mt19937                        m_random_generator;
-        std::uniform_int_distribution<int>  m_random_distribution;
+        tool::Random    m_random_generator;
+        uint32_t        m_range;
     };
     
 }}
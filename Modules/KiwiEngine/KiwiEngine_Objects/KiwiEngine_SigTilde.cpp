@@ -56,6 +56,7 @@ namespace kiwi { namespace engine {
             if (args[0].isNumber())
             {
                 m_value = args[0].getFloat();
+                invalidate();
             }
             else
             {
@@ -66,18 +67,14 @@ namespace kiwi { namespace engine {
     
     void SigTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sample_index = output[0].size();
-        dsp::sample_t* output_sig = output[0].data();
-        dsp::sample_t const value = m_value;
-        
-        while(sample_index--)
-        {
-            *output_sig++  = value;
-        }
+        output[0].fill(m_value);
     }
     
     void SigTilde::prepare(dsp::Processor::PrepareInfo const& infos)
     {
+        // the chain performs sig~ once and again only when it receives a new value.
+        setPure();
+        setScalarOutput(0);
         setPerformCallBack(this, &SigTilde::perform);
     }
     
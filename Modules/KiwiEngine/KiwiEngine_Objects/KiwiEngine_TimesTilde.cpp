@@ -43,9 +43,24 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void TimesTilde::compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs)
+    void TimesTilde::computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept
     {
-        result = lhs * rhs;
+        dsp::Kernels::get().mul(lhs, rhs, result, size);
+    }
+    
+    void TimesTilde::computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept
+    {
+        dsp::Kernels::get().mulValue(lhs, rhs, result, size);
+    }
+    
+    bool TimesTilde::absorbsZero() const noexcept
+    {
+        return true;
+    }
+    
+    dsp::Kernels::Operation TimesTilde::getOperation() const noexcept
+    {
+        return dsp::Kernels::Operation::Mul;
     }
     
 }}
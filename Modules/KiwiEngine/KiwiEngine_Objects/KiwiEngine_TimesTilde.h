@@ -39,7 +39,13 @@ namespace kiwi { namespace engine {
         
         TimesTilde(model::Object const& model, Patcher& patcher);
         
-        void compute(dsp::sample_t & result, dsp::sample_t const& lhs, dsp::sample_t const& rhs) override final;
+        void computeVec(dsp::sample_t const* lhs, dsp::sample_t const* rhs, dsp::sample_t* result, size_t size) noexcept override final;
+        
+        void computeValue(dsp::sample_t const* lhs, dsp::sample_t rhs, dsp::sample_t* result, size_t size) noexcept override final;
+        
+        dsp::Kernels::Operation getOperation() const noexcept override final;
+        
+        bool absorbsZero() const noexcept override final;
     };
     
 }}
@@ -19,6 +19,10 @@
  ==============================================================================
  */
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 #include "KiwiEngine_Patcher.h"
 #include "KiwiEngine_Object.h"
 #include "KiwiEngine_Link.h"
@@ -133,6 +137,102 @@ namespace kiwi
             }
         }
         
+        void Patcher::setDspProfiling(bool enabled)
+        {
+            m_chain.setProfiling(enabled);
+            m_chain.setCountingDenormals(enabled);
+        }
+        
+        bool Patcher::isDspProfiling() const
+        {
+            return m_chain.isProfiling();
+        }
+        
+        std::map<uint64_t, dsp::Chain::Profile> Patcher::collectDspProfiles()
+        {
+            std::map<uint64_t, dsp::Chain::Profile> profiles;
+            
+            for(auto const& object : m_objects)
+            {
+                auto processor = std::dynamic_pointer_cast<AudioObject>(object.second);
+                
+                if(processor)
+                {
+                    dsp::Chain::Profile profile = m_chain.collectProfile(*processor);
+                    
+                    if(profile.performs != 0)
+                    {
+                        profiles.emplace(object.first, profile);
+                    }
+                }
+            }
+            
+            return profiles;
+        }
+        
+        void Patcher::postDspProfiles(size_t count)
+        {
+            std::map<uint64_t, dsp::Chain::Profile> profiles = collectDspProfiles();
+            
+            std::vector<std::pair<uint64_t, dsp::Chain::Profile>> sorted(profiles.begin(), profiles.end());
+            
+            std::sort(sorted.begin(), sorted.end(), [](std::pair<uint64_t, dsp::Chain::Profile> const& lhs,
+                                                       std::pair<uint64_t, dsp::Chain::Profile> const& rhs)
+            {
+                return lhs.second.average * lhs.second.performs > rhs.second.average * rhs.second.performs;
+            });
+            
+            if(sorted.size() > count)
+            {
+                sorted.resize(count);
+            }
+            
+            std::map<uint64_t, std::string> texts;
+            
+            for(auto const& object : m_patcher_model.getObjects())
+            {
+                if(!object.removed())
+                {
+                    texts[object.ref().obj()] = object.getText();
+                }
+            }
+            
+            auto microseconds = [](std::chrono::nanoseconds time)
+            {
+                std::ostringstream stream;
+                stream << std::fixed << std::setprecision(2) << (time.count() / 1000.) << " us";
+                return stream.str();
+            };
+            
+            post("DSP profile of the " + std::to_string(sorted.size()) + " slowest objects"
+                 + " (a run of fused objects is charged to its last object)");
+            
+            for(auto const& profile : sorted)
+            {
+                std::string subnormals;
+                
+                auto processor = std::dynamic_pointer_cast<AudioObject>(m_objects[profile.first]);
+                
+                std::vector<size_t> const denormals = m_chain.collectDenormals(*processor);
+                
+                if(std::any_of(denormals.begin(), denormals.end(), [](size_t count) {return count != 0;}))
+                {
+                    for(size_t outlet = 0; outlet < denormals.size(); ++outlet)
+                    {
+                        subnormals += (outlet == 0 ? ", subnormals " : "/") + std::to_string(denormals[outlet]);
+                    }
+                }
+                
+                post(texts[profile.first]
+                     + " - performs " + std::to_string(profile.second.performs)
+                     + ", min " + microseconds(profile.second.min)
+                     + ", avg " + microseconds(profile.second.average)
+                     + ", max " + microseconds(profile.second.max)
+                     + ", p99 " + microseconds(profile.second.p99)
+                     + subnormals);
+            }
+        }
+        
         AudioControler& Patcher::getAudioControler() const
         {
             return m_instance.getAudioControler();
@@ -71,6 +71,24 @@ namespace kiwi
             //! @brief Updates the dsp chain held by the engine patcher
             void updateChain();
             
+            //! @brief Enables or disables the profiling of the audio objects.
+            //! @details The subnormal samples produced by the audio objects are counted while profiling.
+            //! @see collectDspProfiles, postDspProfiles
+            void setDspProfiling(bool enabled);
+            
+            //! @brief Returns true if the audio objects are profiled.
+            bool isDspProfiling() const;
+            
+            //! @brief Gets the profiles of the audio objects since the previous collect, by object id.
+            //! @details Each collect starts a new window so collecting periodically gives rolling statistics.
+            //! The objects that haven't been performed in the window are left out.
+            std::map<uint64_t, dsp::Chain::Profile> collectDspProfiles();
+            
+            //! @brief Collects the profiles and posts the ones of the slowest audio objects in the Console.
+            //! @details The objects are sorted by the time they spent over the window. The number of
+            //! subnormal samples of each output follows the times of the objects that produced some.
+            void postDspProfiles(size_t count = 10ul);
+            
             //! @internal The model changed.
             void modelChanged(model::Patcher const& model);
             
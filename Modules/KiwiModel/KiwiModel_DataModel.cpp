@@ -90,6 +90,7 @@ namespace kiwi
             model::Hub::declare();
             model::Mtof::declare();
             model::Send::declare();
+            model::OscBankTilde::declare();
         }
         
         void DataModel::init(std::function<void()> declare_object)
@@ -47,14 +47,13 @@ namespace kiwi { namespace model {
     
     LineTilde::LineTilde(std::vector<tool::Atom> const& args)
     {
-        if (args.size() > 1)
+        // several initial values make a multichannel ramp.
+        for(tool::Atom const& arg : args)
         {
-            throw Error("line~ too many arguments");
-        }
-        
-        if (args.size() == 1 && !args[0].isNumber())
-        {
-            throw Error("line~ initial value shall be a number");
+            if (!arg.isNumber())
+            {
+                throw Error("line~ initial value shall be a number");
+            }
         }
         
         pushInlet({PinType::IType::Control});
@@ -69,7 +68,7 @@ namespace kiwi { namespace model {
         {
             if(index == 0)
             {
-                return "(number/list) Destination value";
+                return "(number/list) Destination value and ramp time pairs, or channels followed by a destination per channel and a ramp time";
             }
             else if(index == 1)
             {
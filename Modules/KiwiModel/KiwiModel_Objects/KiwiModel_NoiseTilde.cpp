@@ -45,11 +45,16 @@ namespace kiwi { namespace model {
     
     NoiseTilde::NoiseTilde(std::vector<tool::Atom> const& args)
     {
-        if (args.size() > 0)
+        if (args.size() > 1)
         {
             throw Error("noise~ too many arguments");
         }
         
+        if (args.size() == 1 && !args[0].isNumber())
+        {
+            throw Error("noise~ seed argument must be a number");
+        }
+        
         pushOutlet(PinType::IType::Signal);
     }
     
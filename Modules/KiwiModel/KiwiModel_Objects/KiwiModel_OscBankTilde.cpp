@@ -0,0 +1,81 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <KiwiModel/KiwiModel_Objects/KiwiModel_OscBankTilde.h>
+
+#include <KiwiModel/KiwiModel_Factory.h>
+
+namespace kiwi { namespace model {
+    
+    // ================================================================================ //
+    //                                    OSCBANK~                                      //
+    // ================================================================================ //
+    
+    void OscBankTilde::declare()
+    {
+        std::unique_ptr<ObjectClass> oscbanktilde_class(new ObjectClass("oscbank~", &OscBankTilde::create));
+        
+        flip::Class<OscBankTilde> & oscbanktilde_model = DataModel::declare<OscBankTilde>()
+                                                         .name(oscbanktilde_class->getModelName().c_str())
+                                                         .inherit<Object>();
+        
+        Factory::add<OscBankTilde>(std::move(oscbanktilde_class), oscbanktilde_model);
+    }
+    
+    std::unique_ptr<Object> OscBankTilde::create(std::vector<tool::Atom> const& args)
+    {
+        return std::make_unique<OscBankTilde>(args);
+    }
+    
+    OscBankTilde::OscBankTilde(std::vector<tool::Atom> const& args)
+    {
+        if (args.size() > 2)
+        {
+            throw Error("oscbank~ too many arguments");
+        }
+        
+        if (args.empty() || !args[0].isNumber() || args[0].getInt() <= 0)
+        {
+            throw Error("oscbank~ number of partials shall be a positive number");
+        }
+        
+        if (args.size() == 2 && (!args[1].isNumber() || args[1].getFloat() < 0.))
+        {
+            throw Error("oscbank~ smoothing time shall be a positive number");
+        }
+        
+        pushInlet({PinType::IType::Control});
+        pushOutlet(PinType::IType::Signal);
+    }
+    
+    std::string OscBankTilde::getIODescription(bool is_inlet, size_t index) const
+    {
+        if(is_inlet)
+        {
+            return "(list) Frequency and amplitude pairs of the partials, freqs, amps, phases, partial, clear, smooth";
+        }
+        else
+        {
+            return "(signal) Sum of the partials";
+        }
+    }
+    
+}}
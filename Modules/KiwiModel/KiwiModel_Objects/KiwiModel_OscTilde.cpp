@@ -48,12 +48,13 @@ namespace kiwi { namespace model {
     OscTilde::OscTilde(std::vector<tool::Atom> const& args):
     model::Object()
     {
-        if (args.size() > 1)
-            throw Error("osc~ too many arguments");
+        // several frequencies make a multichannel oscillator.
+        for(tool::Atom const& arg : args)
+        {
+            if (!arg.isNumber())
+                throw Error("osc~ wrong arguments [" + arg.getString() + "]");
+        }
         
-        if (args.size() == 1 && !args[0].isNumber())
-            throw Error("osc~ wrong arguments [" + args[0].getString() + "]");
-            
         pushInlet({PinType::IType::Control, PinType::IType::Signal});
         pushInlet({PinType::IType::Control, PinType::IType::Signal});
         
@@ -47,14 +47,13 @@ namespace kiwi { namespace model {
     
     PhasorTilde::PhasorTilde(std::vector<tool::Atom> const& args)
     {
-        if (args.size() > 1)
+        // several frequencies make a multichannel phasor.
+        for(tool::Atom const& arg : args)
         {
-            throw Error("phasor~ too many arguments");
-        }
-        
-        if (args.size() == 1 && !args[0].isNumber())
-        {
-            throw Error("phasor~ frequency must be a number");
+            if (!arg.isNumber())
+            {
+                throw Error("phasor~ frequency must be a number");
+            }
         }
         
         pushInlet({PinType::IType::Control, PinType::IType::Signal});
@@ -80,7 +80,7 @@ namespace kiwi { namespace model {
             }
             else if (index == 2)
             {
-                return "Sets the seed";
+                return "Sets the seed, 1 by default";
             }
         }
         else
@@ -0,0 +1,224 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <KiwiTool/KiwiTool_Random.h>
+
+#include <atomic>
+#include <random>
+#include <cstring>
+#include <algorithm>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                      RANDOM                                      //
+    // ================================================================================ //
+    
+    namespace
+    {
+        //! @internal The golden ratio increment of splitmix64.
+        const uint64_t golden_gamma = 0x9e3779b97f4a7c15ull;
+        
+        //! @internal Mixes the bits of a splitmix64 state.
+        uint64_t mix(uint64_t z) noexcept
+        {
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+        
+        //! @internal The global sequence of the seeds, it starts randomly.
+        std::atomic<uint64_t>& getSequence()
+        {
+            static std::atomic<uint64_t> sequence([]()
+            {
+                std::random_device device;
+                return (static_cast<uint64_t>(device()) << 32) | static_cast<uint64_t>(device());
+            }());
+            
+            return sequence;
+        }
+        
+        inline uint32_t rotl(const uint32_t x, const int k) noexcept
+        {
+            return (x << k) | (x >> (32 - k));
+        }
+    }
+    
+    constexpr size_t Random::lanes;
+    
+    Random::Random() : Random(mix(getSequence().fetch_add(golden_gamma)))
+    {
+        ;
+    }
+    
+    Random::Random(const uint64_t seed) noexcept
+    {
+        this->seed(seed);
+    }
+    
+    void Random::seed(const uint64_t seed) noexcept
+    {
+        // the lanes are initialized with splitmix64, as recommended for xoshiro, so they never
+        // start from a null state and don't overlap.
+        uint64_t state = seed;
+        
+        for(size_t i = 0; i < 4; ++i)
+        {
+            for(size_t j = 0; j < lanes; j += 2)
+            {
+                const uint64_t bits = mix(state += golden_gamma);
+                m_state[i][j] = static_cast<uint32_t>(bits);
+                m_state[i][j + 1] = static_cast<uint32_t>(bits >> 32);
+            }
+        }
+        
+        m_index = lanes;
+    }
+    
+    void Random::step() noexcept
+    {
+        uint32_t* s0 = m_state[0];
+        uint32_t* s1 = m_state[1];
+        uint32_t* s2 = m_state[2];
+        uint32_t* s3 = m_state[3];
+        
+        for(size_t i = 0; i < lanes; ++i)
+        {
+            const uint32_t t = s1[i] << 9;
+            
+            m_values[i] = rotl(s0[i] + s3[i], 7) + s0[i];
+            
+            s2[i] ^= s0[i];
+            s3[i] ^= s1[i];
+            s1[i] ^= s2[i];
+            s0[i] ^= s3[i];
+            s2[i] ^= t;
+            s3[i] = rotl(s3[i], 11);
+        }
+        
+        m_index = 0ul;
+    }
+    
+    uint32_t Random::next() noexcept
+    {
+        if(m_index == lanes)
+        {
+            step();
+        }
+        
+        return m_values[m_index++];
+    }
+    
+    uint32_t Random::next(const uint32_t range) noexcept
+    {
+        // the high bits are scaled to the range without division.
+        return static_cast<uint32_t>((static_cast<uint64_t>(next()) * range) >> 32);
+    }
+    
+    float Random::toFloat(const uint32_t bits) noexcept
+    {
+        const uint32_t mantissa = (bits >> 9) | 0x3f800000u;
+        float value;
+        std::memcpy(&value, &mantissa, sizeof(value));
+        return value - 1.f;
+    }
+    
+    double Random::toDouble(const uint32_t bits) noexcept
+    {
+        const uint64_t mantissa = (static_cast<uint64_t>(bits) << 20) | 0x3ff0000000000000ull;
+        double value;
+        std::memcpy(&value, &mantissa, sizeof(value));
+        return value - 1.;
+    }
+    
+    namespace
+    {
+        template<class Type> Type toUnit(const uint32_t bits) noexcept;
+        
+        template<> inline float toUnit<float>(const uint32_t bits) noexcept
+        {
+            return Random::toFloat(bits);
+        }
+        
+        template<> inline double toUnit<double>(const uint32_t bits) noexcept
+        {
+            return Random::toDouble(bits);
+        }
+    }
+    
+    template<class Type>
+    void Random::fillRange(Type* output, size_t size, const Type min, const Type max) noexcept
+    {
+        const Type scale = max - min;
+        
+        // the whole blocks of the lanes are converted by a loop of a fixed size that is vectorized.
+        if(m_index == lanes)
+        {
+            for(; size >= lanes; size -= lanes, output += lanes)
+            {
+                step();
+                
+                for(size_t i = 0; i < lanes; ++i)
+                {
+                    output[i] = min + scale * toUnit<Type>(m_values[i]);
+                }
+            }
+            
+            m_index = lanes;
+        }
+        
+        while(size)
+        {
+            if(m_index == lanes)
+            {
+                step();
+            }
+            
+            const size_t count = std::min(size, lanes - m_index);
+            uint32_t const* values = m_values + m_index;
+            
+            for(size_t i = 0; i < count; ++i)
+            {
+                output[i] = min + scale * toUnit<Type>(values[i]);
+            }
+            
+            m_index += count;
+            output += count;
+            size -= count;
+        }
+    }
+    
+    void Random::fill(float* output, const size_t size, const float min, const float max) noexcept
+    {
+        fillRange(output, size, min, max);
+    }
+    
+    void Random::fill(double* output, const size_t size, const double min, const double max) noexcept
+    {
+        fillRange(output, size, min, max);
+    }
+    
+    void Random::setSeed(const uint64_t seed) noexcept
+    {
+        getSequence().store(seed);
+    }
+}}
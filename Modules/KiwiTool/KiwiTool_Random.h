@@ -0,0 +1,105 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                      RANDOM                                      //
+    // ================================================================================ //
+    
+    //! @brief A fast pseudo-random number generator.
+    //! @details The generator runs several xoshiro128++ generators side by side, one per lane,
+    //! and steps all the lanes at once so that the compiler vectorizes the update. The numbers of
+    //! the lanes are interleaved. The floating point numbers are made by writing the high bits of
+    //! the integers in the mantissa of a number in [1, 2), without divisions.
+    //! A generator constructed without seed takes the next seed of a global sequence that starts
+    //! randomly, setting the seed of the sequence makes the generators constructed in the same order
+    //! give the same numbers. A generator isn't thread safe, the sequence is.
+    class Random final
+    {
+    public: // methods
+        
+        //! @brief Constructs a generator seeded by the next seed of the global sequence.
+        //! @see setSeed
+        Random();
+        
+        //! @brief Constructs a generator with a seed.
+        explicit Random(const uint64_t seed) noexcept;
+        
+        //! @brief The destructor.
+        ~Random() = default;
+        
+        //! @brief Resets the generator with a seed.
+        void seed(const uint64_t seed) noexcept;
+        
+        //! @brief Gets a random integer.
+        uint32_t next() noexcept;
+        
+        //! @brief Gets a random integer in [0, range).
+        //! @details A null range gives 0.
+        uint32_t next(const uint32_t range) noexcept;
+        
+        //! @brief Fills an array with random numbers in [min, max).
+        void fill(float* output, const size_t size, const float min, const float max) noexcept;
+        
+        //! @brief Fills an array with random numbers in [min, max).
+        void fill(double* output, const size_t size, const double min, const double max) noexcept;
+        
+        //! @brief Converts random bits to a number in [0, 1).
+        static float toFloat(const uint32_t bits) noexcept;
+        
+        //! @brief Converts random bits to a number in [0, 1).
+        static double toDouble(const uint32_t bits) noexcept;
+        
+        //! @brief Sets the seed of the global sequence.
+        //! @details The generators constructed from now on without seed take the seeds that follow it.
+        static void setSeed(const uint64_t seed) noexcept;
+        
+        //! @brief The number of generators stepped together.
+        static constexpr size_t lanes = 8ul;
+        
+    private: // methods
+        
+        //! @internal Steps all the lanes and stores their numbers.
+        void step() noexcept;
+        
+        //! @internal Fills an array with numbers of a type.
+        template<class Type> void fillRange(Type* output, size_t size, const Type min, const Type max) noexcept;
+        
+    private: // members
+        
+        alignas(32) uint32_t    m_state[4][lanes];
+        alignas(32) uint32_t    m_values[lanes];
+        size_t                  m_index;
+        
+    private: // deleted methods
+        
+        Random(Random const& other) = delete;
+        Random(Random && other) = delete;
+        Random& operator=(Random const& other) = delete;
+        Random& operator=(Random && other) = delete;
+    };
+}}
@@ -31,6 +31,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <atomic>
 
 #include <KiwiTool/KiwiTool_ConcurrentQueue.h>
 
@@ -123,14 +124,26 @@ namespace kiwi { namespace tool {
         //! @brief Processes events of the consumer that have reached exeuction time.
         void process();
         
+        //! @brief Makes the scheduler run on a logical time instead of reading its clock.
+        //! @details Once set, the delays are counted from the logical time and process executes the
+        //! events that the logical time has reached. Setting it again moves the time, faster or slower
+        //! than the clock, for instance to render a patch offline.
+        void setLogicalTime(time_point_t time);
+        
+        //! @brief Returns the current time of the scheduler.
+        //! @details Returns the logical time if it has been set, otherwise the time of the clock.
+        time_point_t now() const;
+        
         //! @brief Lock the process until the returned lock is out of scope.
         std::unique_lock<std::mutex> lock() const;
         
     private: // members
         
-        Queue               m_queue;
-        mutable std::mutex  m_mutex;
-        std::thread::id     m_consumer_id;
+        Queue                                   m_queue;
+        mutable std::mutex                      m_mutex;
+        std::thread::id                         m_consumer_id;
+        std::atomic<bool>                       m_logical;
+        std::atomic<typename duration_t::rep>   m_logical_time;
         
     private: // deleted methods
         
@@ -166,11 +179,11 @@ namespace kiwi { namespace tool {
         //! @brief Destructor
         ~Queue();
         
-        //! @brief Delays the execution of a task. Shared ownership.
-        void schedule(std::shared_ptr<Task> const& task, duration_t delay);
+        //! @brief Delays the execution of a task until a time. Shared ownership.
+        void schedule(std::shared_ptr<Task> const& task, time_point_t time);
         
-        //! @brief Delays the execution of a task. Transfer ownership.
-        void schedule(std::shared_ptr<Task> && task, duration_t delay);
+        //! @brief Delays the execution of a task until a time. Transfer ownership.
+        void schedule(std::shared_ptr<Task> && task, time_point_t time);
         
         //! @brief Cancels the execution of a task.
         void unschedule(std::shared_ptr<Task> const& task);
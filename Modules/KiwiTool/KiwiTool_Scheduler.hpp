@@ -33,7 +33,9 @@ namespace kiwi { namespace tool {
     Scheduler<Clock>::Scheduler():
     m_queue(),
     m_mutex(),
-    m_consumer_id(std::this_thread::get_id())
+    m_consumer_id(std::this_thread::get_id()),
+    m_logical(false),
+    m_logical_time(0)
     {
     }
     
@@ -58,14 +60,14 @@ namespace kiwi { namespace tool {
     void Scheduler<Clock>::schedule(std::shared_ptr<Task> const& task, duration_t delay)
     {
         assert(task);
-        m_queue.schedule(task, delay);
+        m_queue.schedule(task, now() + delay);
     }
     
     template<class Clock>
     void Scheduler<Clock>::schedule(std::shared_ptr<Task> && task, duration_t delay)
     {
         assert(task);
-        m_queue.schedule(std::move(task), delay);
+        m_queue.schedule(std::move(task), now() + delay);
     }
     
     template<class Clock>
@@ -132,11 +134,29 @@ namespace kiwi { namespace tool {
         
         std::lock_guard<std::mutex> lock(m_mutex);
         
-        time_point_t process_time = clock_t::now();
+        time_point_t process_time = now();
         
         m_queue.process(process_time);
     }
     
+    template<class Clock>
+    void Scheduler<Clock>::setLogicalTime(time_point_t time)
+    {
+        m_logical_time.store(time.time_since_epoch().count());
+        m_logical.store(true);
+    }
+    
+    template<class Clock>
+    typename Scheduler<Clock>::time_point_t Scheduler<Clock>::now() const
+    {
+        if(m_logical.load())
+        {
+            return time_point_t(duration_t(m_logical_time.load()));
+        }
+        
+        return clock_t::now();
+    }
+    
     template<class Clock>
     std::unique_lock<std::mutex> Scheduler<Clock>::lock() const
     {
@@ -162,17 +182,17 @@ namespace kiwi { namespace tool {
     }
     
     template<class Clock>
-    void Scheduler<Clock>::Queue::schedule(std::shared_ptr<Task> const& task, duration_t delay)
+    void Scheduler<Clock>::Queue::schedule(std::shared_ptr<Task> const& task, time_point_t time)
     {
         assert(task);
-        m_commands.push({task, clock_t::now() + delay });
+        m_commands.push({task, time});
     }
     
     template<class Clock>
-    void Scheduler<Clock>::Queue::schedule(std::shared_ptr<Task> && task, duration_t delay)
+    void Scheduler<Clock>::Queue::schedule(std::shared_ptr<Task> && task, time_point_t time)
     {
         assert(task);
-        m_commands.push({std::move(task), clock_t::now() + delay});
+        m_commands.push({std::move(task), time});
     }
     
     template<class Clock>
@@ -0,0 +1,249 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+#include "KiwiRender_FileAudioControler.h"
+
+namespace kiwi
+{
+    namespace render
+    {
+        // ================================================================================ //
+        //                               FILE AUDIO CONTROLER                               //
+        // ================================================================================ //
+        
+        namespace
+        {
+            // Writes an unsigned integer in little endian whatever the endianness of the machine.
+            void writeLittleEndian(std::ofstream& file, uint32_t value, size_t nbytes)
+            {
+                for(size_t i = 0; i < nbytes; ++i)
+                {
+                    file.put(static_cast<char>((value >> (8 * i)) & 0xff));
+                }
+            }
+        }
+        
+        FileAudioControler::FileAudioControler(std::string const& path,
+                                               size_t nchannels,
+                                               size_t sample_rate,
+                                               size_t block_size) :
+        m_file(path, std::ios::binary | std::ios::trunc),
+        m_sample_rate(sample_rate),
+        m_block_size(block_size),
+        m_output_matrix(nchannels, block_size),
+        m_interleaved(nchannels * block_size),
+        m_chains(),
+        m_nsamples(0ul),
+        m_is_playing(false)
+        {
+            if(isOpen())
+            {
+                writeHeader();
+            }
+        }
+        
+        FileAudioControler::~FileAudioControler()
+        {
+            stopAudio();
+            
+            if(isOpen())
+            {
+                m_file.seekp(0);
+                writeHeader();
+                m_file.close();
+            }
+        }
+        
+        bool FileAudioControler::isOpen() const
+        {
+            return m_file.is_open();
+        }
+        
+        size_t FileAudioControler::getSampleRate() const noexcept
+        {
+            return m_sample_rate;
+        }
+        
+        size_t FileAudioControler::getBlockSize() const noexcept
+        {
+            return m_block_size;
+        }
+        
+        size_t FileAudioControler::getNumberOfSamples() const noexcept
+        {
+            return m_nsamples;
+        }
+        
+        void FileAudioControler::writeHeader()
+        {
+            // a WAVE_FORMAT_IEEE_FLOAT header, the non-PCM formats need the extension size
+            // of the fmt chunk and a fact chunk with the number of samples per channel.
+            
+            const uint32_t nchannels = static_cast<uint32_t>(m_output_matrix.getNumberOfChannels());
+            const uint32_t data_size = static_cast<uint32_t>(m_nsamples * nchannels * sizeof(float));
+            
+            m_file.write("RIFF", 4);
+            writeLittleEndian(m_file, 50 + data_size, 4);
+            m_file.write("WAVE", 4);
+            
+            m_file.write("fmt ", 4);
+            writeLittleEndian(m_file, 18, 4);
+            writeLittleEndian(m_file, 3, 2);
+            writeLittleEndian(m_file, nchannels, 2);
+            writeLittleEndian(m_file, static_cast<uint32_t>(m_sample_rate), 4);
+            writeLittleEndian(m_file, static_cast<uint32_t>(m_sample_rate * nchannels * sizeof(float)), 4);
+            writeLittleEndian(m_file, static_cast<uint32_t>(nchannels * sizeof(float)), 2);
+            writeLittleEndian(m_file, 8 * sizeof(float), 2);
+            writeLittleEndian(m_file, 0, 2);
+            
+            m_file.write("fact", 4);
+            writeLittleEndian(m_file, 4, 4);
+            writeLittleEndian(m_file, static_cast<uint32_t>(m_nsamples), 4);
+            
+            m_file.write("data", 4);
+            writeLittleEndian(m_file, data_size, 4);
+        }
+        
+        void FileAudioControler::prepare(dsp::Chain& chain)
+        {
+            try
+            {
+                chain.prepare(m_sample_rate, m_block_size);
+            }
+            catch(dsp::LoopError & e)
+            {
+                std::cerr << "error: " << e.what() << "\n";
+            }
+        }
+        
+        void FileAudioControler::startAudio()
+        {
+            if(!m_is_playing)
+            {
+                for(dsp::Chain * chain : m_chains)
+                {
+                    prepare(*chain);
+                }
+                
+                m_is_playing = true;
+            }
+        }
+        
+        void FileAudioControler::stopAudio()
+        {
+            if(m_is_playing)
+            {
+                for(dsp::Chain * chain : m_chains)
+                {
+                    chain->release();
+                }
+                
+                m_is_playing = false;
+            }
+        }
+        
+        bool FileAudioControler::isAudioOn() const
+        {
+            return m_is_playing;
+        }
+        
+        void FileAudioControler::add(dsp::Chain& chain)
+        {
+            if(std::find(m_chains.begin(), m_chains.end(), &chain) == m_chains.cend())
+            {
+                if(m_is_playing)
+                {
+                    prepare(chain);
+                }
+                
+                m_chains.push_back(&chain);
+            }
+        }
+        
+        void FileAudioControler::remove(dsp::Chain& chain)
+        {
+            const auto it = std::find(m_chains.begin(), m_chains.end(), &chain);
+            
+            if(it != m_chains.cend())
+            {
+                (*it)->release();
+                m_chains.erase(it);
+            }
+        }
+        
+        void FileAudioControler::addToChannel(size_t const channel, dsp::Signal const& output_signal)
+        {
+            if(channel < m_output_matrix.getNumberOfChannels() && output_signal.size() == m_block_size)
+            {
+                m_output_matrix[channel].add(output_signal);
+            }
+        }
+        
+        void FileAudioControler::getFromChannel(size_t const channel, dsp::Signal & input_signal)
+        {
+            input_signal.fill(0);
+        }
+        
+        size_t FileAudioControler::getNumberOfOutputChannels() const
+        {
+            return m_output_matrix.getNumberOfChannels();
+        }
+        
+        void FileAudioControler::tick()
+        {
+            const size_t nchannels = m_output_matrix.getNumberOfChannels();
+            
+            if(m_is_playing)
+            {
+                for(dsp::Chain * chain : m_chains)
+                {
+                    chain->tick();
+                }
+            }
+            
+            for(size_t i = 0; i < nchannels; ++i)
+            {
+                dsp::Signal& channel = m_output_matrix[i];
+                
+                for(size_t j = 0; j < m_block_size; ++j)
+                {
+                    m_interleaved[j * nchannels + i] = static_cast<float>(channel[j]);
+                }
+                
+                channel.fill(0);
+            }
+            
+            if(isOpen())
+            {
+                // the samples are written as they are in memory, wav files are little endian.
+                m_file.write(reinterpret_cast<char const*>(m_interleaved.data()),
+                             m_interleaved.size() * sizeof(float));
+            }
+            
+            m_nsamples += m_block_size;
+        }
+    }
+}
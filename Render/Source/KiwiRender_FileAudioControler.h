@@ -0,0 +1,109 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <fstream>
+#include <vector>
+
+#include <KiwiEngine/KiwiEngine_AudioControler.h>
+
+namespace kiwi
+{
+    namespace render
+    {
+        // ================================================================================ //
+        //                               FILE AUDIO CONTROLER                               //
+        // ================================================================================ //
+        
+        //! @brief An AudioControler that writes the output channels in a wav file.
+        //! @details Instead of an audio device calling back the controler, the renderer ticks the chains
+        //! block after block as fast as it can. The input channels are silent and the output channels
+        //! are written as 32 bits float samples.
+        class FileAudioControler : public engine::AudioControler
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details Opens the file and writes a header that is completed by the destructor.
+            FileAudioControler(std::string const& path,
+                               size_t nchannels,
+                               size_t sample_rate,
+                               size_t block_size);
+            
+            //! @brief Destructor.
+            //! @details Writes the sizes of the header and closes the file.
+            ~FileAudioControler();
+            
+            //! @brief Returns true if the file could be opened.
+            bool isOpen() const;
+            
+            //! @brief Gets the sample rate.
+            size_t getSampleRate() const noexcept;
+            
+            //! @brief Gets the number of samples of a block.
+            size_t getBlockSize() const noexcept;
+            
+            //! @brief Gets the number of samples per channel written in the file.
+            size_t getNumberOfSamples() const noexcept;
+            
+            //! @brief Ticks the chains and writes a block in the file.
+            //! @details If the audio is off, a silent block is written.
+            void tick();
+            
+            void startAudio() override final;
+            
+            void stopAudio() override final;
+            
+            bool isAudioOn() const override final;
+            
+            void add(dsp::Chain& chain) override final;
+            
+            void remove(dsp::Chain& chain) override final;
+            
+            void addToChannel(size_t const channel, dsp::Signal const& output_signal) override final;
+            
+            void getFromChannel(size_t const channel, dsp::Signal & input_signal) override final;
+            
+            size_t getNumberOfOutputChannels() const override final;
+            
+        private: // methods
+            
+            //! @internal Prepares a chain and reports the loops.
+            void prepare(dsp::Chain& chain);
+            
+            //! @internal Writes the header of the file with the current number of samples.
+            void writeHeader();
+            
+        private: // members
+            
+            std::ofstream               m_file;
+            const size_t                m_sample_rate;
+            const size_t                m_block_size;
+            dsp::Buffer                 m_output_matrix;
+            std::vector<float>          m_interleaved;
+            std::vector<dsp::Chain*>    m_chains;
+            size_t                      m_nsamples;
+            bool                        m_is_playing;
+        };
+    }
+}
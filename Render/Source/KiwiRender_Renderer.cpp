@@ -0,0 +1,169 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <chrono>
+#include <iostream>
+
+#include <flip/contrib/DataProviderFile.h>
+#include <flip/BackEndIR.h>
+#include <flip/BackEndBinary.h>
+
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiModel/KiwiModel_DocumentManager.h>
+#include <KiwiModel/KiwiModel_Converters/KiwiModel_Converter.h>
+
+#include <KiwiEngine/KiwiEngine_Patcher.h>
+
+#include "KiwiRender_Renderer.h"
+
+namespace kiwi
+{
+    namespace render
+    {
+        // ================================================================================ //
+        //                                      RENDERER                                    //
+        // ================================================================================ //
+        
+        Renderer::Renderer(engine::Instance& instance, FileAudioControler& audio_controler) :
+        m_instance(instance),
+        m_audio_controler(audio_controler),
+        m_validator(),
+        m_document(model::DataModel::use(), *this, m_validator, flip::Ref::User::Offline, 'cicm', 'kpat')
+        {
+            m_instance.addConsoleListener(*this);
+        }
+        
+        Renderer::~Renderer()
+        {
+            m_instance.removeConsoleListener(*this);
+        }
+        
+        bool Renderer::load(std::string const& path)
+        {
+            flip::DataProviderFile provider(path.c_str());
+            flip::BackEndIR back_end;
+            
+            back_end.register_backend<flip::BackEndBinary>();
+            
+            if(!back_end.read(provider) || !model::Converter::process(back_end))
+            {
+                return false;
+            }
+            
+            try
+            {
+                m_document.read(back_end);
+                
+                model::Patcher& patcher = m_document.root<model::Patcher>();
+                
+                model::DocumentManager::commit(patcher);
+                
+                patcher.entity().use<engine::Patcher>().sendLoadbang();
+            }
+            catch(...)
+            {
+                return false;
+            }
+            
+            return true;
+        }
+        
+        double Renderer::render(size_t nsamples)
+        {
+            using duration_t = tool::Scheduler<>::duration_t;
+            
+            tool::Scheduler<>& scheduler = m_instance.getScheduler();
+            tool::Scheduler<>& main_scheduler = m_instance.getMainScheduler();
+            
+            const size_t sample_rate = m_audio_controler.getSampleRate();
+            const size_t block_size = m_audio_controler.getBlockSize();
+            const size_t start = m_audio_controler.getNumberOfSamples();
+            
+            const auto begin = std::chrono::steady_clock::now();
+            
+            // the logical time is computed from the number of samples rather than accumulated
+            // so that the rounding of the block duration doesn't drift.
+            
+            auto timeOf = [sample_rate](size_t sample)
+            {
+                const std::chrono::duration<double> seconds(static_cast<double>(sample) / sample_rate);
+                return std::chrono::duration_cast<duration_t>(seconds);
+            };
+            
+            for(size_t sample = start; sample < start + nsamples; sample += block_size)
+            {
+                const duration_t time = timeOf(sample);
+                
+                m_instance.advanceTime(time - scheduler.now().time_since_epoch());
+                
+                main_scheduler.setLogicalTime(tool::Scheduler<>::time_point_t(time));
+                main_scheduler.process();
+                
+                m_audio_controler.tick();
+            }
+            
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            const double rendered = static_cast<double>(m_audio_controler.getNumberOfSamples() - start) / sample_rate;
+            
+            return elapsed.count() > 0. ? rendered / elapsed.count() : 0.;
+        }
+        
+        void Renderer::document_changed(model::Patcher& patcher)
+        {
+            if(patcher.added())
+            {
+                patcher.entity().emplace<model::DocumentManager>(patcher.document());
+                patcher.entity().emplace<engine::Patcher>(m_instance, patcher);
+            }
+            
+            patcher.entity().use<engine::Patcher>().modelChanged(patcher);
+            
+            if(patcher.removed())
+            {
+                patcher.entity().erase<engine::Patcher>();
+                patcher.entity().erase<model::DocumentManager>();
+            }
+        }
+        
+        void Renderer::newConsoleMessage(engine::Console::Message const& message)
+        {
+            switch(message.type)
+            {
+                case engine::Console::Message::Type::Warning:
+                {
+                    std::cerr << "warning: " << message.text << "\n";
+                    break;
+                }
+                case engine::Console::Message::Type::Error:
+                {
+                    std::cerr << "error: " << message.text << "\n";
+                    break;
+                }
+                default:
+                {
+                    std::cout << message.text << "\n";
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <string>
+
+#include <flip/Document.h>
+#include <flip/DocumentObserver.h>
+
+#include <KiwiModel/KiwiModel_PatcherValidator.h>
+
+#include <KiwiEngine/KiwiEngine_Instance.h>
+
+#include "KiwiRender_FileAudioControler.h"
+
+namespace kiwi
+{
+    namespace render
+    {
+        // ================================================================================ //
+        //                                      RENDERER                                    //
+        // ================================================================================ //
+        
+        //! @brief Loads a patcher document and renders it offline.
+        //! @details The renderer drives the engine's scheduler, the main scheduler and the chains on
+        //! a logical clock so that the messages are delivered at the time of the block they belong to,
+        //! whatever the time it takes to compute the blocks. The console messages are printed.
+        class Renderer : public flip::DocumentObserver<model::Patcher>,
+                         public engine::Console::Listener
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details The instance shall be constructed with a logical time on the same thread.
+            Renderer(engine::Instance& instance, FileAudioControler& audio_controler);
+            
+            //! @brief Destructor.
+            ~Renderer();
+            
+            //! @brief Loads a .kiwi file and sends the loadbang to the patcher.
+            //! @return True if the document could be read.
+            bool load(std::string const& path);
+            
+            //! @brief Renders a number of samples per channel rounded up to a whole number of blocks.
+            //! @return The realtime factor, the rendered duration divided by the time it took.
+            double render(size_t nsamples);
+            
+        private: // methods
+            
+            //! @internal flip::DocumentObserver.
+            void document_changed(model::Patcher& patcher) override final;
+            
+            //! @internal engine::Console::Listener.
+            void newConsoleMessage(engine::Console::Message const& message) override final;
+            
+        private: // members
+            
+            engine::Instance&           m_instance;
+            FileAudioControler&         m_audio_controler;
+            model::PatcherValidator     m_validator;
+            flip::Document              m_document;
+            
+        private: // deleted methods
+            
+            Renderer(Renderer const& other) = delete;
+            Renderer(Renderer && other) = delete;
+            Renderer& operator=(Renderer const& other) = delete;
+            Renderer& operator=(Renderer && other) = delete;
+        };
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+
+#include <KiwiTool/KiwiTool_Random.h>
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Objects.h>
+
+#include "KiwiServer_CommandLineParser.h"
+#include "KiwiRender_FileAudioControler.h"
+#include "KiwiRender_Renderer.h"
+
+void showHelp()
+{
+    std::cout << "Usage:\n";
+    std::cout << " -h shows this help message. \n";
+    std::cout << " -f set the .kiwi patcher file to render (needed). \n";
+    std::cout << " -o set the .wav file to write (needed). \n";
+    std::cout << " -d set the duration in seconds (default 10). \n";
+    std::cout << " -sr set the sample rate (default 44100). \n";
+    std::cout << " -vs set the vector size (default 64). \n";
+    std::cout << " -c set the number of channels (default 2). \n";
+    std::cout << " -seed set the seed of the noise~ generators (default 0). \n";
+}
+
+int main(int argc, char const* argv[])
+{
+    using namespace kiwi;
+    
+    CommandLineParser cl_parser(argc, argv);
+    
+    if(cl_parser.hasOption("-h"))
+    {
+        showHelp();
+        return 0;
+    }
+    
+    std::string const& input = cl_parser.getOption("-f");
+    std::string const& output = cl_parser.getOption("-o");
+    
+    if(input.empty() || output.empty())
+    {
+        std::cerr << "Error: The patcher file or the wav file is unspecified.." << std::endl;
+        showHelp();
+        return 1;
+    }
+    
+    auto getOption = [&cl_parser](std::string const& option, double default_value)
+    {
+        std::string const& value = cl_parser.getOption(option);
+        return value.empty() ? default_value : std::stod(value);
+    };
+    
+    double duration = 0.;
+    size_t sample_rate = 0ul;
+    size_t vector_size = 0ul;
+    size_t nchannels = 0ul;
+    uint64_t seed = 0ull;
+    
+    try
+    {
+        duration = getOption("-d", 10.);
+        sample_rate = static_cast<size_t>(getOption("-sr", 44100.));
+        vector_size = static_cast<size_t>(getOption("-vs", 64.));
+        nchannels = static_cast<size_t>(getOption("-c", 2.));
+        seed = static_cast<uint64_t>(getOption("-seed", 0.));
+    }
+    catch(std::logic_error const&)
+    {
+        std::cerr << "Error: Invalid option value.." << std::endl;
+        showHelp();
+        return 1;
+    }
+    
+    if(duration < 0. || sample_rate == 0ul || vector_size == 0ul || nchannels == 0ul)
+    {
+        std::cerr << "Error: Invalid option value.." << std::endl;
+        showHelp();
+        return 1;
+    }
+    
+    // the noise~ generators are seeded in the order of the patcher file, random is seeded with 1 unless it has a seed.
+    tool::Random::setSeed(seed);
+    
+    model::DataModel::init();
+    
+    engine::declareObjects();
+    
+    std::unique_ptr<render::FileAudioControler> audio_controler(new render::FileAudioControler(output,
+                                                                                                nchannels,
+                                                                                                sample_rate,
+                                                                                                vector_size));
+    
+    if(!audio_controler->isOpen())
+    {
+        std::cerr << "Error: Cannot open the wav file " << output << std::endl;
+        return 1;
+    }
+    
+    render::FileAudioControler& file = *audio_controler;
+    
+    tool::Scheduler<> main_scheduler;
+    main_scheduler.setLogicalTime(tool::Scheduler<>::time_point_t());
+    
+    engine::Instance instance(std::move(audio_controler), main_scheduler, true);
+    
+    render::Renderer renderer(instance, file);
+    
+    if(!renderer.load(input))
+    {
+        std::cerr << "Error: Cannot read the patcher file " << input << std::endl;
+        return 1;
+    }
+    
+    file.startAudio();
+    
+    const double factor = renderer.render(static_cast<size_t>(duration * sample_rate));
+    
+    std::cout << "[render] - " << file.getNumberOfSamples() << " samples written in " << output
+    << " at " << std::fixed << std::setprecision(1) << factor << "x realtime" << std::endl;
+    
+    return 0;
+}
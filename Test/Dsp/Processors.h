@@ -21,7 +21,12 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <KiwiDsp/KiwiDsp_Processor.h>
+#include <KiwiDsp/KiwiDsp_Kernels.h>
+#include <KiwiDsp/KiwiDsp_RealTime.h>
+#include <KiwiDsp/KiwiDsp_Denormals.h>
 
 using namespace kiwi;
 using namespace dsp;
@@ -132,6 +137,98 @@ private:
     }
 };
 
+// ==================================================================================== //
+//                                          OSC                                         //
+// ==================================================================================== //
+
+// the channel c of a multichannel osc oscillates at frequency + c.
+class Osc : public Processor
+{
+public:
+    Osc(sample_t frequency, size_t nchannels = 1ul) noexcept :
+    Processor(0ul, 1ul), m_frequency(frequency), m_nchannels(nchannels) {}
+    ~Osc() = default;
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        m_increments.resize(m_nchannels);
+        m_phases.resize(m_nchannels, 0.);
+        
+        for(size_t c = 0; c < m_nchannels; ++c)
+        {
+            m_increments[c] = 2. * pi * (m_frequency + c) / infos.sample_rate;
+        }
+        
+        setOutputChannels(0, m_nchannels);
+        setPerformCallBack(this, &Osc::perform);
+    }
+    
+    void perform(Buffer const&, Buffer& output) noexcept
+    {
+        const size_t size = output[0ul].size() / m_nchannels;
+        
+        for(size_t c = 0; c < m_nchannels; ++c)
+        {
+            sample_t* sig = output.getSignalChannel(0, c);
+            double phase = m_phases[c];
+            
+            for(size_t i = 0; i < size; ++i)
+            {
+                sig[i] = std::sin(phase);
+                phase = std::fmod(phase + m_increments[c], 2. * pi);
+            }
+            
+            m_phases[c] = phase;
+        }
+    }
+    
+    sample_t m_frequency;
+    size_t m_nchannels;
+    std::vector<double> m_increments;
+    std::vector<double> m_phases;
+};
+
+// ==================================================================================== //
+//                                      TIMES SCALAR                                    //
+// ==================================================================================== //
+
+class TimesScalar : public Processor
+{
+public:
+    TimesScalar(sample_t value, bool in_place = false) noexcept :
+    Processor(1ul, 1ul), m_value(value), m_in_place(in_place) {}
+    ~TimesScalar() = default;
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        // the channels of the input are contiguous, they are processed as a single vector.
+        setOutputChannels(0, infos.channels[0]);
+        
+        if(m_in_place)
+        {
+            setInPlace(0, 0);
+        }
+        
+        setPerformCallBack(this, &TimesScalar::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        Signal const& in = input[0ul];
+        Signal& out = output[0ul];
+        
+        for(size_t i = 0; i < in.size(); ++i)
+        {
+            out[i] = in[i] * m_value;
+        }
+    }
+    
+    sample_t m_value;
+    bool     m_in_place;
+};
+
 // ==================================================================================== //
 //                                         PRINT                                        //
 // ==================================================================================== //
@@ -151,6 +248,9 @@ private:
     
     void perform(Buffer const& input, Buffer&) noexcept
     {
+        // the probes that report the results to the tests are allowed to allocate.
+        RealTime::Waiver waiver;
+        
         Signal const& sig = input[0];
         const size_t size = sig.size();
         
@@ -317,3 +417,383 @@ private:
         }
     }
 };
+
+// ==================================================================================== //
+//                                        RECORDER                                      //
+// ==================================================================================== //
+
+class Recorder : public Processor
+{
+public:
+    Recorder(std::vector<sample_t>& samples) noexcept : Processor(1ul, 0ul), m_samples(samples) {}
+    ~Recorder() = default;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setPerformCallBack(this, &Recorder::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer&) noexcept
+    {
+        RealTime::Waiver waiver;
+        
+        Signal const& sig = input[0ul];
+        m_samples.insert(m_samples.end(), sig.data(), sig.data() + sig.size());
+    }
+    
+    std::vector<sample_t>& m_samples;
+};
+
+// ==================================================================================== //
+//                                        CONSTANT                                      //
+// ==================================================================================== //
+
+class Constant : public Processor
+{
+public:
+    Constant(sample_t value, size_t& nperforms) noexcept :
+    Processor(0ul, 1ul), m_value(value), m_nperforms(nperforms) {}
+    ~Constant() = default;
+    
+    void setValue(sample_t value) noexcept
+    {
+        m_value.store(value);
+        invalidate();
+    }
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setPure();
+        setScalarOutput(0ul);
+        setPerformCallBack(this, &Constant::perform);
+    }
+    
+    void perform(Buffer const&, Buffer& output) noexcept
+    {
+        output[0ul].fill(m_value.load());
+        ++m_nperforms;
+    }
+    
+    std::atomic<sample_t>   m_value;
+    size_t&                 m_nperforms;
+};
+
+// ==================================================================================== //
+//                                       PURE PLUS                                      //
+// ==================================================================================== //
+
+class PurePlus : public Processor
+{
+public:
+    PurePlus(size_t& nperforms) noexcept : Processor(2ul, 1ul), m_nperforms(nperforms) {}
+    ~PurePlus() = default;
+    
+    std::vector<bool> m_scalars;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        m_scalars = infos.scalars;
+        
+        if((!infos.inputs[0] || infos.scalars[0]) && (!infos.inputs[1] || infos.scalars[1]))
+        {
+            setScalarOutput(0ul);
+        }
+        
+        setPure();
+        setPerformCallBack(this, &PurePlus::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        Signal::add(input[0ul], input[1ul], output[0ul]);
+        ++m_nperforms;
+    }
+    
+    size_t& m_nperforms;
+};
+
+// ==================================================================================== //
+//                                         LEVEL                                        //
+// ==================================================================================== //
+
+class Level : public Processor
+{
+public:
+    Level(sample_t const& value) noexcept : Processor(0ul, 1ul), m_value(value) {}
+    ~Level() = default;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setPerformCallBack(this, &Level::perform);
+    }
+    
+    void perform(Buffer const&, Buffer& output) noexcept
+    {
+        output[0ul].fill(m_value);
+    }
+    
+    sample_t const& m_value;
+};
+
+// ==================================================================================== //
+//                                          TAIL                                        //
+// ==================================================================================== //
+
+class Tail : public Processor
+{
+public:
+    Tail(size_t tail, bool any, size_t& nperforms) noexcept :
+    Processor(2ul, 1ul), m_tail(tail), m_any(any), m_nperforms(nperforms) {}
+    ~Tail() = default;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setTail(m_tail, m_any);
+        setPerformCallBack(this, &Tail::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        // a multiplication is silent as soon as an input is silent.
+        if(m_any)
+        {
+            Kernels::get().mul(input[0ul].data(), input[1ul].data(), output[0ul].data(), output[0ul].size());
+        }
+        else
+        {
+            Signal::add(input[0ul], input[1ul], output[0ul]);
+        }
+        
+        ++m_nperforms;
+    }
+    
+    size_t  m_tail;
+    bool    m_any;
+    size_t& m_nperforms;
+};
+
+// ==================================================================================== //
+//                                       ELEMENTWISE                                    //
+// ==================================================================================== //
+
+class Elementwise : public Processor
+{
+public:
+    Elementwise(Kernels::Operation operation, sample_t value, size_t& nperforms, bool fusable = true) noexcept :
+    Processor(2ul, 1ul), m_value(value), m_operation(operation), m_fusable(fusable), m_signal(false),
+    m_nperforms(nperforms) {}
+    ~Elementwise() = default;
+    
+    // the right operand when the second input is disconnected.
+    std::atomic<sample_t> m_value;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        m_signal = infos.inputs[1];
+        
+        if(m_fusable)
+        {
+            setElementwise(m_operation, m_signal ? nullptr : &m_value);
+        }
+        
+        setPerformCallBack(this, &Elementwise::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        // the kernels in the order of the operations.
+        static Kernels::binary_t Kernels::* const binaries[] =
+        {
+            &Kernels::add, &Kernels::sub, &Kernels::mul, &Kernels::div, &Kernels::less,
+            &Kernels::lessEqual, &Kernels::greater, &Kernels::greaterEqual, &Kernels::equal, &Kernels::notEqual
+        };
+        
+        static Kernels::binary_value_t Kernels::* const binary_values[] =
+        {
+            &Kernels::addValue, &Kernels::subValue, &Kernels::mulValue, &Kernels::divValue,
+            &Kernels::lessValue, &Kernels::lessEqualValue, &Kernels::greaterValue,
+            &Kernels::greaterEqualValue, &Kernels::equalValue, &Kernels::notEqualValue
+        };
+        
+        const size_t operation = static_cast<size_t>(m_operation);
+        Signal& out = output[0ul];
+        
+        if(m_signal)
+        {
+            (Kernels::get().*binaries[operation])(input[0ul].data(), input[1ul].data(), out.data(), out.size());
+        }
+        else
+        {
+            (Kernels::get().*binary_values[operation])(input[0ul].data(), m_value.load(), out.data(), out.size());
+        }
+        
+        ++m_nperforms;
+    }
+    
+    Kernels::Operation  m_operation;
+    bool                m_fusable;
+    bool                m_signal;
+    size_t&             m_nperforms;
+};
+
+// ==================================================================================== //
+//                                      NULL OUTPUT                                     //
+// ==================================================================================== //
+
+// reads its input and discards it, the sink of the benchmarked chains.
+class NullOutput : public Processor
+{
+public:
+    NullOutput() noexcept : Processor(1ul, 0ul) {}
+    ~NullOutput() = default;
+    
+    // the last sample read, so that the compiler can't ignore the inputs.
+    sample_t m_last = 0.;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setPerformCallBack(this, &NullOutput::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer&) noexcept
+    {
+        Signal const& in = input[0ul];
+        m_last = in[in.size() - 1];
+    }
+};
+
+// ==================================================================================== //
+//                                       CHANNELS                                       //
+// ==================================================================================== //
+
+// outputs nchannels channels, the channel c being its input channel c, or the last one, plus c + 1.
+class Channels : public Processor
+{
+public:
+    Channels(size_t nchannels) noexcept : Processor(1ul, 1ul), m_nchannels(nchannels) {}
+    ~Channels() = default;
+    
+    // the number of channels of the input at the last preparation.
+    size_t m_input_channels = 0ul;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        m_input_channels = infos.inputs[0] ? infos.channels[0] : 0ul;
+        setOutputChannels(0, m_nchannels);
+        setPerformCallBack(this, &Channels::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        const size_t size = output[0ul].size() / m_nchannels;
+        
+        for(size_t c = 0; c < m_nchannels; ++c)
+        {
+            sample_t* out = output.getSignalChannel(0, c);
+            
+            for(size_t i = 0; i < size; ++i)
+            {
+                out[i] = c + 1;
+            }
+            
+            if(m_input_channels)
+            {
+                sample_t const* in = input.getSignalChannel(0, std::min(c, m_input_channels - 1));
+                
+                for(size_t i = 0; i < size; ++i)
+                {
+                    out[i] += in[i];
+                }
+            }
+        }
+    }
+    
+    const size_t m_nchannels;
+};
+
+// ==================================================================================== //
+//                                       ALLOCATOR                                      //
+// ==================================================================================== //
+
+// breaks the real-time rules, allocates a vector and locks a mutex at every tick.
+class Allocator : public Processor
+{
+public:
+    Allocator() noexcept : Processor(0ul, 0ul) {}
+    ~Allocator() = default;
+    
+    // true if the thread was checked at the last tick.
+    bool m_checked = false;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setPerformCallBack(this, &Allocator::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        m_checked = RealTime::isChecked();
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_values.reset(new sample_t[64ul]);
+    }
+    
+    std::unique_ptr<sample_t[]> m_values;
+    std::mutex m_mutex;
+};
+
+// ==================================================================================== //
+//                                         DECAY                                        //
+// ==================================================================================== //
+
+// performs as a decaying line~ ramp, halves the smallest normal sample at every sample.
+class Decay : public Processor
+{
+public:
+    Decay() noexcept : Processor(0ul, 1ul) {}
+    ~Decay() = default;
+    
+    // true if the thread flushed the subnormal samples at the last tick.
+    bool m_flushing = false;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        m_value = std::numeric_limits<sample_t>::min();
+        setPerformCallBack(this, &Decay::perform);
+    }
+    
+    void perform(Buffer const&, Buffer& output) noexcept
+    {
+        m_flushing = Denormals::isFlushingThread();
+        
+        Signal& sig = output[0ul];
+        
+        for(size_t i = 0; i < sig.size(); ++i)
+        {
+            sig[i] = m_value;
+            m_value *= 0.5;
+        }
+    }
+    
+    sample_t m_value = 0.;
+};
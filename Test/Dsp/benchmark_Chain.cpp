@@ -0,0 +1,550 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <thread>
+#include <random>
+#include <algorithm>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                   CHAIN BENCHMARK                                //
+// ================================================================================ //
+
+// Run with : test_dsp [benchmark]
+
+TEST_CASE("Dsp - Chain parallel tick benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    const size_t nvoices = 256ul;
+    const size_t nmixers = 16ul;
+    const size_t nticks = 2000ul;
+    
+    // 256 osc -> times voices are mixed by 16 mixers then by a last one.
+    
+    std::vector<std::shared_ptr<Processor>> processors;
+    std::shared_ptr<Processor> output(new PlusScalar(0.));
+    
+    for(size_t i = 0; i < nmixers; ++i)
+    {
+        processors.emplace_back(new PlusScalar(0.));
+    }
+    
+    for(size_t i = 0; i < nvoices; ++i)
+    {
+        processors.emplace_back(new Osc(110. + i));
+        processors.emplace_back(new TimesScalar(1. / nvoices));
+    }
+    
+    const size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    double serial_time = 0.;
+    
+    std::cout << "Chain parallel tick benchmark (" << nvoices << " voices, vector size " << vectorsize << ")\n";
+    std::cout << std::setw(10) << "threads" << std::setw(14) << "us/tick" << std::setw(10) << "speedup" << '\n';
+    
+    for(size_t nthreads = 1; nthreads <= max_threads; nthreads *= 2)
+    {
+        Chain chain;
+        
+        chain.addProcessor(output);
+        
+        for(auto const& processor : processors)
+        {
+            chain.addProcessor(processor);
+        }
+        
+        for(size_t i = 0; i < nmixers; ++i)
+        {
+            chain.connect(*processors[i], 0, *output, 0);
+        }
+        
+        for(size_t i = 0; i < nvoices; ++i)
+        {
+            Processor& osc = *processors[nmixers + i * 2];
+            Processor& times = *processors[nmixers + i * 2 + 1];
+            
+            chain.connect(osc, 0, times, 0);
+            chain.connect(times, 0, *processors[i % nmixers], 0);
+        }
+        
+        chain.setThreadPool(std::make_shared<ThreadPool>(nthreads));
+        chain.prepare(samplerate, vectorsize);
+        
+        for(size_t i = 0; i < nticks / 10; ++i)
+        {
+            chain.tick();
+        }
+        
+        Timer timer;
+        timer.start();
+        
+        for(size_t i = 0; i < nticks; ++i)
+        {
+            chain.tick();
+        }
+        
+        const double time = timer.get<Timer::microseconds>(false) / nticks;
+        
+        if(nthreads == 1)
+        {
+            serial_time = time;
+        }
+        
+        std::cout << std::setw(10) << nthreads << std::setw(14) << std::setprecision(2) << std::fixed << time
+        << std::setw(10) << serial_time / time << '\n';
+        
+        chain.release();
+    }
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Dsp - Chain incremental update benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    
+    // Adding one node to a patch shall only prepare the affected nodes.
+    
+    std::cout << "Chain incremental update benchmark (one node added to the patch)\n";
+    std::cout << std::setw(10) << "nodes" << std::setw(14) << "prepared" << std::setw(14) << "prepare us"
+    << std::setw(14) << "update us" << '\n';
+    
+    for(size_t nnodes : {500ul, 5000ul})
+    {
+        Chain chain;
+        
+        std::vector<std::shared_ptr<Processor>> processors;
+        std::shared_ptr<Processor> output(new PlusScalar(0.));
+        
+        chain.addProcessor(output);
+        
+        for(size_t i = 0; i < nnodes / 2; ++i)
+        {
+            processors.emplace_back(new Osc(110. + i));
+            processors.emplace_back(new TimesScalar(1. / nnodes));
+            
+            chain.addProcessor(processors[i * 2]);
+            chain.addProcessor(processors[i * 2 + 1]);
+            chain.connect(*processors[i * 2], 0, *processors[i * 2 + 1], 0);
+            chain.connect(*processors[i * 2 + 1], 0, *output, 0);
+        }
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        const size_t nprepared = chain.getNumberOfPreparedProcessors();
+        const double prepare_time = chain.getPrepareTime().count() / 1000.;
+        
+        std::cout << std::setw(10) << nnodes << std::setw(14) << nprepared
+        << std::setw(14) << std::setprecision(2) << std::fixed << prepare_time << std::setw(14) << "-" << '\n';
+        
+        std::shared_ptr<Processor> plus(new PlusScalar(1.));
+        
+        Timer timer;
+        timer.start();
+        
+        chain.addProcessor(plus);
+        chain.connect(*plus, 0, *output, 0);
+        chain.update();
+        
+        const double update_time = timer.get<Timer::microseconds>(false);
+        
+        std::cout << std::setw(10) << nnodes + 1 << std::setw(14) << chain.getNumberOfPreparedProcessors()
+        << std::setw(14) << chain.getPrepareTime().count() / 1000. << std::setw(14) << update_time << '\n';
+        
+        chain.release();
+    }
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Dsp - Chain sort benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    
+    // Loads a random graph whose nodes and links are added in a random order.
+    
+    std::cout << "Chain sort benchmark (random graph loaded in a random order)\n";
+    std::cout << std::setw(10) << "nodes" << std::setw(10) << "links" << std::setw(14) << "commands ms"
+    << std::setw(14) << "prepare ms" << std::setw(14) << "ns/link" << '\n';
+    
+    std::mt19937 generator(1234);
+    
+    for(size_t nnodes : {10000ul, 50000ul})
+    {
+        std::vector<std::shared_ptr<Processor>> processors;
+        std::vector<std::pair<size_t, size_t>> links;
+        
+        for(size_t i = 0; i < nnodes; ++i)
+        {
+            processors.emplace_back(new PlusScalar(1.));
+            
+            // every node reads up to two nodes created before it.
+            for(size_t j = 0; i > 0 && j < 2; ++j)
+            {
+                links.emplace_back(std::uniform_int_distribution<size_t>(0, i - 1)(generator), i);
+            }
+        }
+        
+        std::vector<std::shared_ptr<Processor>> added(processors);
+        std::shuffle(added.begin(), added.end(), generator);
+        std::shuffle(links.begin(), links.end(), generator);
+        
+        Chain chain;
+        
+        Timer timer;
+        timer.start();
+        
+        for(auto const& processor : added)
+        {
+            chain.addProcessor(processor);
+        }
+        
+        for(auto const& link : links)
+        {
+            chain.connect(*processors[link.first], 0, *processors[link.second], 0);
+        }
+        
+        chain.update();
+        
+        const double commands_time = timer.get<Timer::microseconds>(true) / 1000.;
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        const double prepare_time = timer.get<Timer::microseconds>(false) / 1000.;
+        
+        std::cout << std::setw(10) << nnodes << std::setw(10) << links.size()
+        << std::setw(14) << std::setprecision(2) << std::fixed << commands_time
+        << std::setw(14) << prepare_time
+        << std::setw(14) << (commands_time + prepare_time) * 1000000. / links.size() << '\n';
+        
+        chain.release();
+    }
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Dsp - Chain per node overhead benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    const size_t nnodes = 1000ul;
+    const size_t nticks = 10000ul;
+    
+    // The processors do nothing so the tick only measures the dispatch and the fanning inlets.
+    
+    std::cout << "Chain per node overhead benchmark (" << nnodes << " empty processors)\n";
+    std::cout << std::setw(10) << "fan-in" << std::setw(14) << "ns/node" << '\n';
+    
+    for(size_t nties : {1ul, 2ul})
+    {
+        Chain chain;
+        
+        std::vector<std::shared_ptr<Processor>> processors;
+        
+        for(size_t i = 0; i < nnodes; ++i)
+        {
+            processors.emplace_back(new NullProcessor(1ul, 1ul));
+            chain.addProcessor(processors.back());
+            
+            for(size_t j = 1; j <= nties && j <= i; ++j)
+            {
+                chain.connect(*processors[i - j], 0, *processors[i], 0);
+            }
+        }
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        for(size_t i = 0; i < nticks / 10; ++i)
+        {
+            chain.tick();
+        }
+        
+        Timer timer;
+        timer.start();
+        
+        for(size_t i = 0; i < nticks; ++i)
+        {
+            chain.tick();
+        }
+        
+        const double time = timer.get<Timer::nanoseconds>(false) / (nticks * nnodes);
+        
+        std::cout << std::setw(10) << nties << std::setw(14) << std::setprecision(2) << std::fixed << time << '\n';
+        
+        chain.release();
+    }
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Dsp - Chain fan-in benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t nticks = 2000ul;
+    
+    // Many sources are mixed into the same inlet like in a patch with a single dac~.
+    
+    std::cout << "Chain fan-in benchmark (sources mixed into one inlet)\n";
+    std::cout << std::setw(10) << "sources" << std::setw(14) << "vector size"
+    << std::setw(14) << "us/tick" << std::setw(10) << "signals" << '\n';
+    
+    for(size_t vectorsize : {64ul, 1024ul})
+    {
+        for(size_t nsources : {8ul, 64ul, 512ul})
+        {
+            Chain chain;
+            
+            std::vector<std::shared_ptr<Processor>> processors;
+            std::shared_ptr<Processor> mixer(new PlusScalar(0.));
+            
+            chain.addProcessor(mixer);
+            
+            for(size_t i = 0; i < nsources; ++i)
+            {
+                processors.emplace_back(new Sig(1. / (i + 1)));
+                chain.addProcessor(processors.back());
+                chain.connect(*processors.back(), 0, *mixer, 0);
+            }
+            
+            chain.prepare(samplerate, vectorsize);
+            
+            for(size_t i = 0; i < nticks / 10; ++i)
+            {
+                chain.tick();
+            }
+            
+            Timer timer;
+            timer.start();
+            
+            for(size_t i = 0; i < nticks; ++i)
+            {
+                chain.tick();
+            }
+            
+            const double time = timer.get<Timer::microseconds>(false) / nticks;
+            
+            std::cout << std::setw(10) << nsources << std::setw(14) << vectorsize
+            << std::setw(14) << std::setprecision(2) << std::fixed << time
+            << std::setw(10) << chain.getNumberOfSignals() << '\n';
+            
+            chain.release();
+        }
+    }
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Dsp - Chain fused expression benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t nexpressions = 64ul;
+    const size_t nticks = 2000ul;
+    
+    // Each expression is a run of arithmetic processors like osc~ -> *~ 0.5 -> +~ -> *~ -> -~ 0.2,
+    // the source is a constant signal so that the tick measures the operations.
+    
+    const Kernels::Operation operations[] =
+    {
+        Kernels::Operation::Mul, Kernels::Operation::Add, Kernels::Operation::Mul, Kernels::Operation::Sub
+    };
+    
+    std::cout << "Chain fused expression benchmark (" << nexpressions << " expressions)\n";
+    std::cout << std::setw(10) << "depth" << std::setw(14) << "vector size"
+    << std::setw(14) << "unfused us" << std::setw(14) << "fused us" << std::setw(10) << "speedup" << '\n';
+    
+    for(size_t vectorsize : {64ul, 1024ul})
+    {
+        for(size_t depth : {4ul, 8ul})
+        {
+            double times[2];
+            
+            for(bool fusable : {false, true})
+            {
+                Chain chain;
+                
+                std::vector<std::shared_ptr<Processor>> processors;
+                size_t nperforms = 0ul;
+                
+                for(size_t i = 0; i < nexpressions; ++i)
+                {
+                    std::shared_ptr<Processor> source(new Sig(1. / (i + 1)));
+                    std::shared_ptr<Processor> operand(new Sig(0.25));
+                    std::shared_ptr<Processor> output(new NullProcessor(1ul, 0ul));
+                    
+                    chain.addProcessor(source);
+                    chain.addProcessor(operand);
+                    chain.addProcessor(output);
+                    
+                    Processor* previous = source.get();
+                    
+                    for(size_t j = 0; j < depth; ++j)
+                    {
+                        std::shared_ptr<Processor> node(new Elementwise(operations[j % 4], 0.5, nperforms, fusable));
+                        
+                        chain.addProcessor(node);
+                        chain.connect(*previous, 0, *node, 0);
+                        
+                        // one operation out of two reads a signal.
+                        if(j % 2 == 1)
+                        {
+                            chain.connect(*operand, 0, *node, 1);
+                        }
+                        
+                        previous = node.get();
+                        processors.push_back(node);
+                    }
+                    
+                    chain.connect(*previous, 0, *output, 0);
+                    
+                    processors.push_back(source);
+                    processors.push_back(operand);
+                    processors.push_back(output);
+                }
+                
+                chain.prepare(samplerate, vectorsize);
+                
+                for(size_t i = 0; i < nticks / 10; ++i)
+                {
+                    chain.tick();
+                }
+                
+                Timer timer;
+                timer.start();
+                
+                for(size_t i = 0; i < nticks; ++i)
+                {
+                    chain.tick();
+                }
+                
+                times[fusable] = timer.get<Timer::microseconds>(false) / nticks;
+                
+                chain.release();
+            }
+            
+            std::cout << std::setw(10) << depth << std::setw(14) << vectorsize
+            << std::setw(14) << std::setprecision(2) << std::fixed << times[0]
+            << std::setw(14) << times[1] << std::setw(10) << times[0] / times[1] << '\n';
+        }
+    }
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Dsp - Chain in place benchmark", "[Dsp, Chain][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t nsamples = 1ul << 18;
+    
+    // nchains osc -> depth times in series -> output, written in place or not.
+    // the memory of the signals is the working set of the tick, the cache misses grow with it.
+    
+    struct Serial
+    {
+        std::string name;
+        size_t      nchains;
+        size_t      depth;
+        bool        in_place;
+    };
+    
+    const std::vector<Serial> serials
+    {
+        {"1x256", 1ul, 256ul, false},
+        {"1x256 in", 1ul, 256ul, true},
+        {"16x64", 16ul, 64ul, false},
+        {"16x64 in", 16ul, 64ul, true}
+    };
+    
+    std::cout << "Chain in place benchmark (" << nsamples << " samples per measure)\n";
+    std::cout << std::setw(10) << "chains" << std::setw(8) << "nodes" << std::setw(8) << "vector"
+    << std::setw(18) << "ns/sample/node" << std::setw(10) << "signals" << std::setw(14) << "memory kB" << '\n';
+    
+    for(size_t vectorsize : {64ul, 256ul, 1024ul, 4096ul})
+    {
+        for(auto const& serial : serials)
+        {
+            Chain chain;
+            
+            for(size_t i = 0; i < serial.nchains; ++i)
+            {
+                std::shared_ptr<Processor> previous(new Osc(110. + i));
+                chain.addProcessor(previous);
+                
+                for(size_t j = 0; j < serial.depth; ++j)
+                {
+                    std::shared_ptr<Processor> times(new TimesScalar(1., serial.in_place));
+                    
+                    chain.addProcessor(times);
+                    chain.connect(*previous, 0, *times, 0);
+                    previous = times;
+                }
+                
+                std::shared_ptr<Processor> output(new NullOutput());
+                
+                chain.addProcessor(output);
+                chain.connect(*previous, 0, *output, 0);
+            }
+            
+            const size_t nnodes = serial.nchains * (serial.depth + 2);
+            const size_t nticks = nsamples / vectorsize;
+            
+            chain.prepare(samplerate, vectorsize);
+            
+            for(size_t i = 0; i < nticks / 10; ++i)
+            {
+                chain.tick();
+            }
+            
+            Timer timer;
+            timer.start();
+            
+            for(size_t i = 0; i < nticks; ++i)
+            {
+                chain.tick();
+            }
+            
+            const double time = timer.get<Timer::nanoseconds>(false) / (nticks * vectorsize * nnodes);
+            
+            std::cout << std::setw(10) << serial.name << std::setw(8) << nnodes << std::setw(8) << vectorsize
+            << std::setw(18) << std::setprecision(3) << std::fixed << time
+            << std::setw(10) << chain.getNumberOfSignals()
+            << std::setw(14) << std::setprecision(1) << chain.getSignalMemorySize() / 1024. << '\n';
+            
+            chain.release();
+        }
+    }
+    
+    std::cout << '\n';
+}
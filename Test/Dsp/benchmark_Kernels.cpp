@@ -0,0 +1,113 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+#include <iomanip>
+#include <functional>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Kernels.h>
+#include <KiwiDsp/KiwiDsp_Signal.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                  KERNELS BENCHMARK                               //
+// ================================================================================ //
+
+// Run with : test_dsp [benchmark]
+
+TEST_CASE("Dsp - Kernels benchmark", "[Dsp, Kernels][benchmark][.]")
+{
+    const size_t vectorsize = 64ul;
+    const size_t iterations = 200000ul;
+    
+    Signal lhs(vectorsize, 0.5);
+    Signal rhs(vectorsize, 0.25);
+    Signal add(vectorsize, 0.125);
+    Signal out(vectorsize);
+    
+    // a table of 4096 points read at phases spread over the period.
+    std::vector<sample_t> table(4097ul, 0.5);
+    std::vector<uint32_t> phases(vectorsize);
+    
+    for(size_t i = 0; i < vectorsize; ++i)
+    {
+        phases[i] = uint32_t(i * 2654435761ul);
+    }
+    
+    std::cout << "Kernels benchmark (ns/sample, vector size " << vectorsize << ")\n";
+    std::cout << std::setw(14) << "kernel";
+    
+    std::vector<Kernels const*> kernels;
+    
+    for(Kernels::Isa isa : {Kernels::Isa::Scalar, Kernels::Isa::Sse2, Kernels::Isa::Avx2, Kernels::Isa::Avx512})
+    {
+        if(Kernels const* k = Kernels::get(isa))
+        {
+            kernels.push_back(k);
+            std::cout << std::setw(10) << Kernels::getName(isa);
+        }
+    }
+    
+    std::cout << '\n';
+    
+    auto run = [&](std::string const& name, std::function<void(Kernels const&)> kernel)
+    {
+        std::cout << std::setw(14) << name;
+        
+        for(Kernels const* k : kernels)
+        {
+            Timer timer;
+            timer.start();
+            
+            for(size_t i = 0; i < iterations; ++i)
+            {
+                kernel(*k);
+            }
+            
+            const double ns = timer.get<Timer::nanoseconds>(false);
+            std::cout << std::setw(10) << std::setprecision(3) << std::fixed << ns / (iterations * vectorsize);
+        }
+        
+        std::cout << '\n';
+    };
+    
+    volatile sample_t sink = 0;
+    
+    run("copy", [&](Kernels const& k) { k.copy(lhs.data(), out.data(), vectorsize); });
+    run("fill", [&](Kernels const& k) { k.fill(0.5, out.data(), vectorsize); });
+    run("add", [&](Kernels const& k) { k.add(lhs.data(), rhs.data(), out.data(), vectorsize); });
+    run("mul", [&](Kernels const& k) { k.mul(lhs.data(), rhs.data(), out.data(), vectorsize); });
+    run("div", [&](Kernels const& k) { k.div(lhs.data(), rhs.data(), out.data(), vectorsize); });
+    run("mulValue", [&](Kernels const& k) { k.mulValue(lhs.data(), 0.5, out.data(), vectorsize); });
+    run("mulAdd", [&](Kernels const& k) { k.mulAdd(lhs.data(), rhs.data(), add.data(), out.data(), vectorsize); });
+    run("less", [&](Kernels const& k) { k.less(lhs.data(), rhs.data(), out.data(), vectorsize); });
+    run("equalValue", [&](Kernels const& k) { k.equalValue(lhs.data(), 0.5, out.data(), vectorsize); });
+    run("clamp", [&](Kernels const& k) { k.clamp(lhs.data(), -0.25, 0.25, out.data(), vectorsize); });
+    run("absMax", [&](Kernels const& k) { sink = k.absMax(lhs.data(), vectorsize); });
+    run("lookup", [&](Kernels const& k) { k.lookup(table.data(), 12ul, phases.data(), out.data(), vectorsize); });
+    
+    std::cout << '\n';
+}
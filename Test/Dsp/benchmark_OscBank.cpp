@@ -0,0 +1,113 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+#include <iomanip>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_OscBank.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                  OSC BANK BENCHMARK                              //
+// ================================================================================ //
+
+// Run with : test_dsp [benchmark]
+
+TEST_CASE("Dsp - OscBank benchmark", "[Dsp, OscBank][benchmark][.]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    const size_t iterations = 2000ul;
+    
+    std::cout << "Oscillator bank benchmark (us/tick, vector size " << vectorsize << ")\n";
+    std::cout << std::setw(10) << "partials" << std::setw(14) << "chain nodes"
+    << std::setw(12) << "chain" << std::setw(12) << "bank" << '\n';
+    
+    for(size_t npartials : {10ul, 100ul, 400ul})
+    {
+        // the additive synthesis as a subpatch, an oscillator times a gain per partial summed by a fan-in.
+        Chain chain;
+        std::vector<std::shared_ptr<Processor>> processors;
+        std::shared_ptr<Processor> output(new NullOutput());
+        
+        chain.addProcessor(output);
+        
+        for(size_t i = 0; i < npartials; ++i)
+        {
+            std::shared_ptr<Processor> osc(new Osc(110. * (i + 1)));
+            std::shared_ptr<Processor> gain(new TimesScalar(1. / (i + 1)));
+            
+            chain.addProcessor(osc);
+            chain.addProcessor(gain);
+            chain.connect(*osc, 0, *gain, 0);
+            chain.connect(*gain, 0, *output, 0);
+            
+            processors.push_back(osc);
+            processors.push_back(gain);
+        }
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        OscBank bank(npartials);
+        std::vector<sample_t> samples(vectorsize);
+        
+        for(size_t i = 0; i < npartials; ++i)
+        {
+            bank.setFrequency(i, 110. * (i + 1));
+            bank.setAmplitude(i, 1. / (i + 1));
+        }
+        
+        bank.prepare(samplerate, vectorsize);
+        
+        Timer timer;
+        timer.start();
+        
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            chain.tick();
+        }
+        
+        const double chain_us = timer.get<Timer::nanoseconds>(true) * 0.001 / iterations;
+        
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            bank.perform(samples.data());
+        }
+        
+        const double bank_us = timer.get<Timer::nanoseconds>(false) * 0.001 / iterations;
+        
+        std::cout << std::setw(10) << npartials << std::setw(14) << npartials * 2ul + 1ul
+        << std::setw(12) << std::setprecision(2) << std::fixed << chain_us
+        << std::setw(12) << std::setprecision(2) << std::fixed << bank_us << '\n';
+        
+        chain.release();
+    }
+    
+    std::cout << '\n';
+}
@@ -0,0 +1,113 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+#include <iomanip>
+#include <functional>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Wavetable.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                 WAVETABLE BENCHMARK                              //
+// ================================================================================ //
+
+// Run with : test_dsp [benchmark]
+
+TEST_CASE("Dsp - Wavetable benchmark", "[Dsp, Wavetable][benchmark][.]")
+{
+    const size_t vectorsize = 64ul;
+    const size_t iterations = 100000ul;
+    const sample_t freq = 440.;
+    const sample_t sample_rate = 44100.;
+    
+    std::vector<sample_t> out(vectorsize);
+    std::vector<Wavetable::phase_t> phases(vectorsize);
+    volatile sample_t sink = 0;
+    
+    std::cout << "Wavetable benchmark (ns/sample, vector size " << vectorsize << ", "
+    << Kernels::getName(Kernels::get().isa) << " kernels)\n";
+    
+    auto run = [&](std::string const& name, std::function<void()> perform)
+    {
+        Timer timer;
+        timer.start();
+        
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            perform();
+            sink = out[i % vectorsize];
+        }
+        
+        const double ns = timer.get<Timer::nanoseconds>(false);
+        std::cout << std::setw(20) << name << std::setw(10) << std::setprecision(3) << std::fixed
+        << ns / (iterations * vectorsize) << '\n';
+    };
+    
+    // the loop of the osc~ object before the tables.
+    sample_t time = 0.;
+    
+    run("std::cos", [&]()
+    {
+        const sample_t time_inc = freq / sample_rate;
+        
+        for(size_t i = 0; i < vectorsize; ++i)
+        {
+            out[i] = std::cos(2.f * pi * (time + 0.25f));
+            time += time_inc;
+        }
+        
+        time = std::fmod(time, sample_t(1.));
+    });
+    
+    for(double quality : {60., 90., 120., 150.})
+    {
+        Wavetable const& table = Wavetable::getCosine(quality);
+        Wavetable::phase_t phase = 0u;
+        
+        std::ostringstream name;
+        name << "table " << table.getSize() << " points";
+        
+        run(name.str(), [&]()
+        {
+            const Wavetable::phase_t inc = Wavetable::toPhase(freq / static_cast<double>(sample_rate));
+            const Wavetable::phase_t offset = Wavetable::toPhase(0.25);
+            
+            const Wavetable::phase_t start = phase + offset;
+            
+            for(size_t i = 0; i < vectorsize; ++i)
+            {
+                phases[i] = start + static_cast<Wavetable::phase_t>(i) * inc;
+            }
+            
+            phase += static_cast<Wavetable::phase_t>(vectorsize) * inc;
+            
+            table.read(phases.data(), out.data(), vectorsize);
+        });
+    }
+    
+    std::cout << '\n';
+}
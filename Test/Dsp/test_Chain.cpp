@@ -20,6 +20,9 @@
  */
 
 #include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 #include "../catch.hpp"
 
@@ -151,6 +154,55 @@ TEST_CASE("Dsp - Chain", "[Dsp, Chain]")
         REQUIRE_THROWS_AS(chain.prepare(0, 0), LoopError);
     }
     
+    SECTION("Loop Detected - deep chain")
+    {
+        Chain chain;
+        
+        const size_t nnodes = 50000ul;
+        
+        std::shared_ptr<Processor> sig(new Sig(0.));
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        std::vector<std::shared_ptr<Processor>> pluses;
+        
+        // the nodes are added and connected backward.
+        chain.addProcessor(print);
+        
+        for(size_t i = 0; i < nnodes; ++i)
+        {
+            pluses.emplace_back(new PlusScalar(1.));
+            chain.addProcessor(pluses.back());
+        }
+        
+        chain.addProcessor(sig);
+        
+        chain.connect(*pluses.front(), 0, *print, 0);
+        
+        for(size_t i = 1; i < nnodes; ++i)
+        {
+            chain.connect(*pluses[i], 0, *pluses[i - 1], 0);
+        }
+        
+        chain.connect(*sig, 0, *pluses.back(), 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[50000.000000, 50000.000000, 50000.000000, 50000.000000]");
+        
+        // closing the chain
+        chain.connect(*pluses.front(), 0, *pluses.back(), 0);
+        
+        REQUIRE_THROWS_AS(chain.update(), LoopError);
+        
+        chain.disconnect(*pluses.front(), 0, *pluses.back(), 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        chain.release();
+    }
+    
     SECTION("non-connected inlets and outlets share same signals")
     {   
         Chain chain;
@@ -181,6 +233,10 @@ TEST_CASE("Dsp - Chain", "[Dsp, Chain]")
         // different than connected inlet signal
         CHECK_FALSE(in_1[0].data() == in_1[1].data());
         
+        // the unconnected inlets read the zero signal.
+        CHECK(in_1[0].isZero());
+        CHECK_FALSE(in_1[1].isZero());
+        
         // check that all unconnected outlet of same index share the same signal pointer.
         CHECK(out_1[0].data() == out_2[0].data());
         CHECK(out_1[2].data() == out_2[2].data());
@@ -410,6 +466,1062 @@ TEST_CASE("Dsp - Chain", "[Dsp, Chain]")
         chain.release();
     }
     
+    SECTION("Chain signals - serial nodes reuse signals")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::vector<std::shared_ptr<Processor>> pluses;
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(print);
+        
+        Processor* previous = sig.get();
+        
+        for(size_t i = 0; i < 32; ++i)
+        {
+            pluses.emplace_back(new PlusScalar(1.));
+            chain.addProcessor(pluses.back());
+            chain.connect(*previous, 0, *pluses.back(), 0);
+            previous = pluses.back().get();
+        }
+        
+        chain.connect(*previous, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[33.000000, 33.000000, 33.000000, 33.000000]");
+        
+        // only two signals are alive at the same time.
+        CHECK(chain.getNumberOfSignals() == 2ul);
+        CHECK(chain.getSignalMemorySize() == 2ul * 64ul);
+        
+        chain.release();
+        
+        CHECK(chain.getNumberOfSignals() == 0ul);
+        CHECK(chain.getSignalMemorySize() == 0ul);
+    }
+    
+    SECTION("Chain signals - outputs are written in place")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::vector<std::shared_ptr<Processor>> times;
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(print);
+        
+        Processor* previous = sig.get();
+        
+        for(size_t i = 0; i < 32; ++i)
+        {
+            times.emplace_back(new TimesScalar(2., true));
+            chain.addProcessor(times.back());
+            chain.connect(*previous, 0, *times.back(), 0);
+            previous = times.back().get();
+        }
+        
+        chain.connect(*previous, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[4294967296.000000, 4294967296.000000, 4294967296.000000, 4294967296.000000]");
+        
+        // the signal of sig is used by the whole chain.
+        CHECK(chain.getNumberOfSignals() == 1ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain signals - inputs read by other processors aren't written in place")
+    {
+        Chain chain;
+        
+        std::string result_1;
+        std::string result_2;
+        
+        std::shared_ptr<Processor> sig(new Sig(2.));
+        std::shared_ptr<Processor> times_1(new TimesScalar(3., true));
+        std::shared_ptr<Processor> times_2(new TimesScalar(5., true));
+        std::shared_ptr<Processor> print_1(new Print(result_1));
+        std::shared_ptr<Processor> print_2(new Print(result_2));
+        
+        // print_1 is added last so that it's performed after times_2.
+        chain.addProcessor(sig);
+        chain.addProcessor(times_1);
+        chain.addProcessor(times_2);
+        chain.addProcessor(print_2);
+        chain.addProcessor(print_1);
+        
+        chain.connect(*sig, 0, *times_1, 0);
+        chain.connect(*times_1, 0, *times_2, 0);
+        chain.connect(*times_2, 0, *print_2, 0);
+        chain.connect(*times_1, 0, *print_1, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 2ul));
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[6.000000, 6.000000]");
+        CHECK(result_2 == "[30.000000, 30.000000]");
+        CHECK(chain.getNumberOfSignals() == 2ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain signals - fanning inlets accumulate their sources")
+    {
+        Chain chain;
+        
+        std::vector<std::shared_ptr<Processor>> sigs;
+        std::shared_ptr<Processor> mixer(new PlusScalar(0.));
+        std::shared_ptr<Processor> plus(new PlusScalar(100.));
+        std::string result_1;
+        std::string result_2;
+        std::shared_ptr<Processor> print_1(new Print(result_1));
+        std::shared_ptr<Processor> print_2(new Print(result_2));
+        
+        chain.addProcessor(mixer);
+        chain.addProcessor(print_1);
+        
+        for(size_t i = 1; i <= 8; ++i)
+        {
+            sigs.emplace_back(new Sig(i));
+            chain.addProcessor(sigs.back());
+            chain.connect(*sigs.back(), 0, *mixer, 0);
+        }
+        
+        chain.connect(*mixer, 0, *print_1, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[36.000000, 36.000000, 36.000000, 36.000000]");
+        
+        // the sources are summed as soon as they are performed.
+        CHECK(chain.getNumberOfSignals() == 2ul);
+        
+        // the sources read by another node are copied.
+        chain.addProcessor(plus);
+        chain.addProcessor(print_2);
+        
+        for(auto const& sig : sigs)
+        {
+            chain.connect(*sig, 0, *plus, 0);
+        }
+        
+        chain.connect(*plus, 0, *print_2, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[36.000000, 36.000000, 36.000000, 36.000000]");
+        CHECK(result_2 == "[136.000000, 136.000000, 136.000000, 136.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain signals - parallel branches keep their signals")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig_1(new Sig(1.));
+        std::shared_ptr<Processor> sig_2(new Sig(2.));
+        std::shared_ptr<Processor> plus_1(new PlusScalar(10.));
+        std::shared_ptr<Processor> plus_2(new PlusScalar(20.));
+        std::shared_ptr<Processor> plus_signal(new PlusSignal());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig_1);
+        chain.addProcessor(sig_2);
+        chain.addProcessor(plus_1);
+        chain.addProcessor(plus_2);
+        chain.addProcessor(plus_signal);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig_1, 0, *plus_1, 0);
+        chain.connect(*sig_2, 0, *plus_2, 0);
+        chain.connect(*sig_1, 0, *plus_signal, 0);
+        chain.connect(*plus_1, 0, *plus_signal, 0);
+        chain.connect(*plus_2, 0, *plus_signal, 1);
+        chain.connect(*plus_signal, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[34.000000, 34.000000, 34.000000, 34.000000]");
+        
+        CHECK(chain.getNumberOfSignals() < 7ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - parallel")
+    {
+        Chain chain;
+        
+        std::vector<std::shared_ptr<Processor>> processors;
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Processor> plus(new PlusSignal());
+        
+        chain.addProcessor(print);
+        chain.addProcessor(count);
+        chain.addProcessor(plus);
+        
+        chain.connect(*count, 0, *plus, 1);
+        chain.connect(*plus, 0, *print, 0);
+        
+        // 32 branches of two nodes whose sum is 32 * 33 / 2 + 32 * 2 = 592.
+        for(size_t i = 1; i <= 32; ++i)
+        {
+            std::shared_ptr<Processor> sig(new Sig(i));
+            std::shared_ptr<Processor> plus_scalar(new PlusScalar(2.));
+            
+            chain.addProcessor(sig);
+            chain.addProcessor(plus_scalar);
+            chain.connect(*sig, 0, *plus_scalar, 0);
+            chain.connect(*plus_scalar, 0, *plus, 0);
+            
+            processors.push_back(sig);
+            processors.push_back(plus_scalar);
+        }
+        
+        chain.setThreadPool(std::make_shared<ThreadPool>(4ul));
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.isParallel());
+        
+        chain.setProfiling(true);
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            chain.tick();
+        }
+        
+        CHECK(result == "[988.000000, 989.000000, 990.000000, 991.000000]");
+        CHECK(chain.collectProfile(*plus).performs == 100ul);
+        
+        chain.setProfiling(false);
+        
+        // the serial chain gives the same result.
+        chain.setThreadPool(nullptr);
+        chain.update();
+        
+        CHECK_FALSE(chain.isParallel());
+        
+        chain.tick();
+        
+        CHECK(result == "[992.000000, 993.000000, 994.000000, 995.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - the sleeping workers of a pool are woken up by its tasks")
+    {
+        // the task lasts long enough for the woken workers to join it.
+        class Wait : public ThreadPool::Task
+        {
+        public:
+            
+            std::atomic<size_t> m_joined[4];
+            
+            Wait() { for(auto& joined : m_joined) joined.store(0ul); }
+            
+            void perform(size_t thread) noexcept override
+            {
+                m_joined[thread].fetch_add(1ul);
+                
+                if(thread == 0ul)
+                {
+                    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+                    
+                    while(std::chrono::steady_clock::now() < end)
+                    {
+                        ThreadPool::pause();
+                    }
+                }
+            }
+        };
+        
+        ThreadPool pool(4ul);
+        Wait task;
+        
+        // the workers go to sleep between the tasks.
+        for(size_t i = 0; i < 50; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            pool.perform(task);
+        }
+        
+        CHECK(task.m_joined[0].load() == 50ul);
+        
+        for(size_t thread = 1; thread < 4; ++thread)
+        {
+            CHECK(task.m_joined[thread].load() > 0ul);
+        }
+    }
+    
+    SECTION("Chain tick - parallel chains ticked by the tasks of their pool")
+    {
+        // as the device manager, a task ticks the chains on the pool the chains tick their nodes on.
+        
+        class TickChains : public ThreadPool::Task
+        {
+        public:
+            
+            TickChains(std::vector<Chain*> chains) : m_chains(chains), m_next(0ul), m_threads(0ul) {}
+            
+            void perform(size_t thread) noexcept override
+            {
+                if(ThreadPool::getCurrentThread() == thread)
+                {
+                    m_threads.fetch_add(1ul);
+                }
+                
+                for(size_t i = m_next.fetch_add(1ul); i < m_chains.size(); i = m_next.fetch_add(1ul))
+                {
+                    m_chains[i]->tick();
+                }
+            }
+            
+            std::vector<Chain*>     m_chains;
+            std::atomic<size_t>     m_next;
+            std::atomic<size_t>     m_threads;
+        };
+        
+        std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>(4ul);
+        
+        Chain chain_1;
+        Chain chain_2;
+        std::string result_1;
+        std::string result_2;
+        std::vector<std::shared_ptr<Processor>> processors;
+        
+        for(auto chain_and_result : {std::make_pair(&chain_1, &result_1), std::make_pair(&chain_2, &result_2)})
+        {
+            Chain& chain = *chain_and_result.first;
+            std::shared_ptr<Processor> print(new Print(*chain_and_result.second));
+            std::shared_ptr<Processor> plus(new PlusSignal());
+            std::shared_ptr<Processor> zero(new Sig(0.));
+            
+            chain.addProcessor(print);
+            chain.addProcessor(plus);
+            chain.addProcessor(zero);
+            chain.connect(*zero, 0, *plus, 1);
+            chain.connect(*plus, 0, *print, 0);
+            
+            for(size_t i = 1; i <= 32; ++i)
+            {
+                std::shared_ptr<Processor> sig(new Sig(i));
+                std::shared_ptr<Processor> plus_scalar(new PlusScalar(2.));
+                
+                chain.addProcessor(sig);
+                chain.addProcessor(plus_scalar);
+                chain.connect(*sig, 0, *plus_scalar, 0);
+                chain.connect(*plus_scalar, 0, *plus, 0);
+                
+                processors.push_back(sig);
+                processors.push_back(plus_scalar);
+            }
+            
+            processors.push_back(print);
+            processors.push_back(plus);
+            processors.push_back(zero);
+            
+            chain.setThreadPool(pool);
+            
+            REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+            
+            CHECK(chain.isParallel());
+        }
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            TickChains task({&chain_1, &chain_2});
+            pool->perform(task);
+            
+            CHECK(task.m_threads.load() >= 1ul);
+        }
+        
+        CHECK(result_1 == "[592.000000, 592.000000, 592.000000, 592.000000]");
+        CHECK(result_2 == "[592.000000, 592.000000, 592.000000, 592.000000]");
+        
+        // a single chain ticks its nodes on the pool.
+        chain_1.tick();
+        
+        CHECK(result_1 == "[592.000000, 592.000000, 592.000000, 592.000000]");
+        CHECK(ThreadPool::getCurrentThread() == 0ul);
+        
+        chain_1.release();
+        chain_2.release();
+    }
+    
+    SECTION("Chain tick - small chains are serial")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig_1(new Sig(1.));
+        std::shared_ptr<Processor> sig_2(new Sig(2.));
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig_1);
+        chain.addProcessor(sig_2);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig_1, 0, *print, 0);
+        chain.connect(*sig_2, 0, *print, 0);
+        
+        chain.setThreadPool(std::make_shared<ThreadPool>(4ul));
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK_FALSE(chain.isParallel());
+        
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain update - plans are swapped while ticking")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(count);
+        chain.addProcessor(print);
+        
+        chain.connect(*count, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        std::atomic<bool> running(true);
+        size_t nticks = 0ul;
+        
+        std::thread audio_thread([&chain, &running, &nticks]()
+        {
+            while(running.load())
+            {
+                chain.tick();
+                ++nticks;
+                std::this_thread::yield();
+            }
+        });
+        
+        std::string other_result;
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            std::shared_ptr<Processor> sig(new Sig(i));
+            std::shared_ptr<Processor> other_print(new Print(other_result));
+            
+            chain.addProcessor(sig);
+            chain.addProcessor(other_print);
+            chain.connect(*sig, 0, *other_print, 0);
+            
+            REQUIRE_NOTHROW(chain.update());
+            
+            chain.removeProcessor(*sig);
+            chain.removeProcessor(*other_print);
+            
+            REQUIRE_NOTHROW(chain.update());
+        }
+        
+        running.store(false);
+        audio_thread.join();
+        
+        // the count has never been prepared again nor skipped.
+        chain.tick();
+        
+        const size_t first = nticks * 4ul;
+        
+        CHECK(result == "[" + std::to_string(static_cast<sample_t>(first)) + ", "
+              + std::to_string(static_cast<sample_t>(first + 1)) + ", "
+              + std::to_string(static_cast<sample_t>(first + 2)) + ", "
+              + std::to_string(static_cast<sample_t>(first + 3)) + "]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain update - busy processors are prepared again while ticking")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Processor> plus(new PlusSignal());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(count);
+        chain.addProcessor(plus);
+        chain.addProcessor(print);
+        
+        chain.connect(*count, 0, *plus, 0);
+        chain.connect(*plus, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        std::atomic<bool> running(true);
+        size_t nticks = 0ul;
+        
+        std::thread audio_thread([&chain, &running, &nticks]()
+        {
+            while(running.load())
+            {
+                chain.tick();
+                ++nticks;
+                std::this_thread::yield();
+            }
+        });
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            std::shared_ptr<Processor> sig(new Sig(i));
+            
+            chain.addProcessor(sig);
+            chain.connect(*sig, 0, *plus, 1);
+            
+            REQUIRE_NOTHROW(chain.update());
+            
+            chain.removeProcessor(*sig);
+            
+            REQUIRE_NOTHROW(chain.update());
+        }
+        
+        running.store(false);
+        audio_thread.join();
+        
+        // the plus is prepared again without its right inlet and the count has never been skipped.
+        chain.tick();
+        
+        const size_t first = nticks * 4ul;
+        
+        CHECK(result == "[" + std::to_string(static_cast<sample_t>(first)) + ", "
+              + std::to_string(static_cast<sample_t>(first + 1)) + ", "
+              + std::to_string(static_cast<sample_t>(first + 2)) + ", "
+              + std::to_string(static_cast<sample_t>(first + 3)) + "]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain update - only the affected processors are prepared")
+    {
+        Chain chain;
+        
+        std::string result_1;
+        std::string result_2;
+        std::shared_ptr<Processor> print_1(new Print(result_1));
+        std::shared_ptr<Processor> count(new Count());
+        
+        // the count is added after the print it is connected to.
+        chain.addProcessor(print_1);
+        chain.addProcessor(count);
+        chain.connect(*count, 0, *print_1, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.getNumberOfPreparedProcessors() == 2ul);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[0.000000, 1.000000, 2.000000, 3.000000]");
+        
+        // Adding and connecting processors
+        
+        std::shared_ptr<Processor> print_2(new Print(result_2));
+        std::shared_ptr<Processor> plus(new PlusSignal());
+        
+        chain.addProcessor(print_2);
+        chain.addProcessor(plus);
+        chain.connect(*plus, 0, *print_2, 0);
+        chain.connect(*count, 0, *plus, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfPreparedProcessors() == 2ul);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[4.000000, 5.000000, 6.000000, 7.000000]");
+        CHECK(result_2 == result_1);
+        
+        // Disconnecting processors
+        
+        chain.disconnect(*count, 0, *plus, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfPreparedProcessors() == 1ul);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[8.000000, 9.000000, 10.000000, 11.000000]");
+        CHECK(result_2 == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        // Removing processors
+        
+        chain.removeProcessor(*plus);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfPreparedProcessors() == 1ul);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[12.000000, 13.000000, 14.000000, 15.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain update - constant processors are folded")
+    {
+        Chain chain;
+        
+        size_t nperforms_1 = 0ul;
+        size_t nperforms_2 = 0ul;
+        size_t nperforms_plus = 0ul;
+        std::string result;
+        
+        std::shared_ptr<Processor> constant_1(new Constant(1., nperforms_1));
+        std::shared_ptr<Processor> constant_2(new Constant(2., nperforms_2));
+        std::shared_ptr<PurePlus> plus(new PurePlus(nperforms_plus));
+        std::shared_ptr<Processor> print(new Print(result));
+        std::shared_ptr<Processor> count(new Count());
+        
+        chain.addProcessor(constant_1);
+        chain.addProcessor(constant_2);
+        chain.addProcessor(plus);
+        chain.addProcessor(print);
+        chain.connect(*constant_1, 0, *plus, 0);
+        chain.connect(*constant_2, 0, *plus, 1);
+        chain.connect(*plus, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.getNumberOfFoldedProcessors() == 3ul);
+        CHECK(plus->m_scalars == std::vector<bool>({true, true}));
+        
+        chain.tick();
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        CHECK(nperforms_1 == 1ul);
+        CHECK(nperforms_2 == 1ul);
+        CHECK(nperforms_plus == 1ul);
+        
+        // the sources of a fanning inlet are performed every tick, the sum is still constant.
+        // the constants keep their folds, only the sum is computed again.
+        
+        chain.disconnect(*constant_2, 0, *plus, 1);
+        chain.connect(*constant_2, 0, *plus, 0);
+        
+        nperforms_1 = nperforms_2 = nperforms_plus = 0ul;
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfFoldedProcessors() == 1ul);
+        
+        chain.tick();
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        CHECK(nperforms_1 == 2ul);
+        CHECK(nperforms_2 == 2ul);
+        CHECK(nperforms_plus == 1ul);
+        
+        // a varying input stops folding the processor, the unused constant isn't performed.
+        
+        chain.disconnect(*constant_2, 0, *plus, 0);
+        chain.addProcessor(count);
+        chain.connect(*count, 0, *plus, 1);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfFoldedProcessors() == 2ul);
+        CHECK(plus->m_scalars == std::vector<bool>({true, false}));
+        
+        chain.tick();
+        
+        CHECK(result == "[1.000000, 2.000000, 3.000000, 4.000000]");
+        
+        chain.tick();
+        
+        CHECK(result == "[5.000000, 6.000000, 7.000000, 8.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - folded processors are computed again when invalidated")
+    {
+        Chain chain;
+        
+        size_t nperforms_1 = 0ul;
+        size_t nperforms_2 = 0ul;
+        size_t nperforms_plus = 0ul;
+        size_t nperforms_other = 0ul;
+        std::string result;
+        
+        std::shared_ptr<Constant> constant_1(new Constant(1., nperforms_1));
+        std::shared_ptr<Constant> constant_2(new Constant(2., nperforms_2));
+        std::shared_ptr<PurePlus> plus(new PurePlus(nperforms_plus));
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(constant_1);
+        chain.addProcessor(constant_2);
+        chain.addProcessor(plus);
+        chain.addProcessor(print);
+        chain.connect(*constant_1, 0, *plus, 0);
+        chain.connect(*constant_2, 0, *plus, 1);
+        chain.connect(*plus, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        
+        // the invalidated processor and the ones that read it are performed once.
+        
+        constant_1->setValue(5.);
+        
+        chain.tick();
+        chain.tick();
+        
+        CHECK(result == "[7.000000, 7.000000, 7.000000, 7.000000]");
+        CHECK(nperforms_1 == 2ul);
+        CHECK(nperforms_2 == 1ul);
+        CHECK(nperforms_plus == 2ul);
+        
+        // an update that doesn't change the constant processors doesn't compute them again.
+        
+        std::shared_ptr<Processor> other(new Constant(3., nperforms_other));
+        chain.addProcessor(other);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfPreparedProcessors() == 1ul);
+        
+        chain.tick();
+        
+        CHECK(result == "[7.000000, 7.000000, 7.000000, 7.000000]");
+        CHECK(nperforms_1 == 2ul);
+        CHECK(nperforms_2 == 1ul);
+        CHECK(nperforms_plus == 2ul);
+        CHECK(nperforms_other == 0ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - silent processors are skipped")
+    {
+        Chain chain;
+        
+        sample_t value_1 = 0.;
+        sample_t value_2 = 0.;
+        size_t nperforms_sum = 0ul;
+        size_t nperforms_mul = 0ul;
+        std::string result_sum;
+        std::string result_mul;
+        
+        std::shared_ptr<Processor> level_1(new Level(value_1));
+        std::shared_ptr<Processor> level_2(new Level(value_2));
+        std::shared_ptr<Processor> sum(new Tail(8ul, false, nperforms_sum));
+        std::shared_ptr<Processor> mul(new Tail(0ul, true, nperforms_mul));
+        std::shared_ptr<Processor> print_sum(new Print(result_sum));
+        std::shared_ptr<Processor> print_mul(new Print(result_mul));
+        
+        chain.addProcessor(level_1);
+        chain.addProcessor(level_2);
+        chain.addProcessor(sum);
+        chain.addProcessor(mul);
+        chain.addProcessor(print_sum);
+        chain.addProcessor(print_mul);
+        chain.connect(*level_1, 0, *sum, 0);
+        chain.connect(*level_2, 0, *sum, 0);
+        chain.connect(*level_1, 0, *mul, 0);
+        chain.connect(*level_2, 0, *mul, 1);
+        chain.connect(*sum, 0, *print_sum, 0);
+        chain.connect(*mul, 0, *print_mul, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        // the sum is performed until its inputs have been silent for its tail.
+        
+        chain.tick();
+        chain.tick();
+        chain.tick();
+        
+        CHECK(nperforms_sum == 2ul);
+        CHECK(nperforms_mul == 0ul);
+        CHECK(chain.getNumberOfSkippedPerforms() == 4ul);
+        CHECK(result_sum == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        CHECK(result_mul == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        // a single silent input is enough for the multiplication.
+        
+        value_1 = 2.;
+        
+        chain.tick();
+        
+        CHECK(nperforms_sum == 3ul);
+        CHECK(nperforms_mul == 0ul);
+        CHECK(result_sum == "[2.000000, 2.000000, 2.000000, 2.000000]");
+        CHECK(result_mul == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        value_2 = 3.;
+        
+        chain.tick();
+        
+        CHECK(nperforms_sum == 4ul);
+        CHECK(nperforms_mul == 1ul);
+        CHECK(chain.getNumberOfSkippedPerforms() == 5ul);
+        CHECK(result_sum == "[5.000000, 5.000000, 5.000000, 5.000000]");
+        CHECK(result_mul == "[6.000000, 6.000000, 6.000000, 6.000000]");
+        
+        // the silence is counted again once the inputs are silent.
+        
+        value_1 = value_2 = 0.;
+        
+        chain.tick();
+        chain.tick();
+        chain.tick();
+        
+        CHECK(nperforms_sum == 6ul);
+        CHECK(nperforms_mul == 1ul);
+        CHECK(result_sum == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        CHECK(result_mul == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        // a silent constant input is silent for good.
+        
+        size_t nperforms_constant = 0ul;
+        std::shared_ptr<Processor> constant(new Constant(0., nperforms_constant));
+        
+        chain.disconnect(*level_1, 0, *mul, 0);
+        chain.addProcessor(constant);
+        chain.connect(*constant, 0, *mul, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        value_2 = 1.;
+        nperforms_mul = 0ul;
+        
+        chain.tick();
+        chain.tick();
+        
+        CHECK(nperforms_mul == 0ul);
+        CHECK(result_mul == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        chain.prepare(samplerate, 4ul);
+        
+        CHECK(chain.getNumberOfSkippedPerforms() == 0ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - elementwise processors are fused")
+    {
+        Chain chain;
+        
+        sample_t level = 1.5;
+        size_t nperforms_a = 0ul;
+        size_t nperforms_b = 0ul;
+        size_t nperforms_c = 0ul;
+        std::string result;
+        std::string result_a;
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Processor> offset(new Level(level));
+        std::shared_ptr<Elementwise> a(new Elementwise(Kernels::Operation::Mul, 2., nperforms_a));
+        std::shared_ptr<Elementwise> b(new Elementwise(Kernels::Operation::Add, 0., nperforms_b));
+        std::shared_ptr<Elementwise> c(new Elementwise(Kernels::Operation::Sub, 0.5, nperforms_c));
+        std::shared_ptr<Processor> print(new Print(result));
+        std::shared_ptr<Processor> print_a(new Print(result_a));
+        
+        chain.addProcessor(count);
+        chain.addProcessor(offset);
+        chain.addProcessor(a);
+        chain.addProcessor(b);
+        chain.addProcessor(c);
+        chain.addProcessor(print);
+        chain.connect(*count, 0, *a, 0);
+        chain.connect(*a, 0, *b, 0);
+        chain.connect(*offset, 0, *b, 1);
+        chain.connect(*b, 0, *c, 0);
+        chain.connect(*c, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[1.000000, 3.000000, 5.000000, 7.000000]");
+        
+        chain.tick();
+        
+        CHECK(result == "[9.000000, 11.000000, 13.000000, 15.000000]");
+        CHECK(nperforms_a + nperforms_b + nperforms_c == 0ul);
+        
+        // the values are read every tick.
+        
+        a->m_value = 3.;
+        
+        chain.tick();
+        
+        CHECK(result == "[25.000000, 28.000000, 31.000000, 34.000000]");
+        
+        // an output read twice isn't fused.
+        
+        chain.addProcessor(print_a);
+        chain.connect(*a, 0, *print_a, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        chain.tick();
+        
+        CHECK(result_a == "[36.000000, 39.000000, 42.000000, 45.000000]");
+        CHECK(result == "[37.000000, 40.000000, 43.000000, 46.000000]");
+        CHECK(nperforms_a == 1ul);
+        CHECK(nperforms_b + nperforms_c == 0ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - processors are profiled")
+    {
+        Chain chain;
+        
+        size_t nperforms = 0ul;
+        std::string result;
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Processor> plus(new PlusScalar(1.));
+        std::shared_ptr<Elementwise> a(new Elementwise(Kernels::Operation::Mul, 2., nperforms));
+        std::shared_ptr<Elementwise> b(new Elementwise(Kernels::Operation::Add, 1., nperforms));
+        std::shared_ptr<Processor> print(new Print(result));
+        std::shared_ptr<Processor> removed(new Sig(1.));
+        
+        chain.addProcessor(count);
+        chain.addProcessor(plus);
+        chain.addProcessor(a);
+        chain.addProcessor(b);
+        chain.addProcessor(print);
+        chain.connect(*count, 0, *plus, 0);
+        chain.connect(*plus, 0, *a, 0);
+        chain.connect(*a, 0, *b, 0);
+        chain.connect(*b, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK_FALSE(chain.isProfiling());
+        
+        chain.tick();
+        
+        CHECK(chain.collectProfile(*plus).performs == 0ul);
+        
+        chain.setProfiling(true);
+        
+        for(size_t i = 0; i < 10; ++i)
+        {
+            chain.tick();
+        }
+        
+        CHECK(result == "[83.000000, 85.000000, 87.000000, 89.000000]");
+        
+        Chain::Profile profile = chain.collectProfile(*plus);
+        
+        CHECK(profile.performs == 10ul);
+        CHECK(profile.min <= profile.average);
+        CHECK(profile.average <= profile.max);
+        CHECK(profile.min <= profile.p99);
+        CHECK(profile.p99 <= profile.max);
+        
+        // the fused run is counted by its last processor.
+        CHECK(chain.collectProfile(*a).performs == 0ul);
+        CHECK(chain.collectProfile(*b).performs == 10ul);
+        CHECK(chain.collectProfile(*removed).performs == 0ul);
+        
+        // a collect starts a new window.
+        CHECK(chain.collectProfile(*plus).performs == 0ul);
+        
+        chain.tick();
+        chain.setProfiling(false);
+        chain.tick();
+        
+        CHECK(chain.collectProfile(*plus).performs == 1ul);
+        
+        chain.release();
+    }
+    
+    SECTION("Chain tick - multichannel signals")
+    {
+        Chain chain;
+        
+        std::string result;
+        
+        std::shared_ptr<Channels> stereo(new Channels(2ul));
+        std::shared_ptr<Channels> triple(new Channels(3ul));
+        std::shared_ptr<Channels> triple_bis(new Channels(3ul));
+        std::shared_ptr<Processor> sig(new Sig(10.));
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(stereo);
+        chain.addProcessor(triple);
+        chain.addProcessor(print);
+        chain.connect(*stereo, 0, *triple, 0);
+        chain.connect(*triple, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 2ul));
+        
+        chain.tick();
+        
+        CHECK(stereo->m_input_channels == 0ul);
+        CHECK(triple->m_input_channels == 2ul);
+        CHECK(result == "[2.000000, 2.000000, 4.000000, 4.000000, 5.000000, 5.000000]");
+        
+        // the narrower sources are summed in the first channels.
+        
+        chain.addProcessor(sig);
+        chain.connect(*sig, 0, *print, 0);
+        chain.connect(*stereo, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        chain.tick();
+        
+        CHECK(result == "[13.000000, 13.000000, 6.000000, 6.000000, 5.000000, 5.000000]");
+        
+        chain.addProcessor(triple_bis);
+        chain.connect(*triple_bis, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        chain.tick();
+        
+        CHECK(result == "[14.000000, 14.000000, 8.000000, 8.000000, 8.000000, 8.000000]");
+        
+        chain.release();
+    }
+    
     SECTION("Chain tick - count example 2")
     {
         Chain chain;
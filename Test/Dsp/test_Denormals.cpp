@@ -0,0 +1,166 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+#include <limits>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_Denormals.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ==================================================================================== //
+//                                     TEST DENORMALS                                   //
+// ==================================================================================== //
+
+TEST_CASE("Dsp - Denormals", "[Dsp, Denormals]")
+{
+    // a sample halved from the smallest normal one stays subnormal for the bits of the mantissa.
+    const size_t nsubnormals = std::numeric_limits<sample_t>::digits - 1;
+    
+    SECTION("Denormals - the subnormal samples are counted")
+    {
+        const sample_t min = std::numeric_limits<sample_t>::min();
+        const sample_t denorm_min = std::numeric_limits<sample_t>::denorm_min();
+        
+        std::vector<sample_t> samples {0., -0., 1., min, -min, min - denorm_min, denorm_min, -denorm_min,
+                                       std::numeric_limits<sample_t>::infinity(),
+                                       std::numeric_limits<sample_t>::quiet_NaN()};
+        
+        CHECK(Denormals::count(samples.data(), samples.size()) == 3ul);
+        CHECK(Denormals::count(samples.data(), 5ul) == 0ul);
+    }
+    
+    SECTION("Denormals - the scopes set and restore the mode of the thread")
+    {
+        const bool flushing = Denormals::isFlushingThread();
+        
+        {
+            Denormals::Scope scope(true);
+            
+            CHECK(Denormals::isFlushingThread() == Denormals::isSupported());
+            
+            {
+                Denormals::Scope inner(false);
+                
+                CHECK_FALSE(Denormals::isFlushingThread());
+            }
+            
+            CHECK(Denormals::isFlushingThread() == Denormals::isSupported());
+        }
+        
+        CHECK(Denormals::isFlushingThread() == flushing);
+    }
+    
+    SECTION("Denormals - the chain counts the subnormal outputs")
+    {
+        Chain chain;
+        std::shared_ptr<Decay> decay(new Decay());
+        std::shared_ptr<Processor> output(new NullOutput());
+        
+        chain.addProcessor(decay);
+        chain.addProcessor(output);
+        chain.connect(*decay, 0, *output, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(44100ul, 64ul));
+        
+        chain.tick();
+        
+        // the outputs are counted once enabled.
+        CHECK(chain.collectDenormals(*decay) == std::vector<size_t>({0ul}));
+        CHECK(chain.collectDenormals(*output).empty());
+        
+        chain.setCountingDenormals(true);
+        chain.prepare(44100ul, 64ul);
+        
+        CHECK(chain.isCountingDenormals());
+        
+        chain.tick();
+        
+        CHECK_FALSE(decay->m_flushing);
+        CHECK(chain.collectDenormals(*decay) == std::vector<size_t>({nsubnormals}));
+        
+        // the decay reached zero.
+        chain.tick();
+        
+        CHECK(chain.collectDenormals(*decay) == std::vector<size_t>({0ul}));
+        
+        // the samples flushed to zero are not counted.
+        Denormals::setFlushing(true);
+        chain.prepare(44100ul, 64ul);
+        chain.tick();
+        Denormals::setFlushing(false);
+        
+        CHECK(decay->m_flushing == Denormals::isSupported());
+        CHECK(chain.collectDenormals(*decay) == std::vector<size_t>({Denormals::isSupported() ? 0ul : nsubnormals}));
+        
+        chain.setCountingDenormals(false);
+        chain.prepare(44100ul, 64ul);
+        chain.tick();
+        
+        CHECK(chain.collectDenormals(*decay) == std::vector<size_t>({0ul}));
+        
+        chain.release();
+    }
+    
+    SECTION("Denormals - the workers of a parallel chain flush the subnormal samples")
+    {
+        Chain chain;
+        std::vector<std::shared_ptr<Decay>> decays;
+        std::vector<std::shared_ptr<Processor>> outputs;
+        
+        for(size_t i = 0; i < 32; ++i)
+        {
+            decays.emplace_back(new Decay());
+            outputs.emplace_back(new NullOutput());
+            
+            chain.addProcessor(decays.back());
+            chain.addProcessor(outputs.back());
+            chain.connect(*decays.back(), 0, *outputs.back(), 0);
+        }
+        
+        chain.setThreadPool(std::make_shared<ThreadPool>(4ul));
+        chain.setCountingDenormals(true);
+        
+        REQUIRE_NOTHROW(chain.prepare(44100ul, 64ul));
+        
+        CHECK(chain.isParallel());
+        
+        Denormals::setFlushing(true);
+        chain.tick();
+        Denormals::setFlushing(false);
+        
+        CHECK_FALSE(Denormals::isFlushingThread());
+        
+        for(auto const& decay : decays)
+        {
+            CHECK(decay->m_flushing == Denormals::isSupported());
+            CHECK(chain.collectDenormals(*decay) == std::vector<size_t>({Denormals::isSupported() ? 0ul : nsubnormals}));
+        }
+        
+        chain.release();
+    }
+}
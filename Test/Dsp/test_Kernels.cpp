@@ -0,0 +1,220 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Kernels.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                       KERNELS                                    //
+// ================================================================================ //
+
+namespace
+{
+    std::vector<sample_t> makeSamples(size_t size, sample_t offset)
+    {
+        std::vector<sample_t> samples(size);
+        
+        for(size_t i = 0; i < size; ++i)
+        {
+            samples[i] = (i % 3 == 0) ? sample_t(0) : sample_t((int(i % 11) - 5) * 0.25 + offset);
+        }
+        
+        return samples;
+    }
+    
+    void checkEqual(std::vector<sample_t> const& lhs, std::vector<sample_t> const& rhs)
+    {
+        REQUIRE(lhs.size() == rhs.size());
+        
+        for(size_t i = 0; i < lhs.size(); ++i)
+        {
+            CHECK(lhs[i] == Approx(rhs[i]));
+        }
+    }
+}
+
+TEST_CASE("Dsp - Kernels", "[Dsp, Kernels]")
+{
+    Kernels const& scalar = *Kernels::get(Kernels::Isa::Scalar);
+    
+    SECTION("Kernels - scalar is always supported")
+    {
+        CHECK(Kernels::get(Kernels::Isa::Scalar) != nullptr);
+        CHECK(scalar.isa == Kernels::Isa::Scalar);
+        CHECK(std::string(Kernels::getName(Kernels::get().isa)) != "unknown");
+    }
+    
+    SECTION("Kernels - scalar results")
+    {
+        std::vector<sample_t> lhs {1., 2., 3., -4.};
+        std::vector<sample_t> rhs {1., 0., 4., 2.};
+        std::vector<sample_t> out(4);
+        
+        scalar.div(lhs.data(), rhs.data(), out.data(), 4);
+        checkEqual(out, {1., 0., 0.75, -2.});
+        
+        scalar.less(lhs.data(), rhs.data(), out.data(), 4);
+        checkEqual(out, {0., 0., 1., 1.});
+        
+        scalar.notEqualValue(lhs.data(), 2., out.data(), 4);
+        checkEqual(out, {1., 0., 1., 1.});
+        
+        scalar.clamp(lhs.data(), -1., 2.5, out.data(), 4);
+        checkEqual(out, {1., 2., 2.5, -1.});
+        
+        scalar.mulAddValue(lhs.data(), 2., 1., out.data(), 4);
+        checkEqual(out, {3., 5., 7., -7.});
+        
+        CHECK(scalar.absMax(lhs.data(), 4) == 4.);
+        
+        std::vector<Kernels::Stage> const stages
+        {
+            {Kernels::Operation::Sub, rhs.data(), 0.},
+            {Kernels::Operation::Mul, nullptr, 2.},
+            {Kernels::Operation::LessEqual, nullptr, 0.}
+        };
+        
+        scalar.fused(stages.data(), 2, lhs.data(), out.data(), 4);
+        checkEqual(out, {0., 4., -2., -12.});
+        
+        scalar.fused(stages.data(), 3, lhs.data(), out.data(), 4);
+        checkEqual(out, {1., 0., 1., 1.});
+        
+        // a period of 4 points, the last phase is interpolated between the last point and the first.
+        std::vector<sample_t> table {0., 1., 2., 3., 0.};
+        std::vector<uint32_t> phases {0x40000000u, 0x20000000u, 0x70000000u, 0xe0000000u};
+        
+        scalar.lookup(table.data(), 2ul, phases.data(), out.data(), 4);
+        checkEqual(out, {1., 0.5, 1.75, 1.5});
+    }
+    
+    SECTION("Kernels - instruction sets match scalar")
+    {
+        for(Kernels::Isa isa : {Kernels::Isa::Sse2, Kernels::Isa::Avx2, Kernels::Isa::Avx512})
+        {
+            Kernels const* kernels = Kernels::get(isa);
+            
+            if(kernels == nullptr)
+            {
+                continue;
+            }
+            
+            INFO("isa: " << Kernels::getName(isa));
+            
+            CHECK(kernels->isa == isa);
+            
+            for(size_t size : {1ul, 3ul, 16ul, 37ul, 64ul, 257ul})
+            {
+                INFO("size: " << size);
+                
+                std::vector<sample_t> const lhs = makeSamples(size, 0.);
+                std::vector<sample_t> const rhs = makeSamples(size, 0.5);
+                std::vector<sample_t> const add = makeSamples(size, -1.);
+                std::vector<sample_t> expected(size);
+                std::vector<sample_t> result(size);
+                
+                for(auto binary : {&Kernels::add, &Kernels::sub, &Kernels::mul, &Kernels::div,
+                                   &Kernels::less, &Kernels::lessEqual, &Kernels::greater,
+                                   &Kernels::greaterEqual, &Kernels::equal, &Kernels::notEqual})
+                {
+                    (scalar.*binary)(lhs.data(), rhs.data(), expected.data(), size);
+                    (kernels->*binary)(lhs.data(), rhs.data(), result.data(), size);
+                    checkEqual(result, expected);
+                }
+                
+                for(auto binary : {&Kernels::addValue, &Kernels::subValue, &Kernels::mulValue,
+                                   &Kernels::divValue, &Kernels::lessValue, &Kernels::lessEqualValue,
+                                   &Kernels::greaterValue, &Kernels::greaterEqualValue,
+                                   &Kernels::equalValue, &Kernels::notEqualValue})
+                {
+                    for(sample_t value : {sample_t(0.), sample_t(0.75)})
+                    {
+                        (scalar.*binary)(lhs.data(), value, expected.data(), size);
+                        (kernels->*binary)(lhs.data(), value, result.data(), size);
+                        checkEqual(result, expected);
+                    }
+                }
+                
+                scalar.mulAdd(lhs.data(), rhs.data(), add.data(), expected.data(), size);
+                kernels->mulAdd(lhs.data(), rhs.data(), add.data(), result.data(), size);
+                checkEqual(result, expected);
+                
+                scalar.mulAddValue(lhs.data(), 0.5, 2., expected.data(), size);
+                kernels->mulAddValue(lhs.data(), 0.5, 2., result.data(), size);
+                checkEqual(result, expected);
+                
+                scalar.clamp(lhs.data(), -0.5, 0.25, expected.data(), size);
+                kernels->clamp(lhs.data(), -0.5, 0.25, result.data(), size);
+                checkEqual(result, expected);
+                
+                kernels->copy(lhs.data(), result.data(), size);
+                checkEqual(result, lhs);
+                
+                kernels->fill(0.125, result.data(), size);
+                checkEqual(result, std::vector<sample_t>(size, 0.125));
+                
+                CHECK(kernels->absMax(lhs.data(), size) == scalar.absMax(lhs.data(), size));
+                
+                std::vector<Kernels::Stage> const stages
+                {
+                    {Kernels::Operation::Mul, rhs.data(), 0.},
+                    {Kernels::Operation::Add, nullptr, 0.5},
+                    {Kernels::Operation::Div, add.data(), 0.},
+                    {Kernels::Operation::Sub, nullptr, 0.25},
+                    {Kernels::Operation::GreaterEqual, rhs.data(), 0.}
+                };
+                
+                scalar.mul(lhs.data(), rhs.data(), expected.data(), size);
+                scalar.addValue(expected.data(), 0.5, expected.data(), size);
+                scalar.div(expected.data(), add.data(), expected.data(), size);
+                scalar.subValue(expected.data(), 0.25, expected.data(), size);
+                scalar.greaterEqual(expected.data(), rhs.data(), expected.data(), size);
+                
+                kernels->fused(stages.data(), stages.size(), lhs.data(), result.data(), size);
+                checkEqual(result, expected);
+                
+                // a table of 64 points read at phases spread over the period.
+                std::vector<sample_t> table(65);
+                std::vector<uint32_t> phases(size);
+                
+                for(size_t i = 0; i < table.size(); ++i)
+                {
+                    table[i] = sample_t((int(i % 7) - 3) * 0.5);
+                }
+                
+                for(size_t i = 0; i < size; ++i)
+                {
+                    phases[i] = uint32_t(i * 2654435761ul);
+                }
+                
+                scalar.lookup(table.data(), 6ul, phases.data(), expected.data(), size);
+                kernels->lookup(table.data(), 6ul, phases.data(), result.data(), size);
+                checkEqual(result, expected);
+            }
+        }
+    }
+}
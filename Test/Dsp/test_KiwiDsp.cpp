@@ -26,14 +26,70 @@
 #define CATCH_CONFIG_RUNNER
 #include "../catch.hpp"
 
+#include <KiwiDsp/KiwiDsp_RealTime.h>
+
+#if defined(KIWI_DSP_REALTIME_CHECK)
+
+// Fails the test cases that break the real-time rules, the violations are written to the error output.
+
+std::atomic<size_t> realtime_nviolations(0ul);
+std::vector<std::string> realtime_failures;
+
+void realtime_handler(kiwi::dsp::RealTime::Violation const& violation)
+{
+    realtime_nviolations.fetch_add(1ul);
+    
+    std::cerr << violation.m_call << " called by a real-time thread while performing "
+              << (violation.m_processor.empty() ? "the chain" : violation.m_processor) << '\n';
+}
+
+struct RealTimeListener : Catch::TestEventListenerBase
+{
+    using TestEventListenerBase::TestEventListenerBase;
+    
+    void testCaseStarting(Catch::TestCaseInfo const&) override
+    {
+        m_nviolations = realtime_nviolations.load();
+    }
+    
+    void testCaseEnded(Catch::TestCaseStats const& stats) override
+    {
+        if(realtime_nviolations.load() != m_nviolations)
+        {
+            realtime_failures.push_back(stats.testInfo.name);
+        }
+    }
+    
+    size_t m_nviolations = 0ul;
+};
+
+INTERNAL_CATCH_REGISTER_LISTENER(RealTimeListener)
+
+#endif
+
 int main( int argc, char* const argv[] )
 {
     // global setup...
+    #if defined(KIWI_DSP_REALTIME_CHECK)
+    kiwi::dsp::RealTime::setHandler(&realtime_handler);
+    #endif
+    
     std::cout << "running Unit-Tests - KiwiDsp ..." << '\n' << '\n';
     
     int result = Catch::Session().run( argc, argv );
     
     // global clean-up...
     
+    #if defined(KIWI_DSP_REALTIME_CHECK)
+    
+    for(auto const& name : realtime_failures)
+    {
+        std::cerr << "real-time rules broken by: " << name << '\n';
+    }
+    
+    result += static_cast<int>(realtime_failures.size());
+    
+    #endif
+    
     return result;
 }
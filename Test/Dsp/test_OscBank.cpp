@@ -0,0 +1,139 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_OscBank.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ==================================================================================== //
+//                                      TEST OSC BANK                                   //
+// ==================================================================================== //
+
+TEST_CASE("Dsp - OscBank", "[Dsp, OscBank]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    const double tolerance = 1e-4;
+    
+    std::vector<sample_t> output(vectorsize);
+    
+    SECTION("OscBank - a bank needs partials")
+    {
+        CHECK_THROWS_AS(OscBank(0ul), Error);
+        CHECK(OscBank(8ul).getNumberOfPartials() == 8ul);
+    }
+    
+    SECTION("OscBank - the silent partials output zeros")
+    {
+        OscBank bank(16ul);
+        bank.prepare(samplerate, vectorsize);
+        
+        output.assign(vectorsize, 1.);
+        bank.perform(output.data());
+        
+        CHECK(output == std::vector<sample_t>(vectorsize, 0.));
+    }
+    
+    SECTION("OscBank - the partials are summed")
+    {
+        OscBank bank(3ul);
+        bank.setSmoothing(0.);
+        bank.setFrequency(0ul, 441.);
+        bank.setAmplitude(0ul, 1.);
+        bank.setFrequency(1ul, 882.);
+        bank.setAmplitude(1ul, 0.5);
+        bank.setPhase(1ul, 0.25);
+        
+        // the partials out of the range are ignored.
+        bank.setAmplitude(3ul, 1.);
+        
+        bank.prepare(samplerate, vectorsize);
+        
+        // without smoothing the partials fade in over the first vector.
+        bank.perform(output.data());
+        
+        for(size_t tick = 1; tick < 4; ++tick)
+        {
+            bank.perform(output.data());
+            
+            for(size_t i = 0; i < vectorsize; ++i)
+            {
+                const double n = static_cast<double>(tick * vectorsize + i);
+                const double expected = std::cos(2. * pi * n * 441. / samplerate)
+                                      + 0.5 * std::cos(2. * pi * (n * 882. / samplerate + 0.25));
+                
+                CHECK(std::abs(output[i] - expected) < tolerance);
+            }
+        }
+    }
+    
+    SECTION("OscBank - the amplitudes are smoothed")
+    {
+        OscBank bank(1ul);
+        bank.setSmoothing(10.);
+        bank.setFrequency(0ul, 0.);
+        bank.setAmplitude(0ul, 1.);
+        bank.prepare(samplerate, vectorsize);
+        
+        // the gain of a null frequency rises continuously towards the amplitude.
+        sample_t previous = 0.;
+        
+        for(size_t tick = 0; tick < 8; ++tick)
+        {
+            bank.perform(output.data());
+            
+            for(size_t i = 0; i < vectorsize; ++i)
+            {
+                CHECK(output[i] > previous);
+                CHECK(output[i] - previous < 0.1);
+                CHECK(output[i] < 1.);
+                previous = output[i];
+            }
+        }
+        
+        // the gain reaches zero and the partial is skipped.
+        bank.setAmplitude(0ul, 0.);
+        
+        for(size_t tick = 0; tick < 200; ++tick)
+        {
+            bank.perform(output.data());
+        }
+        
+        CHECK(output == std::vector<sample_t>(vectorsize, 0.));
+        
+        // a new smoothing time is effective at the next vector.
+        bank.setSmoothing(0.);
+        bank.setAmplitude(0ul, 1.);
+        bank.perform(output.data());
+        
+        CHECK(output.back() == 1.);
+        
+        bank.perform(output.data());
+        
+        CHECK(output == std::vector<sample_t>(vectorsize, 1.));
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_RealTime.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ==================================================================================== //
+//                                     TEST REAL TIME                                   //
+// ==================================================================================== //
+
+namespace
+{
+    std::vector<RealTime::Violation> violations;
+    
+    void record(RealTime::Violation const& violation)
+    {
+        violations.push_back(violation);
+    }
+}
+
+TEST_CASE("Dsp - RealTime", "[Dsp, RealTime]")
+{
+    SECTION("RealTime - the threads are checked in a scope")
+    {
+        bool checked = false;
+        bool waived = true;
+        
+        CHECK(!RealTime::isChecked());
+        
+        // the assertions allocate, they're made out of the scope.
+        {
+            RealTime::Scope scope;
+            
+            {
+                RealTime::Waiver waiver;
+                waived = RealTime::isChecked();
+            }
+            
+            checked = RealTime::isChecked();
+        }
+        
+        CHECK(checked == RealTime::isEnabled());
+        CHECK(!waived);
+        CHECK(!RealTime::isChecked());
+    }
+    
+    SECTION("RealTime - the violations are reported with the processor")
+    {
+        Chain chain;
+        std::shared_ptr<Allocator> allocator(new Allocator());
+        
+        chain.addProcessor(allocator);
+        chain.prepare(44100ul, 64ul);
+        
+        violations.clear();
+        
+        RealTime::handler_t previous = RealTime::setHandler(&record);
+        const size_t nviolations = RealTime::getNumberOfViolations();
+        
+        chain.tick();
+        
+        RealTime::setHandler(previous);
+        
+        CHECK(allocator->m_checked == RealTime::isEnabled());
+        CHECK(RealTime::getNumberOfViolations() - nviolations == violations.size());
+        
+        if(RealTime::isEnabled())
+        {
+            REQUIRE(!violations.empty());
+            
+            bool allocation = false;
+            
+            for(auto const& violation : violations)
+            {
+                CHECK(violation.m_processor == "Allocator");
+                allocation |= violation.m_call == "operator new";
+            }
+            
+            CHECK(allocation);
+        }
+        else
+        {
+            CHECK(violations.empty());
+        }
+        
+        chain.release();
+    }
+}
@@ -0,0 +1,235 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <memory>
+#include <vector>
+#include <cmath>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Region.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ==================================================================================== //
+//                                      TEST REGION                                     //
+// ==================================================================================== //
+
+TEST_CASE("Dsp - Region", "[Dsp, Region]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    
+    SECTION("Region - block size")
+    {
+        Chain chain;
+        std::vector<sample_t> samples;
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Region> region(new Region(1ul, 1ul, 1ul, 16ul));
+        std::shared_ptr<Processor> recorder(new Recorder(samples));
+        std::shared_ptr<Processor> times(new TimesScalar(2.));
+        
+        region->getChain().addProcessor(times);
+        region->getChain().connect(region->getInlet(0ul), 0ul, *times, 0ul);
+        region->getChain().connect(*times, 0ul, region->getOutlet(0ul), 0ul);
+        
+        chain.addProcessor(count);
+        chain.addProcessor(region);
+        chain.addProcessor(recorder);
+        chain.connect(*count, 0ul, *region, 0ul);
+        chain.connect(*region, 0ul, *recorder, 0ul);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        CHECK(region->getChain().getSampleRate() == samplerate);
+        CHECK(region->getChain().getVectorSize() == 16ul);
+        CHECK(region->getLatency() == 0ul);
+        
+        for(size_t i = 0; i < 4; ++i)
+        {
+            chain.tick();
+        }
+        
+        REQUIRE(samples.size() == 4ul * vectorsize);
+        
+        for(size_t i = 0; i < samples.size(); ++i)
+        {
+            CHECK(samples[i] == 2. * i);
+        }
+        
+        chain.release();
+    }
+    
+    SECTION("Region - block size delayed through the fifos")
+    {
+        Chain chain;
+        std::vector<sample_t> samples;
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Region> region(new Region(1ul, 1ul, 1ul, 48ul));
+        std::shared_ptr<Processor> recorder(new Recorder(samples));
+        
+        region->getChain().connect(region->getInlet(0ul), 0ul, region->getOutlet(0ul), 0ul);
+        
+        chain.addProcessor(count);
+        chain.addProcessor(region);
+        chain.addProcessor(recorder);
+        chain.connect(*count, 0ul, *region, 0ul);
+        chain.connect(*region, 0ul, *recorder, 0ul);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        CHECK(region->getLatency() == 48ul);
+        
+        for(size_t i = 0; i < 6; ++i)
+        {
+            chain.tick();
+        }
+        
+        REQUIRE(samples.size() == 6ul * vectorsize);
+        
+        for(size_t i = 0; i < samples.size(); ++i)
+        {
+            CHECK(samples[i] == (i < 48ul ? 0. : i - 48.));
+        }
+        
+        chain.release();
+    }
+    
+    SECTION("Region - oversampling")
+    {
+        Chain chain;
+        std::vector<sample_t> samples;
+        
+        std::shared_ptr<Processor> osc(new Osc(1000.));
+        std::shared_ptr<Region> region(new Region(1ul, 1ul, 4ul));
+        std::shared_ptr<Processor> recorder(new Recorder(samples));
+        
+        region->getChain().connect(region->getInlet(0ul), 0ul, region->getOutlet(0ul), 0ul);
+        
+        chain.addProcessor(osc);
+        chain.addProcessor(region);
+        chain.addProcessor(recorder);
+        chain.connect(*osc, 0ul, *region, 0ul);
+        chain.connect(*region, 0ul, *recorder, 0ul);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        CHECK(region->getChain().getSampleRate() == 4ul * samplerate);
+        CHECK(region->getChain().getVectorSize() == 4ul * vectorsize);
+        
+        const size_t latency = region->getLatency();
+        CHECK(latency > 0ul);
+        CHECK(latency < vectorsize);
+        
+        for(size_t i = 0; i < 16; ++i)
+        {
+            chain.tick();
+        }
+        
+        // the sine goes through the filters with the latency of the region.
+        const double increment = 2. * pi * 1000. / samplerate;
+        
+        for(size_t i = vectorsize; i < samples.size(); ++i)
+        {
+            const double expected = std::sin(increment * (i - latency));
+            CHECK(std::abs(samples[i] - expected) < 0.01);
+        }
+        
+        chain.release();
+    }
+    
+    SECTION("Region - oversampling removes the frequencies above the Nyquist frequency")
+    {
+        Chain chain;
+        std::vector<sample_t> samples;
+        
+        std::shared_ptr<Region> region(new Region(0ul, 1ul, 4ul));
+        std::shared_ptr<Processor> recorder(new Recorder(samples));
+        std::shared_ptr<Processor> osc(new Osc(40000.));
+        
+        region->getChain().addProcessor(osc);
+        region->getChain().connect(*osc, 0ul, region->getOutlet(0ul), 0ul);
+        
+        chain.addProcessor(region);
+        chain.addProcessor(recorder);
+        chain.connect(*region, 0ul, *recorder, 0ul);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        for(size_t i = 0; i < 16; ++i)
+        {
+            chain.tick();
+        }
+        
+        // without the filter, the sine would alias at 4100Hz.
+        for(size_t i = vectorsize; i < samples.size(); ++i)
+        {
+            CHECK(std::abs(samples[i]) < 0.01);
+        }
+        
+        chain.release();
+    }
+    
+    SECTION("Region - updating the sub-chain")
+    {
+        Chain chain;
+        std::vector<sample_t> samples;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Region> region(new Region(1ul, 1ul, 1ul, 32ul));
+        std::shared_ptr<Processor> recorder(new Recorder(samples));
+        std::shared_ptr<Processor> plus(new PlusScalar(1.));
+        
+        region->getChain().connect(region->getInlet(0ul), 0ul, region->getOutlet(0ul), 0ul);
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(region);
+        chain.addProcessor(recorder);
+        chain.connect(*sig, 0ul, *region, 0ul);
+        chain.connect(*region, 0ul, *recorder, 0ul);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        chain.tick();
+        
+        CHECK(samples == std::vector<sample_t>(vectorsize, 1.));
+        
+        region->getChain().addProcessor(plus);
+        region->getChain().disconnect(region->getInlet(0ul), 0ul, region->getOutlet(0ul), 0ul);
+        region->getChain().connect(region->getInlet(0ul), 0ul, *plus, 0ul);
+        region->getChain().connect(*plus, 0ul, region->getOutlet(0ul), 0ul);
+        region->getChain().update();
+        
+        samples.clear();
+        chain.tick();
+        chain.tick();
+        
+        CHECK(std::vector<sample_t>(samples.end() - vectorsize, samples.end()) == std::vector<sample_t>(vectorsize, 2.));
+        
+        chain.release();
+    }
+}
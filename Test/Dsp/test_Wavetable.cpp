@@ -0,0 +1,106 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Wavetable.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ==================================================================================== //
+//                                     TEST WAVETABLE                                   //
+// ==================================================================================== //
+
+TEST_CASE("Dsp - Wavetable", "[Dsp, Wavetable]")
+{
+    SECTION("Wavetable - the phases are converted to fixed point")
+    {
+        CHECK(Wavetable::toPhase(0.) == 0u);
+        CHECK(Wavetable::toPhase(0.25) == 0x40000000u);
+        CHECK(Wavetable::toPhase(1.75) == 0xc0000000u);
+        CHECK(Wavetable::toPhase(-0.25) == 0xc0000000u);
+        CHECK(Wavetable::toPhase(-1e-20) == 0u);
+        
+        CHECK(Wavetable::toPeriods(0u) == 0.);
+        CHECK(Wavetable::toPeriods(0x80000000u) == 0.5);
+        CHECK(Wavetable::toPeriods(0xffffffffu) < 1.);
+        
+        // the increments wrap around the period.
+        Wavetable::phase_t phase = Wavetable::toPhase(0.75);
+        phase += Wavetable::toPhase(0.5);
+        
+        CHECK(Wavetable::toPeriods(phase) == 0.25);
+    }
+    
+    SECTION("Wavetable - the size of a table depends on its quality")
+    {
+        Wavetable const& low = Wavetable::getCosine(60.);
+        Wavetable const& high = Wavetable::getCosine(120.);
+        
+        CHECK(low.getSize() == 128ul);
+        CHECK(low.getTableQuality() >= 60.);
+        CHECK(high.getSize() == 4096ul);
+        CHECK(high.getTableQuality() >= 120.);
+        
+        // the tables are shared and clipped to the range of resolutions.
+        CHECK(&Wavetable::getCosine(119.) == &high);
+        CHECK(Wavetable::getCosine(0.).getResolution() == 6ul);
+        CHECK(Wavetable::getCosine(1000.).getResolution() == 16ul);
+        
+        CHECK(Wavetable::getQuality() == 120.);
+        CHECK(&Wavetable::getCosine() == &high);
+    }
+    
+    SECTION("Wavetable - the cosine is read within the quality of the table")
+    {
+        for(double quality : {60., 90., 120.})
+        {
+            Wavetable const& table = Wavetable::getCosine(quality);
+            const double tolerance = std::pow(10., -quality / 20.) + std::numeric_limits<sample_t>::epsilon();
+            
+            std::vector<Wavetable::phase_t> phases(1000ul);
+            std::vector<sample_t> result(phases.size());
+            
+            for(size_t i = 0; i < phases.size(); ++i)
+            {
+                phases[i] = Wavetable::toPhase(i * 0.0123);
+            }
+            
+            table.read(phases.data(), result.data(), phases.size());
+            
+            double error = 0.;
+            
+            for(size_t i = 0; i < phases.size(); ++i)
+            {
+                const double expected = std::cos(2. * pi * Wavetable::toPeriods(phases[i]));
+                error = std::max(error, std::abs(result[i] - expected));
+                
+                CHECK(table.read(phases[i]) == Approx(result[i]));
+            }
+            
+            INFO("quality: " << quality);
+            CHECK(error <= tolerance);
+        }
+    }
+}
@@ -0,0 +1,578 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#define CATCH_CONFIG_RUNNER
+
+#include <vector>
+#include <array>
+#include <string>
+#include <cstring>
+#include <memory>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+
+#include "../catch.hpp"
+
+#include <flip/Document.h>
+#include <flip/DocumentObserver.h>
+
+#include <KiwiTool/KiwiTool_Atom.h>
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiModel/KiwiModel_Factory.h>
+#include <KiwiModel/KiwiModel_DocumentManager.h>
+#include <KiwiModel/KiwiModel_PatcherValidator.h>
+#include <KiwiEngine/KiwiEngine_AudioControler.h>
+#include <KiwiEngine/KiwiEngine_Instance.h>
+#include <KiwiEngine/KiwiEngine_Patcher.h>
+#include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Objects.h>
+
+using namespace kiwi;
+
+// ================================================================================ //
+//                              TOPOLOGIES BENCHMARK                                //
+// ================================================================================ //
+
+// Run with : benchmark_topologies [--json <path>] [catch options]
+// Without a test spec all the benchmarks are run. The results of the topologies benchmark
+// are also written in the json file when a path is given.
+
+namespace
+{
+    const size_t samplerate = 44100ul;
+    const size_t nsamples = 1ul << 18;
+    
+    // The path of the json file, empty if the results are only printed.
+    std::string json_path;
+    
+    //! @brief An audio controler that ticks the chains for a device that discards its outputs.
+    //! @details The dac~ objects still add their signals to the output channels like with a device.
+    class NullAudioControler : public engine::AudioControler
+    {
+    public: // methods
+        
+        NullAudioControler(size_t nchannels, size_t block_size) :
+        m_block_size(block_size),
+        m_output_matrix(nchannels, block_size),
+        m_chains(),
+        m_is_playing(false)
+        {
+        }
+        
+        ~NullAudioControler()
+        {
+            stopAudio();
+        }
+        
+        void startAudio() override final
+        {
+            if(!m_is_playing)
+            {
+                for(dsp::Chain * chain : m_chains)
+                {
+                    chain->prepare(samplerate, m_block_size);
+                }
+                
+                m_is_playing = true;
+            }
+        }
+        
+        void stopAudio() override final
+        {
+            if(m_is_playing)
+            {
+                for(dsp::Chain * chain : m_chains)
+                {
+                    chain->release();
+                }
+                
+                m_is_playing = false;
+            }
+        }
+        
+        bool isAudioOn() const override final
+        {
+            return m_is_playing;
+        }
+        
+        void add(dsp::Chain& chain) override final
+        {
+            if(std::find(m_chains.begin(), m_chains.end(), &chain) == m_chains.cend())
+            {
+                if(m_is_playing)
+                {
+                    chain.prepare(samplerate, m_block_size);
+                }
+                
+                m_chains.push_back(&chain);
+            }
+        }
+        
+        void remove(dsp::Chain& chain) override final
+        {
+            const auto it = std::find(m_chains.begin(), m_chains.end(), &chain);
+            
+            if(it != m_chains.cend())
+            {
+                (*it)->release();
+                m_chains.erase(it);
+            }
+        }
+        
+        void addToChannel(size_t const channel, dsp::Signal const& output_signal) override final
+        {
+            if(channel < m_output_matrix.getNumberOfChannels() && output_signal.size() == m_block_size)
+            {
+                m_output_matrix[channel].add(output_signal);
+            }
+        }
+        
+        void getFromChannel(size_t const, dsp::Signal & input_signal) override final
+        {
+            input_signal.fill(0);
+        }
+        
+        size_t getNumberOfOutputChannels() const override final
+        {
+            return m_output_matrix.getNumberOfChannels();
+        }
+        
+        //! @brief Ticks the chains and clears the output channels.
+        void tick()
+        {
+            for(dsp::Chain * chain : m_chains)
+            {
+                chain->tick();
+            }
+            
+            for(size_t i = 0; i < m_output_matrix.getNumberOfChannels(); ++i)
+            {
+                m_output_matrix[i].fill(0);
+            }
+        }
+        
+        //! @brief Returns the size of the signals of the chains.
+        size_t getSignalMemorySize() const
+        {
+            size_t size = 0ul;
+            
+            for(dsp::Chain const* chain : m_chains)
+            {
+                size += chain->getSignalMemorySize();
+            }
+            
+            return size;
+        }
+        
+    private: // members
+        
+        const size_t                m_block_size;
+        dsp::Buffer                 m_output_matrix;
+        std::vector<dsp::Chain*>    m_chains;
+        bool                        m_is_playing;
+    };
+    
+    //! @brief A patcher made of the texts of its objects and of its links.
+    //! @details A link is the index of its sender, its outlet, the index of its receiver and its inlet.
+    struct Patch
+    {
+        std::vector<std::string>            objects;
+        std::vector<std::array<size_t, 4>>  links;
+        
+        //! @brief Adds an object and returns its index.
+        size_t add(std::string const& text)
+        {
+            objects.push_back(text);
+            return objects.size() - 1;
+        }
+        
+        //! @brief Returns the number of signal objects, the ones whose name ends with a tilde.
+        size_t getNumberOfNodes() const
+        {
+            size_t nnodes = 0ul;
+            
+            for(std::string const& text : objects)
+            {
+                const std::string name = text.substr(0, text.find(' '));
+                nnodes += (!name.empty() && name.back() == '~') ? 1ul : 0ul;
+            }
+            
+            return nnodes;
+        }
+    };
+    
+    //! @brief Instantiates a patch in the engine like the renderer does with a .kiwi file.
+    class Loader : public flip::DocumentObserver<model::Patcher>
+    {
+    public: // methods
+        
+        Loader(engine::Instance& instance) :
+        m_instance(instance),
+        m_validator(),
+        m_document(model::DataModel::use(), *this, m_validator, flip::Ref::User::Offline, 'cicm', 'kpat')
+        {
+        }
+        
+        ~Loader() = default;
+        
+        //! @brief Adds the objects and the links of the patch then sends the loadbang.
+        void load(Patch const& patch)
+        {
+            model::Patcher& patcher = m_document.root<model::Patcher>();
+            std::vector<model::Object*> objects;
+            
+            for(std::string const& text : patch.objects)
+            {
+                objects.push_back(&patcher.addObject(model::Factory::create(tool::AtomHelper::parse(text))));
+            }
+            
+            for(auto const& link : patch.links)
+            {
+                REQUIRE(patcher.addLink(*objects[link[0]], link[1], *objects[link[2]], link[3]) != nullptr);
+            }
+            
+            m_document.commit();
+            
+            patcher.entity().use<engine::Patcher>().sendLoadbang();
+        }
+        
+    private: // methods
+        
+        void document_changed(model::Patcher& patcher) override final
+        {
+            if(patcher.added())
+            {
+                patcher.entity().emplace<model::DocumentManager>(patcher.document());
+                patcher.entity().emplace<engine::Patcher>(m_instance, patcher);
+            }
+            
+            patcher.entity().use<engine::Patcher>().modelChanged(patcher);
+            
+            if(patcher.removed())
+            {
+                patcher.entity().erase<engine::Patcher>();
+                patcher.entity().erase<model::DocumentManager>();
+            }
+        }
+        
+    private: // members
+        
+        engine::Instance&           m_instance;
+        model::PatcherValidator     m_validator;
+        flip::Document              m_document;
+    };
+    
+    //! @brief The result of the ticks of a patch.
+    struct Measure
+    {
+        double  time;
+        double  prepare_time;
+        size_t  memory;
+    };
+    
+    //! @brief Loads a patch in an instance and measures the ticks of its chain in nanoseconds per sample.
+    Measure measure(Patch const& patch, size_t vectorsize)
+    {
+        std::unique_ptr<NullAudioControler> audio_controler(new NullAudioControler(2ul, vectorsize));
+        NullAudioControler& device = *audio_controler;
+        
+        tool::Scheduler<> main_scheduler;
+        main_scheduler.setLogicalTime(tool::Scheduler<>::time_point_t());
+        
+        engine::Instance instance(std::move(audio_controler), main_scheduler, true);
+        
+        Loader loader(instance);
+        loader.load(patch);
+        
+        const size_t nticks = nsamples / vectorsize;
+        
+        dsp::Timer timer;
+        timer.start();
+        
+        device.startAudio();
+        
+        Measure result;
+        result.prepare_time = timer.get<dsp::Timer::microseconds>(false);
+        result.memory = device.getSignalMemorySize();
+        
+        for(size_t i = 0; i < nticks / 10; ++i)
+        {
+            device.tick();
+        }
+        
+        timer.start();
+        
+        for(size_t i = 0; i < nticks; ++i)
+        {
+            device.tick();
+        }
+        
+        result.time = timer.get<dsp::Timer::nanoseconds>(false) / (nticks * vectorsize);
+        
+        device.stopAudio();
+        
+        return result;
+    }
+    
+    struct Topology
+    {
+        std::string             name;
+        std::function<Patch()>  build;
+    };
+    
+    // 64 independent osc~ -> *~ -> dac~ voices.
+    Patch buildParallel()
+    {
+        Patch patch;
+        
+        for(size_t i = 0; i < 64ul; ++i)
+        {
+            const size_t osc = patch.add("osc~ " + std::to_string(110 + i));
+            const size_t times = patch.add("*~ 0.5");
+            const size_t dac = patch.add("dac~");
+            
+            patch.links.push_back({osc, 0, times, 0});
+            patch.links.push_back({times, 0, dac, 0});
+        }
+        
+        return patch;
+    }
+    
+    // osc~ -> 256 *~ in series -> dac~, the source isn't constant so that nothing is folded.
+    Patch buildSerial()
+    {
+        Patch patch;
+        
+        size_t previous = patch.add("osc~ 440");
+        
+        for(size_t i = 0; i < 256ul; ++i)
+        {
+            const size_t times = patch.add("*~ 1");
+            
+            patch.links.push_back({previous, 0, times, 0});
+            previous = times;
+        }
+        
+        const size_t dac = patch.add("dac~");
+        patch.links.push_back({previous, 0, dac, 0});
+        
+        return patch;
+    }
+    
+    // osc~ fanning out to 128 *~ that fan in a dac~.
+    Patch buildFan()
+    {
+        Patch patch;
+        
+        const size_t osc = patch.add("osc~ 440");
+        const size_t dac = patch.add("dac~");
+        
+        for(size_t i = 0; i < 128ul; ++i)
+        {
+            const size_t times = patch.add("*~ 0.0078125");
+            
+            patch.links.push_back({osc, 0, times, 0});
+            patch.links.push_back({times, 0, dac, 0});
+        }
+        
+        return patch;
+    }
+    
+    // 16 voices of (osc~ *~ line~) +~ (noise~ *~ 0.1) -> delaysimple~ mixed in a dac~.
+    // the line~ objects ramp over the whole measure from the loadbang.
+    Patch buildEngine()
+    {
+        Patch patch;
+        
+        const size_t loadmess = patch.add("loadmess 1 6000");
+        const size_t dac = patch.add("dac~");
+        
+        for(size_t i = 0; i < 16ul; ++i)
+        {
+            const size_t osc = patch.add("osc~ " + std::to_string(110 * (i + 1)));
+            const size_t line = patch.add("line~ 0 0");
+            const size_t envelope = patch.add("*~");
+            const size_t noise = patch.add("noise~");
+            const size_t level = patch.add("*~ 0.1");
+            const size_t mix = patch.add("+~");
+            const size_t delay = patch.add("delaysimple~ " + std::to_string(10 * (i + 1)) + " 0.5");
+            
+            patch.links.push_back({loadmess, 0, line, 0});
+            patch.links.push_back({osc, 0, envelope, 0});
+            patch.links.push_back({line, 0, envelope, 1});
+            patch.links.push_back({noise, 0, level, 0});
+            patch.links.push_back({envelope, 0, mix, 0});
+            patch.links.push_back({level, 0, mix, 1});
+            patch.links.push_back({mix, 0, delay, 0});
+            patch.links.push_back({delay, 0, dac, 0});
+        }
+        
+        return patch;
+    }
+    
+    // 64 osc~ -> *~ -> dac~ voices carried by a single 64-channel cord.
+    Patch buildMultichannel()
+    {
+        Patch patch;
+        
+        std::string frequencies;
+        
+        for(size_t i = 0; i < 64ul; ++i)
+        {
+            frequencies += " " + std::to_string(110 + i);
+        }
+        
+        const size_t osc = patch.add("osc~" + frequencies);
+        const size_t times = patch.add("*~ 0.5");
+        const size_t dac = patch.add("dac~");
+        
+        patch.links.push_back({osc, 0, times, 0});
+        patch.links.push_back({times, 0, dac, 0});
+        
+        return patch;
+    }
+}
+
+TEST_CASE("Engine - Chain topologies benchmark", "[Engine, Chain][benchmark][.]")
+{
+    const std::vector<Topology> topologies
+    {
+        {"parallel", &buildParallel},
+        {"serial", &buildSerial},
+        {"fan", &buildFan},
+        {"engine", &buildEngine}
+    };
+    
+    std::ofstream json;
+    
+    if(!json_path.empty())
+    {
+        json.open(json_path);
+        
+        if(!json.is_open())
+        {
+            std::cerr << "Cannot open " << json_path << '\n';
+        }
+    }
+    
+    json << std::fixed;
+    
+    json << "{\n  \"sample_rate\": " << samplerate << ",\n  \"results\": [";
+    
+    std::cout << "Chain topologies benchmark (" << nsamples << " samples per measure)\n";
+    std::cout << std::setw(10) << "topology" << std::setw(8) << "nodes" << std::setw(8) << "vector"
+    << std::setw(18) << "ns/sample/node" << std::setw(14) << "prepare us" << std::setw(14) << "memory kB" << '\n';
+    
+    bool first = true;
+    
+    for(auto const& topology : topologies)
+    {
+        const Patch patch = topology.build();
+        const size_t nnodes = patch.getNumberOfNodes();
+        
+        for(size_t vectorsize : {16ul, 64ul, 256ul, 1024ul, 2048ul})
+        {
+            const Measure result = measure(patch, vectorsize);
+            const double time = result.time / nnodes;
+            
+            std::cout << std::setw(10) << topology.name << std::setw(8) << nnodes << std::setw(8) << vectorsize
+            << std::setw(18) << std::setprecision(3) << std::fixed << time
+            << std::setw(14) << std::setprecision(1) << result.prepare_time
+            << std::setw(14) << result.memory / 1024. << '\n';
+            
+            json << (first ? "\n" : ",\n") << "    {\"topology\": \"" << topology.name << "\", \"nodes\": " << nnodes
+            << ", \"vector_size\": " << vectorsize << ", \"ns_per_sample_per_node\": " << std::setprecision(4) << time
+            << ", \"prepare_us\": " << std::setprecision(1) << result.prepare_time
+            << ", \"memory_bytes\": " << result.memory << "}";
+            
+            first = false;
+        }
+    }
+    
+    json << "\n  ]\n}\n";
+    
+    std::cout << '\n';
+}
+
+TEST_CASE("Engine - Chain multichannel benchmark", "[Engine, Chain][benchmark][.]")
+{
+    const std::vector<Topology> topologies
+    {
+        {"64 mono", &buildParallel},
+        {"64 chans", &buildMultichannel}
+    };
+    
+    std::cout << "Chain multichannel benchmark (" << nsamples << " samples per measure)\n";
+    std::cout << std::setw(10) << "voices" << std::setw(8) << "nodes" << std::setw(8) << "vector"
+    << std::setw(14) << "ns/sample" << std::setw(14) << "prepare us" << '\n';
+    
+    for(size_t vectorsize : {16ul, 64ul, 256ul, 1024ul})
+    {
+        for(auto const& topology : topologies)
+        {
+            const Patch patch = topology.build();
+            const Measure result = measure(patch, vectorsize);
+            
+            std::cout << std::setw(10) << topology.name << std::setw(8) << patch.getNumberOfNodes()
+            << std::setw(8) << vectorsize << std::setw(14) << std::setprecision(1) << std::fixed << result.time
+            << std::setw(14) << result.prepare_time << '\n';
+        }
+    }
+    
+    std::cout << '\n';
+}
+
+// ================================================================================ //
+//                                       MAIN                                       //
+// ================================================================================ //
+
+int main(int argc, char* argv[])
+{
+    std::vector<char*> args(argv, argv + argc);
+    
+    for(auto it = args.begin() + 1; it != args.end(); ++it)
+    {
+        if(std::strcmp(*it, "--json") == 0 && it + 1 != args.end())
+        {
+            json_path = *(it + 1);
+            args.erase(it, it + 2);
+            break;
+        }
+    }
+    
+    model::DataModel::init();
+    
+    engine::declareObjects();
+    
+    // the benchmarks are hidden, they are run when no test spec is given.
+    char benchmarks[] = "[benchmark]";
+    
+    if(args.size() == 1)
+    {
+        args.push_back(benchmarks);
+    }
+    
+    return Catch::Session().run(static_cast<int>(args.size()), args.data());
+}
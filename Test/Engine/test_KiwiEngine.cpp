@@ -23,10 +23,19 @@
 
 #include "../catch.hpp"
 
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_Objects.h>
+
+using namespace kiwi;
+
 int main( int argc, char* const argv[] )
 {
     std::cout << "running Unit-Tests - KiwiEngine ..." << '\n' << '\n';
     
+    model::DataModel::init();
+    
+    engine::declareObjects();
+    
     int result = Catch::Session().run( argc, argv );
     
     return result;
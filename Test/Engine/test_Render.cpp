@@ -0,0 +1,244 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <flip/Document.h>
+#include <flip/BackEndIR.h>
+#include <flip/BackEndBinary.h>
+#include <flip/contrib/DataConsumerFile.h>
+
+#include <KiwiTool/KiwiTool_Atom.h>
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiModel/KiwiModel_Factory.h>
+#include <KiwiModel/KiwiModel_PatcherValidator.h>
+
+#include <KiwiRender_FileAudioControler.h>
+#include <KiwiRender_Renderer.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                          RENDER                                      //
+// ==================================================================================== //
+
+namespace
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 64ul;
+    
+    //! @brief A patcher made of the texts of its objects and of its links.
+    //! @details A link is the index of its sender, its outlet, the index of its receiver and its inlet.
+    struct Patch
+    {
+        std::vector<std::string>            objects;
+        std::vector<std::array<size_t, 4>>  links;
+    };
+    
+    //! @brief Saves the patch in a .kiwi file, renders it like kiwi-render and reads the wav file back.
+    //! @return The samples of each channel.
+    std::vector<std::vector<float>> render(Patch const& patch, size_t nchannels, size_t nsamples)
+    {
+        const std::string patcher_path = "test_render.kiwi";
+        const std::string wav_path = "test_render.wav";
+        
+        {
+            model::PatcherValidator validator;
+            flip::Document document(model::DataModel::use(), validator, 123456789ULL, 'cicm', 'kpat');
+            
+            model::Patcher& patcher = document.root<model::Patcher>();
+            std::vector<model::Object*> objects;
+            
+            for(std::string const& text : patch.objects)
+            {
+                objects.push_back(&patcher.addObject(model::Factory::create(tool::AtomHelper::parse(text))));
+            }
+            
+            for(auto const& link : patch.links)
+            {
+                REQUIRE(patcher.addLink(*objects[link[0]], link[1], *objects[link[2]], link[3]) != nullptr);
+            }
+            
+            document.commit();
+            
+            flip::BackEndIR back_end = document.write();
+            flip::DataConsumerFile consumer(patcher_path.c_str());
+            back_end.write<flip::BackEndBinary>(consumer);
+        }
+        
+        {
+            std::unique_ptr<render::FileAudioControler> audio_controler(new render::FileAudioControler(wav_path,
+                                                                                                        nchannels,
+                                                                                                        samplerate,
+                                                                                                        vectorsize));
+            REQUIRE(audio_controler->isOpen());
+            
+            render::FileAudioControler& file = *audio_controler;
+            
+            tool::Scheduler<> main_scheduler;
+            main_scheduler.setLogicalTime(tool::Scheduler<>::time_point_t());
+            
+            engine::Instance instance(std::move(audio_controler), main_scheduler, true);
+            
+            render::Renderer renderer(instance, file);
+            
+            REQUIRE(renderer.load(patcher_path));
+            
+            file.startAudio();
+            renderer.render(nsamples);
+        }
+        
+        // the header of the float wav file written by the FileAudioControler is 58 bytes long.
+        std::ifstream wav(wav_path, std::ios::binary);
+        REQUIRE(wav.good());
+        
+        std::vector<float> interleaved(nsamples * nchannels);
+        wav.seekg(58);
+        wav.read(reinterpret_cast<char*>(interleaved.data()), interleaved.size() * sizeof(float));
+        REQUIRE(wav.gcount() == static_cast<std::streamsize>(interleaved.size() * sizeof(float)));
+        wav.close();
+        
+        std::remove(patcher_path.c_str());
+        std::remove(wav_path.c_str());
+        
+        std::vector<std::vector<float>> channels(nchannels, std::vector<float>(nsamples));
+        
+        for(size_t i = 0; i < nsamples; ++i)
+        {
+            for(size_t channel = 0; channel < nchannels; ++channel)
+            {
+                channels[channel][i] = interleaved[i * nchannels + channel];
+            }
+        }
+        
+        return channels;
+    }
+    
+    //! @brief Returns the peak of the samples from a start.
+    float peak(std::vector<float> const& samples, size_t start)
+    {
+        float result = 0.f;
+        
+        for(size_t i = start; i < samples.size(); ++i)
+        {
+            result = std::max(result, std::abs(samples[i]));
+        }
+        
+        return result;
+    }
+    
+    //! @brief Returns true if the samples repeat every period from a start.
+    bool isPeriodic(std::vector<float> const& samples, size_t start, size_t period)
+    {
+        for(size_t i = start; i + period < samples.size(); ++i)
+        {
+            if(std::abs(samples[i] - samples[i + period]) > 1e-3f)
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+}
+
+TEST_CASE("Engine - Render", "[Engine, Render]")
+{
+    const size_t nsamples = 4410ul;
+    const size_t start = 2205ul;
+    
+    SECTION("osc~ to dac~")
+    {
+        const auto channels = render({{"osc~ 441", "dac~"}, {{0, 0, 1, 0}, {0, 0, 1, 1}}}, 2ul, nsamples);
+        
+        for(auto const& channel : channels)
+        {
+            CHECK(peak(channel, start) == Approx(1.f).epsilon(0.01));
+            CHECK(isPeriodic(channel, start, 100ul));
+        }
+        
+        CHECK(channels[0] == channels[1]);
+    }
+    
+    SECTION("multichannel osc~ spread on the channels of the dac~")
+    {
+        const auto channels = render({{"osc~ 441 882", "dac~"}, {{0, 0, 1, 0}}}, 2ul, nsamples);
+        
+        CHECK(peak(channels[0], start) == Approx(1.f).epsilon(0.01));
+        CHECK(peak(channels[1], start) == Approx(1.f).epsilon(0.01));
+        
+        CHECK(isPeriodic(channels[0], start, 100ul));
+        CHECK(!isPeriodic(channels[0], start, 50ul));
+        CHECK(isPeriodic(channels[1], start, 50ul));
+    }
+    
+    SECTION("multichannel osc~ clipped at the channels of the device")
+    {
+        const auto channels = render({{"osc~ 441 882 1323", "dac~ 2"}, {{0, 0, 1, 0}}}, 2ul, nsamples);
+        
+        CHECK(peak(channels[0], 0ul) == 0.f);
+        CHECK(isPeriodic(channels[1], start, 100ul));
+        CHECK(!isPeriodic(channels[1], start, 50ul));
+    }
+    
+    SECTION("oscbank~ partials set by a loadmess")
+    {
+        const auto channels = render({{"loadmess 441 1 882 0.5", "oscbank~ 2", "dac~"},
+                                      {{0, 0, 1, 0}, {1, 0, 2, 0}}}, 2ul, nsamples);
+        
+        CHECK(peak(channels[0], start) > 1.2f);
+        CHECK(isPeriodic(channels[0], start, 100ul));
+        CHECK(!isPeriodic(channels[0], start, 50ul));
+        CHECK(peak(channels[1], 0ul) == 0.f);
+    }
+    
+    SECTION("2-channel line~ ramps both channels with a value time pair")
+    {
+        const auto channels = render({{"loadmess 1 100", "line~ 0 0", "dac~"},
+                                      {{0, 0, 1, 0}, {1, 0, 2, 0}}}, 2ul, 2ul * nsamples);
+        
+        for(auto const& channel : channels)
+        {
+            CHECK(channel[nsamples / 2ul] == Approx(0.5f).epsilon(0.01));
+            CHECK(channel.back() == 1.f);
+        }
+    }
+    
+    SECTION("2-channel line~ ramps each channel to its destination")
+    {
+        const auto channels = render({{"loadmess channels 0.5 1 100", "line~ 0 0", "dac~"},
+                                      {{0, 0, 1, 0}, {1, 0, 2, 0}}}, 2ul, 2ul * nsamples);
+        
+        CHECK(channels[0][nsamples / 2ul] == Approx(0.25f).epsilon(0.01));
+        CHECK(channels[1][nsamples / 2ul] == Approx(0.5f).epsilon(0.01));
+        CHECK(channels[0].back() == 0.5f);
+        CHECK(channels[1].back() == 1.f);
+    }
+}
@@ -0,0 +1,195 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2017, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+
+#include "../catch.hpp"
+
+#include <KiwiTool/KiwiTool_Random.h>
+
+using namespace kiwi;
+using Random = tool::Random;
+
+// ==================================================================================== //
+//                                       RANDOM                                         //
+// ==================================================================================== //
+
+TEST_CASE("Random", "[Random]")
+{
+    SECTION("A seed gives a same sequence")
+    {
+        Random a(42ull), b(42ull), c(43ull);
+        std::vector<uint32_t> va, vb, vc;
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            va.push_back(a.next());
+            vb.push_back(b.next());
+            vc.push_back(c.next());
+        }
+        
+        CHECK(va == vb);
+        CHECK(va != vc);
+        
+        // the lanes don't give the same numbers.
+        CHECK(std::adjacent_find(va.begin(), va.end()) == va.end());
+        
+        a.seed(42ull);
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            CHECK(a.next() == va[i]);
+        }
+    }
+    
+    SECTION("The global sequence seeds the generators in order")
+    {
+        Random::setSeed(7ull);
+        Random a, b;
+        
+        Random::setSeed(7ull);
+        Random c, d;
+        
+        const uint32_t va = a.next();
+        
+        CHECK(va == c.next());
+        CHECK(b.next() == d.next());
+        CHECK(va != b.next());
+    }
+    
+    SECTION("The bits are converted to [0, 1)")
+    {
+        CHECK(Random::toFloat(0u) == 0.f);
+        CHECK(Random::toDouble(0u) == 0.);
+        CHECK(Random::toFloat(0x80000000u) == 0.5f);
+        CHECK(Random::toDouble(0x80000000u) == 0.5);
+        CHECK(Random::toFloat(0xffffffffu) < 1.f);
+        CHECK(Random::toDouble(0xffffffffu) < 1.);
+    }
+    
+    SECTION("The arrays are filled in the range with the numbers of the generator")
+    {
+        Random a(1ull), b(1ull);
+        std::vector<float> floats(1001);
+        std::vector<double> doubles(1001);
+        
+        // an odd size keeps numbers of the lanes for the next fill.
+        a.fill(floats.data(), floats.size(), -1.f, 1.f);
+        a.fill(doubles.data(), doubles.size(), 2., 4.);
+        
+        for(size_t i = 0; i < floats.size(); ++i)
+        {
+            CHECK(floats[i] == -1.f + 2.f * Random::toFloat(b.next()));
+        }
+        
+        for(size_t i = 0; i < doubles.size(); ++i)
+        {
+            CHECK(doubles[i] == 2. + 2. * Random::toDouble(b.next()));
+        }
+        
+        CHECK(*std::min_element(floats.begin(), floats.end()) >= -1.f);
+        CHECK(*std::max_element(floats.begin(), floats.end()) < 1.f);
+        CHECK(*std::min_element(doubles.begin(), doubles.end()) >= 2.);
+        CHECK(*std::max_element(doubles.begin(), doubles.end()) < 4.);
+    }
+    
+    SECTION("The numbers are uniform")
+    {
+        Random random(3ull);
+        const size_t nbins = 16ul;
+        const size_t size = 160000ul;
+        std::vector<size_t> bins(nbins, 0ul);
+        
+        for(size_t i = 0; i < size; ++i)
+        {
+            ++bins[random.next(nbins)];
+        }
+        
+        // the chi-square of 15 degrees of freedom is below 37.7 with a probability of 0.999.
+        double chi2 = 0.;
+        const double expected = static_cast<double>(size) / nbins;
+        
+        for(size_t bin : bins)
+        {
+            chi2 += (bin - expected) * (bin - expected) / expected;
+        }
+        
+        CHECK(chi2 < 37.7);
+        CHECK(random.next(0u) == 0u);
+        CHECK(random.next(1u) == 0u);
+    }
+}
+
+// ==================================================================================== //
+//                                  RANDOM BENCHMARK                                    //
+// ==================================================================================== //
+
+// Run with : test_tool [benchmark]
+
+TEST_CASE("Random benchmark", "[Random][benchmark][.]")
+{
+    const size_t size = 64ul;
+    const size_t iterations = 100000ul;
+    
+    std::vector<float> output(size);
+    
+    auto measure = [&](std::string const& name, std::function<void()> fill)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            fill();
+        }
+        
+        const auto end = std::chrono::high_resolution_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / (iterations * size);
+        
+        std::cout << std::setw(28) << std::left << name << std::fixed << std::setprecision(2) << ns << " ns/sample\n";
+    };
+    
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    Random random(1ull);
+    
+    std::cout << "Random benchmark (vector size " << size << ")\n";
+    
+    measure("mt19937 uniform_real", [&]()
+    {
+        for(size_t i = 0; i < size; ++i)
+        {
+            output[i] = distribution(generator);
+        }
+    });
+    
+    measure("tool::Random fill", [&]()
+    {
+        random.fill(output.data(), size, -1.f, 1.f);
+    });
+    
+    std::cout << '\n';
+}
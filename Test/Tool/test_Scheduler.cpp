@@ -512,3 +512,44 @@ TEST_CASE("Scheduler - custom clock", "[Scheduler]")
         CHECK(order[2] == 0);
     }
 }
+
+// ==================================================================================== //
+//                              SCHEDULER - LOGICAL TIME                                //
+// ==================================================================================== //
+
+TEST_CASE("Scheduler - logical time", "[Scheduler]")
+{
+    SECTION("Delays are counted from the logical time")
+    {
+        Scheduler scheduler;
+        
+        const Scheduler::time_point_t start(std::chrono::hours(1));
+        
+        scheduler.setLogicalTime(start);
+        
+        CHECK(scheduler.now() == start);
+        
+        std::vector<int> order;
+        
+        scheduler.schedule([&order](){order.push_back(0);}, std::chrono::milliseconds(10));
+        scheduler.schedule([&order](){order.push_back(1);}, std::chrono::milliseconds(5));
+        
+        // the clock doesn't move the logical time.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        scheduler.process();
+        
+        CHECK(order.empty());
+        
+        scheduler.setLogicalTime(start + std::chrono::milliseconds(5));
+        scheduler.process();
+        
+        REQUIRE(order.size() == 1);
+        CHECK(order[0] == 1);
+        
+        scheduler.setLogicalTime(start + std::chrono::milliseconds(10));
+        scheduler.process();
+        
+        REQUIRE(order.size() == 2);
+        CHECK(order[1] == 0);
+    }
+}